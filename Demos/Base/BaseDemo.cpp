@@ -13,6 +13,7 @@
 #include "ECS/Component/RenderingComponent/MaterialComponent.hpp"
 #include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
 #include "ECS/Component/SpatialComponent/RotationComponent.hpp"
+#include "ECS/Component/SpatialComponent/InterpolatedSpatialComponent.hpp"
 #include "ECS/Component/RenderingComponent/ForwardPBRRenderComponent.hpp"
 
 #include "ECS/Systems/CameraSystems/CameraControllerSystem.hpp"
@@ -73,6 +74,7 @@ namespace Base {
 					.attachComponent<TagComponent>("Bunny")
 					.attachComponent<SpatialComponent>(glm::vec3(2.f, 0.0f, -1.f), glm::vec3(1.5f))
 					.attachComponent<RotationComponent>(glm::vec3(0.f, 1.0f, 0.f))
+					.attachComponent<InterpolatedSpatialComponent>()
 					.attachComponent<MeshComponent>(node.mMeshHandle)
 					.attachComponent<BoundingBoxComponent>(node.mMin, node.mMax)
 					.attachComponent<ForwardPBRRenderComponent>()
@@ -88,6 +90,7 @@ namespace Base {
 				.attachComponent<TagComponent>("Icosahedron")
 				.attachComponent<SpatialComponent>(glm::vec3(-2.f, 1.0f, -1.f), glm::vec3(1.5f))
 				.attachComponent<RotationComponent>(glm::vec3(1.f, 0.0f, 0.f))
+				.attachComponent<InterpolatedSpatialComponent>()
 				.attachComponent<MeshComponent>(HashedString("icosahedron"))
 				.attachComponent<BoundingBoxComponent>(glm::vec3(-0.5f), glm::vec3(0.5f))
 				.attachComponent<ForwardPBRRenderComponent>()
@@ -124,7 +127,9 @@ namespace Base {
 		}
 
 		ecs.addSystem<CameraControllerSystem>();
-		ecs.addSystem<RotationSystem>();
+		// Rotation steps at 30hz and gets smoothed out for drawing
+		ecs.setFixedTimestep(1.f / 30.f);
+		ecs.addSystem<RotationSystem>().mFixedUpdate = true;
 	}
 
 	void Demo::imGuiEditor(ECS& ecs, ResourceManagers& resourceManagers) {
@@ -135,25 +140,17 @@ namespace Base {
 		NEO_UNUSED(ecs, resourceManagers);
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 
 		auto viewport = std::get<1>(*ecs.cGetComponent<ViewportDetailsComponent>());
-		TextureHandle sceneColor = resourceManagers.mTextureManager.asyncLoad("Scene Color",
-			TextureBuilder{}
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D,
+		TextureHandle sceneColor = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D,
 				types::texture::InternalFormats::RGB16_UNORM,
-			})
-			.setDimension(glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0))
+			},
+			glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0)
 		);
-		if (resourceManagers.mTextureManager.isValid(sceneColor)) {
-			const Texture& sceneColorTex = resourceManagers.mTextureManager.resolve(sceneColor);
-			if (sceneColorTex.mWidth != viewport.mSize.x || sceneColorTex.mHeight != viewport.mSize.y) {
-				resourceManagers.mTextureManager.discard(sceneColor);
-				return;
-			}
-		}
 
-		auto sceneTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto sceneTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Scene Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{sceneColor},
@@ -168,7 +165,7 @@ namespace Base {
 		drawForwardPBR<AlphaTestComponent>(renderPasses, sceneTargetHandle, viewport.mSize, cameraEntity);
 		drawForwardPBR<TransparentComponent>(renderPasses, sceneTargetHandle, viewport.mSize, cameraEntity);
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"FXAA Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
@@ -11,7 +11,7 @@ namespace Base {
 		virtual IDemo::Config getConfig() const override;
 		virtual void init(ECS& ecs, ResourceManagers& resourceManagers) override;
 		virtual void update(ECS& ecs, ResourceManagers& resourceManagers) override;
-		virtual void render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) override;
+		virtual void render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) override;
 		virtual void destroy() override;
 		virtual void imGuiEditor(ECS& ecs, ResourceManagers& resourceManagers) override;
 
@@ -107,20 +107,16 @@ namespace CSM {
 		
 		{
 			auto csmCameras = createCSMCameras();
-			glm::vec3 lineColors[CSM_CAMERA_COUNT] = {
+			glm::vec3 lineColors[CSM_MAX_CAMERA_COUNT] = {
 				glm::vec3(1.f, 0.f, 0.f),
 				glm::vec3(0.f, 1.f, 0.f),
-				glm::vec3(0.f, 0.f, 1.f)
-			};
-			LineMeshComponent lineMeshes[CSM_CAMERA_COUNT] = {
-				LineMeshComponent(resourceManagers.mMeshManager, lineColors[0]),
-				LineMeshComponent(resourceManagers.mMeshManager, lineColors[1]),
-				LineMeshComponent(resourceManagers.mMeshManager, lineColors[2])
+				glm::vec3(0.f, 0.f, 1.f),
+				glm::vec3(1.f, 1.f, 0.f)
 			};
 
 			for (int i = 0; i < csmCameras.size(); i++) {
 				ecs.submitEntity(std::move(csmCameras[i]
-					.attachComponent<LineMeshComponent>(lineMeshes[i])
+					.attachComponent<LineMeshComponent>(LineMeshComponent(resourceManagers.mMeshManager, lineColors[i]))
 					.attachComponent<TagComponent>("CSMCamera" + std::to_string(i))
 					.attachComponent<MeshComponent>(MeshHandle("sphere"))
 					.attachComponent<WireframeRenderComponent>(lineColors[i])
@@ -180,7 +176,7 @@ namespace CSM {
 		ImGui::Checkbox("Cascade spheres", &mDrawCascadeSpheres);
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		const auto viewport = std::get<1>(*ecs.cGetComponent<ViewportDetailsComponent>());
 		const auto [lightEntity, ___, ____] = *ecs.getSingleView<MainLightComponent, LightComponent>();
 
@@ -188,7 +184,7 @@ namespace CSM {
 			drawCSMShadows(renderPasses, resourceManagers, ecs, lightEntity, true);
 		}
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Output Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
@@ -205,14 +201,10 @@ namespace CSM {
 
 			drawLines<MockCameraComponent>(resourceManagers, ecs, cameraEntity);
 			if (mDrawCascadeLines) {
-				drawLines<CSMCamera0Component>(resourceManagers, ecs, cameraEntity);
-				drawLines<CSMCamera1Component>(resourceManagers, ecs, cameraEntity);
-				drawLines<CSMCamera2Component>(resourceManagers, ecs, cameraEntity);
+				drawLines<CSMCameraComponent>(resourceManagers, ecs, cameraEntity);
 			}
 			if (mDrawCascadeSpheres) {
-				drawWireframe<CSMCamera0Component>(resourceManagers, ecs, cameraEntity);
-				drawWireframe<CSMCamera1Component>(resourceManagers, ecs, cameraEntity);
-				drawWireframe<CSMCamera2Component>(resourceManagers, ecs, cameraEntity);
+				drawWireframe<CSMCameraComponent>(resourceManagers, ecs, cameraEntity);
 			}
 		}, "Draw scene");
 	}
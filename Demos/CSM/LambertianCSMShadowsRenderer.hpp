@@ -112,9 +112,7 @@ namespace CSM {
 				// These could be an array tbh
 				resolvedShader.bindUniform("mockPV", mockPV);
 				resolvedShader.bindUniform("mockNear", mockNear);
-				resolvedShader.bindUniform("L0", csmShadowInfo.mLightArrays[0]);
-				resolvedShader.bindUniform("L1", csmShadowInfo.mLightArrays[1]);
-				resolvedShader.bindUniform("L2", csmShadowInfo.mLightArrays[2]);
+				csmShadowInfo.bindUniforms(resolvedShader);
 				const auto shadowTexture = resourceManagers.mTextureManager.resolve(ecs.cGetComponent<CSMShadowMapComponent>(lightEntity)->mShadowMap);
 				resolvedShader.bindTexture("shadowMap", shadowTexture);
 				resolvedShader.bindUniform("shadowMapResolution", static_cast<float>(shadowTexture.mWidth));
@@ -124,7 +122,9 @@ namespace CSM {
 			resolvedShader.bindUniform("M", drawSpatial.getModelMatrix());
 			resolvedShader.bindUniform("N", drawSpatial.getNormalMatrix());
 
-			resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+			if (resourceManagers.mMeshManager.isValid(view.get<const MeshComponent>(entity).mMeshHandle)) {
+				resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+			}
 		}
 	}
 }
\ No newline at end of file
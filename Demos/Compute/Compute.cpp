@@ -104,7 +104,7 @@ namespace Compute {
 		}
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		TRACY_GPUN("Compute::render");
 
 		// Update the mesh
@@ -147,7 +147,7 @@ namespace Compute {
 		});
 
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Output Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
@@ -10,7 +10,7 @@ namespace Compute {
 		virtual IDemo::Config getConfig() const override;
 		virtual void init(ECS& ecs, ResourceManagers& resourceManagers) override;
 		virtual void update(ECS& ecs, ResourceManagers& resourceManagers) override;
-		virtual void render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) override;
+		virtual void render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) override;
 		virtual void imGuiEditor(ECS& ecs, ResourceManagers& resourceManagers) override;
 	private:
 		float mSpriteSize = 0.2f;
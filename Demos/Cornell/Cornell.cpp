@@ -15,6 +15,7 @@
 #include "ECS/Component/RenderingComponent/ForwardPBRRenderComponent.hpp"
 
 #include "ECS/Systems/CameraSystems/CameraControllerSystem.hpp"
+#include "ECS/Systems/RenderingSystems/ShadowCacheSystem.hpp"
 
 #include "Renderer/RenderingSystems/ForwardPBRRenderer.hpp"
 #include "Renderer/RenderingSystems/PointLightShadowMapRenderer.hpp"
@@ -68,7 +69,7 @@ namespace Cornell {
 		}
 
 		{
-			PointLightShadowMapComponent shadowMap(512, resourceManagers.mTextureManager);
+			PointLightShadowMapComponent shadowMap(512, resourceManagers.mTextureManager, "Light");
 			ecs.submitEntity(std::move(ECS::EntityBuilder{}
 				.attachComponent<TagComponent>("Light")
 				.attachComponent<SpatialComponent>(glm::vec3(0.f, 1.f - util::EP * 3, 0.5f), glm::vec3(10.f))
@@ -76,6 +77,7 @@ namespace Cornell {
 				.attachComponent<LightComponent>(glm::vec3(1.f))
 				.attachComponent<PointLightComponent>()
 				.attachComponent<PointLightShadowMapComponent>(shadowMap)
+				.attachComponent<ShadowCacheComponent>(shadowMap, resourceManagers.mTextureManager)
 				.attachComponent<BoundingBoxComponent>(glm::vec3(-0.5f), glm::vec3(0.5f), false)
 			));
 		}
@@ -91,9 +93,10 @@ namespace Cornell {
 
 		/* Systems - order matters! */
 		ecs.addSystem<CameraControllerSystem>();
+		ecs.addSystem<ShadowCacheSystem>();
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		{
 			PointLightShadowMapParameters params = {
 				0.01f
@@ -105,22 +108,14 @@ namespace Cornell {
 		}
 
 		auto viewport = std::get<1>(*ecs.cGetComponent<ViewportDetailsComponent>());
-		TextureHandle sceneColor = resourceManagers.mTextureManager.asyncLoad("Scene Color",
-			TextureBuilder{}
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D,
+		TextureHandle sceneColor = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D,
 				types::texture::InternalFormats::RGB16_UNORM,
-			})
-			.setDimension(glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0))
+			},
+			glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0)
 		);
-		if (resourceManagers.mTextureManager.isValid(sceneColor)) {
-			const Texture& sceneColorTex = resourceManagers.mTextureManager.resolve(sceneColor);
-			if (sceneColorTex.mWidth != viewport.mSize.x || sceneColorTex.mHeight != viewport.mSize.y) {
-				resourceManagers.mTextureManager.discard(sceneColor);
-				return;
-			}
-		}
 
-		auto sceneTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto sceneTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Scene Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{sceneColor},
@@ -133,7 +128,7 @@ namespace Cornell {
 		const auto [cameraEntity, _, cameraSpatial] = *ecs.getSingleView<MainCameraComponent, SpatialComponent>();
 		drawForwardPBR<OpaqueComponent>(renderPasses, sceneTargetHandle, viewport.mSize, cameraEntity);
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"FXAA Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
@@ -12,12 +12,16 @@
 #include "ECS/Component/HardwareComponent/ViewportDetailsComponent.hpp"
 #include "ECS/Component/RenderingComponent/ShadowCasterRenderComponent.hpp"
 #include "ECS/Component/RenderingComponent/IBLComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
 #include "ECS/Component/RenderingComponent/SkyboxComponent.hpp"
 #include "ECS/Component/SpatialComponent/SinTranslateComponent.hpp"
 #include "ECS/Component/SpatialComponent/RotationComponent.hpp"
 
 #include "ECS/Systems/CameraSystems/CameraControllerSystem.hpp"
 #include "ECS/Systems/CameraSystems/CSMFittingSystem.hpp"
+#include "ECS/Systems/RenderingSystems/MeshLODSystem.hpp"
+#include "ECS/Systems/RenderingSystems/TextureStreamingSystem.hpp"
+#include "ECS/Systems/RenderingSystems/ShadowCacheSystem.hpp"
 #include "ECS/Systems/TranslationSystems/RotationSystem.hpp"
 #include "ECS/Systems/TranslationSystems/SinTranslateSystem.hpp"
 
@@ -55,8 +59,10 @@ namespace DeferredPBR {
 					util::genRandom(0.f, 10.f),
 					util::genRandom(-7.5f, 7.5f)
 				);
-				PointLightShadowMapComponent shadowMap(256, resourceManagers.mTextureManager);
+				const std::string name = "PointLight_" + std::to_string(i);
+				PointLightShadowMapComponent shadowMap(256, resourceManagers.mTextureManager, name);
 				ecs.submitEntity(std::move(ECS::EntityBuilder{}
+					.attachComponent<TagComponent>(name)
 					.attachComponent<LightComponent>(util::genRandomVec3(0.3f, 1.f), util::genRandom(300.f, 1000.f))
 					.attachComponent<PointLightComponent>()
 					.attachComponent<SinTranslateComponent>(glm::vec3(0.f, util::genRandom(0.f, 5.f), 0.f), position)
@@ -102,6 +108,7 @@ namespace DeferredPBR {
 				.attachComponent<PinnedComponent>()
 				.attachComponent<CameraComponent>(-1.f, 1000.f, CameraComponent::Orthographic{ glm::vec2(-100.f, 100.f), glm::vec2(-100.f, 100.f) })
 				.attachComponent<CSMShadowMapComponent>(csmShadowMap)
+				.attachComponent<ShadowCacheComponent>(csmShadowMap, resourceManagers.mTextureManager)
 				.attachComponent<FrustumComponent>()
 				.attachComponent<FrustumFitReceiverComponent>(15.f)
 			));
@@ -257,6 +264,9 @@ namespace DeferredPBR {
 					.attachComponent<DeferredPBRRenderComponent>()
 				));
 			});
+		// Big scenes get LODs
+		GLTFImporter::ImportOptions lodOptions;
+		lodOptions.mLODCount = 3;
 		Loader::loadGltfScene(ecs, resourceManagers, "Sponza/Sponza.gltf", glm::scale(glm::mat4(1.f), glm::vec3(200.f)),
 			[](ECS& ecs, const GLTFImporter::MeshNode& node) {
 				ECS::EntityBuilder builder;
@@ -265,6 +275,9 @@ namespace DeferredPBR {
 				}
 				builder.attachComponent<SpatialComponent>(node.mSpatial);
 				builder.attachComponent<MeshComponent>(node.mMeshHandle);
+				if (!node.mLODs.empty()) {
+					builder.attachComponent<MeshLODComponent>(node.mLODs, glm::length(node.mMax - node.mMin) * 0.5f);
+				}
 				builder.attachComponent<BoundingBoxComponent>(node.mMin, node.mMax, true);
 				if (node.mAlphaMode == GLTFImporter::MeshNode::AlphaMode::Transparent) {
 					builder.attachComponent<TransparentComponent>();
@@ -281,7 +294,10 @@ namespace DeferredPBR {
 				builder.attachComponent<MaterialComponent>(node.mMaterial);
 				builder.attachComponent<ShadowCasterRenderComponent>();
 				ecs.submitEntity(std::move(builder));
-			});
+			},
+			[](ECS&, const GLTFImporter::CameraNode&) {},
+			lodOptions
+		);
 		Loader::loadGltfScene(ecs, resourceManagers, "porsche/scene.gltf", glm::rotate(glm::translate(glm::mat4(1.f), glm::vec3(-6.75f, 0., -0.25f)), util::PI / 2.f, glm::vec3(0, 1, 0)),
 			[](ECS& ecs, const GLTFImporter::MeshNode& node) {
 				ECS::EntityBuilder builder;
@@ -290,6 +306,9 @@ namespace DeferredPBR {
 				}
 				builder.attachComponent<SpatialComponent>(node.mSpatial);
 				builder.attachComponent<MeshComponent>(node.mMeshHandle);
+				if (!node.mLODs.empty()) {
+					builder.attachComponent<MeshLODComponent>(node.mLODs, glm::length(node.mMax - node.mMin) * 0.5f);
+				}
 				builder.attachComponent<BoundingBoxComponent>(node.mMin, node.mMax, true);
 				if (node.mAlphaMode == GLTFImporter::MeshNode::AlphaMode::Transparent) {
 					builder.attachComponent<TransparentComponent>();
@@ -306,15 +325,21 @@ namespace DeferredPBR {
 				builder.attachComponent<MaterialComponent>(node.mMaterial);
 				builder.attachComponent<ShadowCasterRenderComponent>();
 				ecs.submitEntity(std::move(builder));
-			});
+			},
+			[](ECS&, const GLTFImporter::CameraNode&) {},
+			lodOptions
+		);
 
 		/* Systems - order matters! */
 		ecs.addSystem<CameraControllerSystem>();
+		ecs.addSystem<MeshLODSystem>();
 		ecs.addSystem<RotationSystem>();
 		ecs.addSystem<SinTranslateSystem>();
 		ecs.addSystem<FrustumSystem>();
 		ecs.addSystem<CSMFittingSystem>();
+		ecs.addSystem<ShadowCacheSystem>();
 		ecs.addSystem<FrustumCullingSystem>();
+		ecs.addSystem<TextureStreamingSystem>();
 	}
 
 	void Demo::imGuiEditor(ECS& ecs, ResourceManagers& resourceManagers) {
@@ -338,12 +363,13 @@ namespace DeferredPBR {
 			}
 		}
 		if (ImGui::Checkbox("Point Light Shadows", &mDrawPointLightShadows)) {
-			for (auto& entity : ecs.getView<PointLightComponent, SpatialComponent>()) {
+			for (auto& entity : ecs.getView<TagComponent, PointLightComponent, SpatialComponent>()) {
 				if (mDrawPointLightShadows) {
-					PointLightShadowMapComponent shadowMap(256, resourceManagers.mTextureManager);
+					PointLightShadowMapComponent shadowMap(256, resourceManagers.mTextureManager, ecs.getComponent<TagComponent>(entity)->mTag);
 					ecs.addComponent<PointLightShadowMapComponent>(entity, shadowMap);
 				}
-				else {
+				else if (ecs.has<PointLightShadowMapComponent>(entity)) {
+					resourceManagers.mTextureManager.discard(ecs.getComponent<PointLightShadowMapComponent>(entity)->mShadowMap);
 					ecs.removeComponent<PointLightShadowMapComponent>(entity);
 				}
 			}
@@ -364,7 +390,7 @@ namespace DeferredPBR {
 		}
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		convolveCubemap(renderPasses, resourceManagers, ecs);
 
 		const auto& cameraTuple = ecs.getSingleView<MainCameraComponent, CameraComponent, SpatialComponent>();
@@ -407,7 +433,7 @@ namespace DeferredPBR {
 		}, "GBuffer");
 
 		if (mGbufferDebugParams.mDebugMode != GBufferDebugParameters::DebugMode::Off) {
-			auto outputHandle = resourceManagers.mFramebufferManager.asyncLoad("GBuffer Debug",
+			auto outputHandle = resourceManagers.mFramebufferManager.acquireTransient("GBuffer Debug",
 				FramebufferExternalAttachments{
 					FramebufferAttachment{outputColor},
 				},
@@ -422,10 +448,9 @@ namespace DeferredPBR {
 			return;
 		}
 
-		TextureHandle hdrColorTexture = resourceManagers.mTextureManager.asyncLoad("HDR Color",
-			TextureBuilder{}
-			.setDimension(glm::u16vec3(viewport.mSize, 0))
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F })
+		TextureHandle hdrColorTexture = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F },
+			glm::u16vec3(viewport.mSize, 0)
 		);
 
 		if (!resourceManagers.mFramebufferManager.isValid(gbufferHandle)) {
@@ -441,7 +466,7 @@ namespace DeferredPBR {
 			viewport.mSize
 		);
 
-		FramebufferHandle hdrColorTarget = resourceManagers.mFramebufferManager.asyncLoad("HDR Target",
+		FramebufferHandle hdrColorTarget = resourceManagers.mFramebufferManager.acquireTransient("HDR Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{hdrColorTexture},
 				FramebufferAttachment{resourceManagers.mFramebufferManager.resolve(gbufferHandle).mTextures[3]}, // Oof
@@ -499,7 +524,7 @@ namespace DeferredPBR {
 		}
 
 		{
-			auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+			auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 				"FXAA Target",
 				FramebufferExternalAttachments{
 					FramebufferAttachment{outputColor},
@@ -58,9 +58,7 @@ namespace DeferredPBR {
 					const auto& shadowMap = resourceManagers.mTextureManager.resolve(ecs.cGetComponent<CSMShadowMapComponent>(entity)->mShadowMap);
 					resolvedShader.bindTexture("shadowMap", shadowMap);
 					resolvedShader.bindUniform("shadowMapResolution", glm::vec2(shadowMap.mWidth, shadowMap.mHeight));
-					resolvedShader.bindUniform("L0", csmShadowInfo.mLightArrays[0]);
-					resolvedShader.bindUniform("L1", csmShadowInfo.mLightArrays[1]);
-					resolvedShader.bindUniform("L2", csmShadowInfo.mLightArrays[2]);
+					csmShadowInfo.bindUniforms(resolvedShader);
 				}
 
 				const auto& camera = ecs.cGetComponent<CameraComponent>(cameraEntity);
@@ -25,21 +25,22 @@
 
 namespace DeferredPBR {
 
-	inline FramebufferHandle createGbuffer(const ResourceManagers& resourceManagers, glm::uvec2 dimension) {
-		return resourceManagers.mFramebufferManager.asyncLoad("Gbuffer",
-			FramebufferBuilder{}
-			.setSize(dimension)
-			// AlbedoAO
-			.attach(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F })
-			// NormalRoughness
-			.attach(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F })
-			// Emissive Metalness
-			.attach(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F })
-			// Depth
-			.attach(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::D16 }),
+	inline FramebufferHandle createGbuffer(ResourceManagers& resourceManagers, glm::uvec2 dimension) {
+		const glm::u16vec3 size(dimension, 0);
+		const TextureFormat colorFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F };
+		return resourceManagers.mFramebufferManager.acquireTransient("Gbuffer",
+			FramebufferExternalAttachments{
+				// AlbedoAO
+				FramebufferAttachment{ resourceManagers.mTextureManager.acquireTransient(colorFormat, size) },
+				// NormalRoughness
+				FramebufferAttachment{ resourceManagers.mTextureManager.acquireTransient(colorFormat, size) },
+				// Emissive Metalness
+				FramebufferAttachment{ resourceManagers.mTextureManager.acquireTransient(colorFormat, size) },
+				// Depth
+				FramebufferAttachment{ resourceManagers.mTextureManager.acquireTransient(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::D16 }, size) },
+			},
 			resourceManagers.mTextureManager
 		);
-
 	}
 
 	template<typename... CompTs>
@@ -75,6 +76,11 @@ namespace DeferredPBR {
 				}
 			}
 
+			// Still uploading
+			if (!resourceManagers.mMeshManager.isValid(view.get<const MeshComponent>(entity).mMeshHandle)) {
+				continue;
+			}
+
 			drawDefines.reset();
 			const auto& material = view.get<const MaterialComponent>(entity);
 			MakeDefine(ALBEDO_MAP);
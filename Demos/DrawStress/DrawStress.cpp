@@ -36,6 +36,7 @@ namespace DrawStress {
 	IDemo::Config Demo::getConfig() const {
 		IDemo::Config config;
 		config.name = "DrawStress";
+		config.pipelined = true;
 		return config;
 	}
 
@@ -84,10 +85,10 @@ namespace DrawStress {
 		ecs.addSystem<FrustumCullingSystem>();
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		const auto [cameraEntity, _, cameraSpatial] = *ecs.getSingleView<MainCameraComponent, SpatialComponent>();
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Output Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
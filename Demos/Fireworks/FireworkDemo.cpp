@@ -56,7 +56,7 @@ namespace Fireworks {
 		}
 
 		{
-			PointLightShadowMapComponent shadowMap(512, resourceManagers.mTextureManager);
+			PointLightShadowMapComponent shadowMap(512, resourceManagers.mTextureManager, "Light");
 			FireworkComponent firework(resourceManagers.mMeshManager, 16384);
 			ecs.submitEntity(std::move(ECS::EntityBuilder{}
 				.attachComponent<TagComponent>("Light")
@@ -132,7 +132,7 @@ namespace Fireworks {
 		NEO_UNUSED(ecs, resourceManagers);
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 		renderPasses.computePass([](const ResourceManagers& resourceManagers, const ECS& ecs) {
 			tickParticles(resourceManagers, ecs);
 		});
@@ -145,13 +145,12 @@ namespace Fireworks {
 		 const auto [cameraEntity, _, cameraSpatial] = *ecs.getSingleView<MainCameraComponent, SpatialComponent>();
 		 auto viewport = std::get<1>(*ecs.cGetComponent<ViewportDetailsComponent>());
 
-		TextureHandle hdrColorTexture = resourceManagers.mTextureManager.asyncLoad("HDR Color",
-			TextureBuilder{}
-			.setDimension(glm::u16vec3(viewport.mSize, 0))
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F })
+		TextureHandle hdrColorTexture = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGBA16_F },
+			glm::u16vec3(viewport.mSize, 0)
 		);
 
-		auto sceneTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto sceneTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Scene Target",
 		    FramebufferExternalAttachments{
 				FramebufferAttachment{hdrColorTexture},
@@ -188,7 +187,7 @@ namespace Fireworks {
 		TextureHandle tonemappedHandle = tonemap(renderPasses, resourceManagers, viewport.mSize, bloomResults, averageLuminance);
 
 		{
-			auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+			auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 				"FXAA Target",
 				FramebufferExternalAttachments{
 					FramebufferAttachment{outputColor},
@@ -84,9 +84,9 @@ namespace NormalVisualizer {
 		ecs.addSystem<RotationSystem>();
 	}
 
-	void Demo::render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
+	void Demo::render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) {
 
-		auto outputTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		auto outputTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Output Target",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{outputColor},
@@ -126,7 +126,9 @@ namespace NormalVisualizer {
 				resolvedShader.bindUniform("N", spatial.getNormalMatrix());
 
 				/* DRAW */
-				resourceManagers.mMeshManager.resolve(mesh.mMeshHandle).draw();
+				if (resourceManagers.mMeshManager.isValid(mesh.mMeshHandle)) {
+					resourceManagers.mMeshManager.resolve(mesh.mMeshHandle).draw();
+				}
 			}
 		});
 	}
@@ -9,7 +9,8 @@ in vec2 fragTex;
 
 uniform vec4 albedo;
 
-in vec4 shadowCoord[3];
+in vec4 shadowCoord[CSM_MAX_CASCADES];
+uniform int csmCascadeCount;
 layout(binding = 2) uniform sampler2D shadowMap;
 uniform float shadowMapResolution;
 
@@ -32,20 +33,24 @@ void main() {
 	color.rgb = lambertianDiffuse(Ldir, N, fAlbedo.rgb, lightCol, attFactor);
 	color.a = 1.0;
 
-	float visibility = getCSMShadowVisibility(1, shadowCoord, shadowMap, shadowMapResolution, 0.0001);
+	float visibility = getCSMShadowVisibility(1, shadowCoord, csmCascadeCount, shadowMap, shadowMapResolution, 0.0001);
 	color *= vec4(vec3(max(visibility, 0.2)), 1.0);
 
 #if defined(DEBUG_VIEW)
 	const float scale = 0.2;
-	if (validCascade(shadowCoord[0])) {
+	int cascade = getCSMCascade(shadowCoord, csmCascadeCount);
+	if (cascade == 0) {
 		color.yz *= scale;
 	}
-	else if (validCascade(shadowCoord[1])) {
+	else if (cascade == 1) {
 		color.xz *= scale;
 	}
-	else if (validCascade(shadowCoord[2])) {
+	else if (cascade == 2) {
 		color.xy *= scale;
 	}
+	else if (cascade == 3) {
+		color.z *= scale;
+	}
 
 #endif
 
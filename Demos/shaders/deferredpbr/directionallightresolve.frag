@@ -12,6 +12,8 @@ layout(binding = 3) uniform sampler2D gDepth;
 uniform mat4 L0;
 uniform mat4 L1;
 uniform mat4 L2;
+uniform mat4 L3;
+uniform int csmCascadeCount;
 layout(binding = 5) uniform sampler2D shadowMap;
 uniform vec2 shadowMapResolution;
 #endif
@@ -56,11 +58,12 @@ void main() {
 
 
 #ifdef ENABLE_SHADOWS
-	vec4 shadowCoord[3];
+	vec4 shadowCoord[CSM_MAX_CASCADES];
 	shadowCoord[0] = L0 * vec4(worldPos, 1.0);
 	shadowCoord[1] = L1 * vec4(worldPos, 1.0);
 	shadowCoord[2] = L2 * vec4(worldPos, 1.0);
-	float visibility = getCSMShadowVisibility(1, shadowCoord, shadowMap, shadowMapResolution.x, 0.001);
+	shadowCoord[3] = L3 * vec4(worldPos, 1.0);
+	float visibility = getCSMShadowVisibility(1, shadowCoord, csmCascadeCount, shadowMap, shadowMapResolution.x, 0.001);
 	pbrColor.directDiffuse *= visibility;
 	pbrColor.directSpecular *= visibility;
 #endif
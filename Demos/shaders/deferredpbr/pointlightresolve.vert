@@ -1,3 +1,5 @@
+#include "quantization.glsl"
+
 layout(location = 0) in vec3 vertPos;
 
 uniform mat4 P;
@@ -7,7 +9,7 @@ uniform mat4 M;
 out vec4 fragPos;
 
 void main() {
-	fragPos = M * vec4(vertPos, 1.0);
+	fragPos = M * vec4(dequantizePosition(vertPos), 1.0);
 	gl_Position = P * V * fragPos;
 
 	// Lights can be so big they go past the far plane and cause fragments to get culled even though the provide light
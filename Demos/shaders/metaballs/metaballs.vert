@@ -1,3 +1,5 @@
+#include "quantization.glsl"
+
 layout(location = 0) in vec3 vertPos;
 layout(location = 1) in vec3 vertNor;
 
@@ -8,7 +10,7 @@ out vec3 fragPos;
 out vec3 fragNor;
 
 void main() {
-	  vec4 worldPos = M * vec4(vertPos.xyz, 1.0);
+	  vec4 worldPos = M * vec4(dequantizePosition(vertPos), 1.0);
 	  gl_Position = P * V * worldPos;
 	  fragPos = worldPos.xyz;
 	  fragNor = N * vertNor;
@@ -1,3 +1,4 @@
+#include "quantization.glsl"
 
 layout(location = 0) in vec3 vertPos;
 layout(location = 1) in vec3 vertNor;
@@ -11,7 +12,7 @@ out vec3 geomNor;
 out vec3 fragNor;
 
 void main() {
-	gl_Position = P * V * M * vec4(vertPos, 1.0);
+	gl_Position = P * V * M * vec4(dequantizePosition(vertPos), 1.0);
 	geomNor = vec3(P * V * vec4(N * vertNor, 0));
 	fragNor = vec3(vec4(vertNor, 0));
 }
\ No newline at end of file
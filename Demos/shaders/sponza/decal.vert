@@ -1,8 +1,10 @@
 
+#include "quantization.glsl"
+
 layout(location = 0) in vec3 vertPos;
 
 uniform mat4 P, V, M;
 
 void main() {
-	gl_Position = P * V * M * vec4(vertPos, 1.f);
+	gl_Position = P * V * M * vec4(dequantizePosition(vertPos), 1.f);
 }
\ No newline at end of file
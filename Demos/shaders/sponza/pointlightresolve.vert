@@ -1,4 +1,6 @@
 
+#include "quantization.glsl"
+
 layout(location = 0) in vec3 vertPos;
 
 uniform mat4 P;
@@ -6,5 +8,5 @@ uniform mat4 V;
 uniform mat4 M;
 
 void main() {
-	gl_Position = P * V * M * vec4(vertPos, 1.f);
+	gl_Position = P * V * M * vec4(dequantizePosition(vertPos), 1.f);
 }
\ No newline at end of file
@@ -19,6 +19,8 @@ namespace neo {
 			std::string name = "";
 			std::string resDir = "res/";
 			std::string shaderDir = "shaders/";
+			// Simulate the next frame while this one renders. Only safe if update() doesn't touch GL
+			bool pipelined = false;
 		};
 
 		/* Construction flow goes through init/destroy */
@@ -32,7 +34,7 @@ namespace neo {
 		virtual void update(ECS& ecs, ResourceManagers& resourceManagers) {
 			NEO_UNUSED(ecs, resourceManagers);
 		};
-		virtual void render(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) = 0;
+		virtual void render(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const ECS& ecs, const TextureHandle& outputColor, const TextureHandle& outputDepth) = 0;
 		virtual void imGuiEditor(ECS& ecs, ResourceManagers& resourceManagers) {
 			NEO_UNUSED(ecs, resourceManagers);
 		}
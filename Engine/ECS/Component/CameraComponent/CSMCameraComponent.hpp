@@ -3,39 +3,21 @@
 #include "ECS/Component/Component.hpp"
 
 namespace neo {
-#define CSM_CAMERA_COUNT 3
+// Shaders are written against the max -- the actual cascade count lives on CSMShadowMapComponent
+#define CSM_MAX_CAMERA_COUNT 4
+#define CSM_DEFAULT_CAMERA_COUNT 3
 
 	START_COMPONENT(CSMCameraComponent);
-	CSMCameraComponent() {}
-	
-	virtual int getLod() const = 0;
-	virtual void imGuiEditor() override {};
+	CSMCameraComponent(uint8_t lod)
+		: mLod(lod)
+	{}
 
-	END_COMPONENT();
-
-	// Really shouldn't be using inheritance like this
-	struct CSMCamera0Component : public CSMCameraComponent {
-		CSMCamera0Component()
-			: CSMCameraComponent()
-		{}
-		const char* mName = "CSMCamera0Component";
-
-		virtual int getLod() const override { return 0; }
-	};
-	struct CSMCamera1Component : public CSMCameraComponent {
-		CSMCamera1Component()
-			: CSMCameraComponent()
-		{}
-		const char* mName = "CSMCamera1Component";
+	uint8_t mLod = 0;
 
-		virtual int getLod() const override { return 1; }
+	int getLod() const { return static_cast<int>(mLod); }
+	virtual void imGuiEditor() override {
+		ImGui::Text("LOD: %d", getLod());
 	};
-	struct CSMCamera2Component : public CSMCameraComponent {
-		CSMCamera2Component()
-			: CSMCameraComponent()
-		{}
-		const char* mName = "CSMCamera2Component";
 
-		virtual int getLod() const override { return 2; }
-	};
-}
\ No newline at end of file
+	END_COMPONENT();
+}
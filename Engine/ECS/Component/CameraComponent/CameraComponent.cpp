@@ -90,6 +90,13 @@ namespace neo {
 		return mFar;
 	}
 
+	float CameraComponent::getPixelsPerUnit(float distance, float viewportHeight) const {
+		if (mType == CameraType::Perspective) {
+			return viewportHeight / (2.f * std::max(distance, mNear) * std::tan(glm::radians(mPerspective->mFOV) * 0.5f));
+		}
+		return viewportHeight / std::max(mOrthographic->mVertBounds.y - mOrthographic->mVertBounds.x, util::EP);
+	}
+
 	const CameraComponent::Perspective& CameraComponent::getPerspective() const {
 		NEO_ASSERT(mPerspective.has_value(), "This isn't a perspective camera..");
 
@@ -47,6 +47,8 @@ namespace neo {
 		const Perspective& getPerspective() const;
 		const Orthographic& getOrthographic() const;
 		const glm::mat4& getProj() const;
+		// How many pixels tall a unit-sized object is at this distance
+		float getPixelsPerUnit(float distance, float viewportHeight) const;
 		virtual void imGuiEditor() override;
 
 	private:
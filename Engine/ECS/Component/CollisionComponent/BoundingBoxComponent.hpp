@@ -43,6 +43,25 @@ namespace neo {
 			return mMin + ((mMax - mMin) / 2.f);
 		}
 
+		// Axis-aligned box around the transformed corners
+		BoundingBoxComponent getWorldBounds(const glm::mat4& modelMatrix) const {
+			BoundingBoxComponent worldBox(mStatic);
+			for (int i = 0; i < 8; i++) {
+				worldBox.addPoint(glm::vec3(modelMatrix * glm::vec4(
+					(i & 1) ? mMax.x : mMin.x,
+					(i & 2) ? mMax.y : mMin.y,
+					(i & 4) ? mMax.z : mMin.z,
+					1.f
+				)));
+			}
+			return worldBox;
+		}
+
+		// To the closest point on the box, 0 if it's inside
+		float getDistance(const glm::vec3& point) const {
+			return glm::distance(glm::clamp(point, mMin, mMax), point);
+		}
+
 		bool intersect(const glm::mat4& modelMatrix, const glm::vec3& position) const {
 			return glm::length(glm::vec3(glm::inverse(modelMatrix) * glm::vec4(position, 1.f))) < getRadius();
 		}
@@ -7,18 +7,21 @@
 namespace neo {
 
 	START_COMPONENT(FrameStatsComponent);
-		FrameStatsComponent(float rt, float dt)
+		FrameStatsComponent(float rt, float dt, float latency = 0.f)
 			: mRunTime(rt)
 			, mDT(dt)
+			, mLatency(latency)
 		{}
 
 		virtual void imGuiEditor() override {
 			ImGui::TextWrapped("Run Time:   %0.3f", mRunTime);
 			ImGui::TextWrapped("Frame Time: %0.3f", mDT);
+			ImGui::TextWrapped("Latency:    %0.3f", mLatency);
 
 		}
 
 		float mRunTime;
-		float mDT;
+		float mDT; // Fixed step systems see the fixed timestep here instead
+		float mLatency; // Input to present of the last completed frame
 	END_COMPONENT();
 }
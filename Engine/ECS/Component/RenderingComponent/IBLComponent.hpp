@@ -17,6 +17,18 @@ namespace neo {
 		mutable bool mDFGGenerated = false;
 		uint16_t mDFGLutResolution = 128;
 
+		// Pipelined renderers fill these in on a snapshot
+		void writeBack(const IBLComponent& rendered) {
+			if (mConvolvedSkybox == NEO_INVALID_HANDLE) {
+				mConvolvedSkybox = rendered.mConvolvedSkybox;
+			}
+			if (mDFGLut == NEO_INVALID_HANDLE) {
+				mDFGLut = rendered.mDFGLut;
+			}
+			mConvolved |= rendered.mConvolved;
+			mDFGGenerated |= rendered.mDFGGenerated;
+		}
+
 		virtual void imGuiEditor() override {
 			if (ImGui::Button("Regenerate DFG Lut")) {
 				mDFGGenerated = false;
@@ -6,7 +6,8 @@
 namespace neo {
 
 	LineMeshComponent::LineMeshComponent(const MeshManager& meshManager, std::optional<glm::vec3> overrideColor) :
-		mDirty(false),
+		mVersion(0),
+		mUploadedVersion(0),
 		mUseParentSpatial(false),
 		mOverrideColor(overrideColor)
 	{
@@ -48,56 +49,61 @@ namespace neo {
 			return meshManager.resolve(NEO_INVALID_HANDLE);
 		}
 
-		if (mDirty && mNodes.size()) {
+		if (mUploadedVersion != mVersion && mNodes.size()) {
 			TRACY_ZONE();
-			std::vector<float> positions;
-			std::vector<float> colors;
-			positions.resize(mNodes.size() * 3);
-			colors.resize(mNodes.size() * 3);
+			// Streamed on the next tick, after the frame arena's been rewound -- so a heap copy, but only the one.
+			// Positions first, then colors
+			const uint32_t count = static_cast<uint32_t>(mNodes.size() * 3);
+			std::vector<float> attributes(count * 2);
 			for (uint32_t i = 0; i < mNodes.size(); i++) {
-				positions[i * 3 + 0] = mNodes[i].position.x;
-				positions[i * 3 + 1] = mNodes[i].position.y;
-				positions[i * 3 + 2] = mNodes[i].position.z;
-				colors[i * 3 + 0] = mNodes[i].color.r;
-				colors[i * 3 + 1] = mNodes[i].color.g;
-				colors[i * 3 + 2] = mNodes[i].color.b;
+				attributes[i * 3 + 0] = mNodes[i].position.x;
+				attributes[i * 3 + 1] = mNodes[i].position.y;
+				attributes[i * 3 + 2] = mNodes[i].position.z;
+				attributes[count + i * 3 + 0] = mNodes[i].color.r;
+				attributes[count + i * 3 + 1] = mNodes[i].color.g;
+				attributes[count + i * 3 + 2] = mNodes[i].color.b;
 			}
 
-			meshManager.transact(mMeshHandle, [positions, colors](Mesh& mesh) {
-				mesh.updateVertexBuffer(
+			meshManager.transact(mMeshHandle, [attributes = std::move(attributes), count](Mesh& mesh) {
+				mesh.streamVertexBuffer(
 					types::mesh::VertexType::Position,
-					static_cast<uint32_t>(positions.size()),
-					static_cast<uint32_t>(positions.size() * sizeof(float)),
-					reinterpret_cast<uint8_t*>(const_cast<float*>(positions.data()))
+					count,
+					static_cast<uint32_t>(count * sizeof(float)),
+					reinterpret_cast<const uint8_t*>(attributes.data())
 				);
-				mesh.updateVertexBuffer(
+				mesh.streamVertexBuffer(
 					types::mesh::VertexType::Normal,
-					static_cast<uint32_t>(colors.size()),
-					static_cast<uint32_t>(colors.size() * sizeof(float)),
-					reinterpret_cast<uint8_t*>(const_cast<float*>(colors.data()))
+					count,
+					static_cast<uint32_t>(count * sizeof(float)),
+					reinterpret_cast<const uint8_t*>(attributes.data() + count)
 				);
 			});
 
-			mDirty = false;
+			mUploadedVersion = mVersion;
 		}
 		return meshManager.resolve(mMeshHandle);
 	}
 
+	void LineMeshComponent::writeBack(const LineMeshComponent& rendered) {
+		// Anything edited since the snapshot has a newer version and still gets uploaded
+		mUploadedVersion = std::max(mUploadedVersion, rendered.mUploadedVersion);
+	}
+
 	void LineMeshComponent::addNode(const glm::vec3 pos, glm::vec3 col) {
 		mNodes.push_back(Node{ pos, mOverrideColor.value_or(col) });
-		mDirty = true;
+		mVersion++;
 	}
 
 	void LineMeshComponent::addNodes(const std::vector<Node>& oNodes) {
 		mNodes.insert(mNodes.end(), oNodes.begin(), oNodes.end());
-		mDirty = true;
+		mVersion++;
 	}
 
 	void LineMeshComponent::editNode(const uint32_t i, const glm::vec3 pos, std::optional<glm::vec3> col) {
 		if (i < mNodes.size()) {
 			mNodes[i].position = pos;
 			mNodes[i].color = col.value_or(mOverrideColor.value_or(glm::vec3(1.f)));
-			mDirty = true;
+			mVersion++;
 		}
 	}
 
@@ -113,18 +119,20 @@ namespace neo {
 	void LineMeshComponent::removeNode(const int index) {
 		if (index >= 0 && index < (int)mNodes.size()) {
 			mNodes.erase(mNodes.begin() + index);
-			mDirty = true;
+			mVersion++;
 		}
 	}
 
 	void LineMeshComponent::clearNodes() {
 		mNodes.clear();
-		mDirty = true;
+		mVersion++;
 	}
 
 	void LineMeshComponent::imGuiEditor() {
 		if (mOverrideColor) {
-			mDirty |= ImGui::ColorPicker3("Color", &(mOverrideColor.value())[0]);
+			if (ImGui::ColorPicker3("Color", &(mOverrideColor.value())[0])) {
+				mVersion++;
+			}
 		}
 		ImGui::Separator();
 
@@ -17,7 +17,9 @@ namespace neo {
 		std::optional<glm::vec3> mOverrideColor;
 		std::vector<Node> mNodes;
 		bool mUseParentSpatial;
-		mutable bool mDirty;
+		// Bumped on every edit -- the renderer uploads whenever it hasn't seen the latest one
+		uint32_t mVersion;
+		mutable uint32_t mUploadedVersion;
 
 		LineMeshComponent(const MeshManager& meshManager, std::optional<glm::vec3> overrideColor = std::nullopt);
 		~LineMeshComponent();
@@ -32,6 +34,9 @@ namespace neo {
 		void removeNode(const int index);
 		void clearNodes();
 
+		// Pipelined renderers upload from a snapshot
+		void writeBack(const LineMeshComponent& rendered);
+
 		virtual void imGuiEditor() override;
 	END_COMPONENT();
 }
\ No newline at end of file
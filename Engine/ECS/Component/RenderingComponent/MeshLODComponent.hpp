@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ECS/Component/Component.hpp"
+
+#include "ResourceManager/MeshManager.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace neo {
+	START_COMPONENT(MeshLODComponent);
+		struct LOD {
+			MeshHandle mMeshHandle;
+			float mError = 0.f; // Simplification error relative to the mesh's bounding radius
+		};
+
+		MeshLODComponent(std::vector<LOD> lods, float radius)
+			: mLODs(lods)
+			, mRadius(radius)
+		{}
+
+		// Shadows can get away with coarser meshes than the main view
+		const MeshHandle& getShadowMesh() const {
+			return mLODs[std::min(static_cast<size_t>(mCurrentLOD) + mShadowLODBias, mLODs.size() - 1)].mMeshHandle;
+		}
+
+		virtual void imGuiEditor() override {
+			ImGui::Text("LOD: %d / %d", mCurrentLOD, static_cast<int>(mLODs.size()) - 1);
+			for (int i = 0; i < mLODs.size(); i++) {
+				ImGui::Text("  %d: %0.4f", i, mLODs[i].mError);
+			}
+			int bias = mShadowLODBias;
+			if (ImGui::SliderInt("Shadow LOD Bias", &bias, 0, 4)) {
+				mShadowLODBias = static_cast<uint8_t>(bias);
+			}
+		}
+
+		std::vector<LOD> mLODs; // [0] is the full mesh
+		float mRadius = 0.f; // Object space bounding radius
+		uint8_t mCurrentLOD = 0; // Maintained by MeshLODSystem
+		uint8_t mShadowLODBias = 1;
+	END_COMPONENT();
+}
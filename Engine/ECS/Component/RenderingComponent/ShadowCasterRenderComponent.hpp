@@ -4,5 +4,16 @@
 
 namespace neo {
 	START_COMPONENT(ShadowCasterRenderComponent);
+		// Maintained by ShadowCacheSystem -- casters that haven't moved in a while get baked into static shadow caches
+		bool mStatic = false;
+		uint32_t mLastChangeCount = UINT32_MAX;
+		uint16_t mUnchangedFrames = 0;
+		glm::vec3 mWorldMin = glm::vec3(-FLT_MAX);
+		glm::vec3 mWorldMax = glm::vec3(FLT_MAX);
+
+		virtual void imGuiEditor() override {
+			ImGui::Text("%s", mStatic ? "Static" : "Dynamic");
+			ImGui::Text("Unchanged frames: %d", mUnchangedFrames);
+		}
 	END_COMPONENT();
-}
\ No newline at end of file
+}
@@ -1,3 +1,4 @@
+#include "ECS/pch.hpp"
 #include "ShadowMapComponents.hpp"
 #include "ECS/Component/CameraComponent/CSMCameraComponent.hpp"
 
@@ -20,25 +21,107 @@ namespace neo {
 				)
 			);
 		}
+
+		// Named off the shadow map it caches so it can't collide
+		TextureHandle _createStaticShadowMap(const TextureManager& textureManager, const TextureHandle& shadowMap, types::texture::Target target, int resolution, uint8_t mips) {
+			return _createShadowMap(
+				textureManager,
+				std::string("StaticShadowMap_" + std::to_string(shadowMap.mHandle)).c_str(),
+				target,
+				resolution,
+				mips
+			);
+		}
+
+		void _resetCache(ShadowCacheComponent& cache) {
+			cache.mStaticDirty.fill(true);
+			cache.mDynamicDirty.fill(true);
+			cache.mLastViewProj.fill(glm::mat4(0.f));
+			cache.mStaticCached.fill(false);
+		}
 	}
 
-	PointLightShadowMapComponent::PointLightShadowMapComponent(int resolution, const TextureManager& textureManager) {
+	PointLightShadowMapComponent::PointLightShadowMapComponent(int resolution, const TextureManager& textureManager, const std::string& lightName)
+		: mResolution(resolution)
+	{
 		mShadowMap = _createShadowMap(
 			textureManager,
-			std::string("PointLightShadowMap_" + std::to_string(util::genRandom())).c_str(),
+			std::string("PointLightShadowMap_" + lightName).c_str(),
 			types::texture::Target::TextureCube,
 			resolution,
 			1
 		);
 	}
 
-	CSMShadowMapComponent::CSMShadowMapComponent(int resolution, const TextureManager& textureManager) {
+	CSMShadowMapComponent::CSMShadowMapComponent(int resolution, const TextureManager& textureManager, uint8_t cascadeCount)
+		: mResolution(resolution)
+		, mCascadeCount(cascadeCount)
+	{
+		NEO_ASSERT(mCascadeCount > 0 && mCascadeCount <= CSM_MAX_CAMERA_COUNT, "Invalid cascade count %d", mCascadeCount);
 		mShadowMap = _createShadowMap(
 			textureManager,
 			"CSMShadowMap",
 			types::texture::Target::Texture2D,
 			resolution,
-			CSM_CAMERA_COUNT
+			mCascadeCount
 		);
 	}
+
+	uint8_t PointLightShadowMapComponent::getFaceMask(const glm::vec3& lightPos, float range, const glm::vec3& worldMin, const glm::vec3& worldMax) {
+		const glm::vec3 min = worldMin - lightPos;
+		const glm::vec3 max = worldMax - lightPos;
+
+		// Closest point on the box to the light
+		if (glm::length(glm::clamp(glm::vec3(0.f), min, max)) > range) {
+			return 0;
+		}
+
+		// Smallest |x| within the box's extent on each axis
+		glm::vec3 minAbs(0.f);
+		for (int axis = 0; axis < 3; axis++) {
+			if (min[axis] > 0.f || max[axis] < 0.f) {
+				minAbs[axis] = std::min(std::abs(min[axis]), std::abs(max[axis]));
+			}
+		}
+
+		// Face +X sees everything where x >= |y| and x >= |z| -- the box touches it if its furthest x clears the nearest y and z
+		uint8_t mask = 0;
+		for (int axis = 0; axis < 3; axis++) {
+			const int u = (axis + 1) % 3;
+			const int v = (axis + 2) % 3;
+			if (max[axis] >= 0.f && max[axis] >= minAbs[u] && max[axis] >= minAbs[v]) {
+				mask |= 1 << (axis * 2);
+			}
+			if (min[axis] <= 0.f && -min[axis] >= minAbs[u] && -min[axis] >= minAbs[v]) {
+				mask |= 1 << (axis * 2 + 1);
+			}
+		}
+		return mask;
+	}
+
+	ShadowCacheComponent::ShadowCacheComponent(const PointLightShadowMapComponent& shadowMap, const TextureManager& textureManager) {
+		mStaticShadowMap = _createStaticShadowMap(textureManager, shadowMap.mShadowMap, types::texture::Target::TextureCube, shadowMap.mResolution, 1);
+		_resetCache(*this);
+	}
+
+	ShadowCacheComponent::ShadowCacheComponent(const CSMShadowMapComponent& shadowMap, const TextureManager& textureManager) {
+		mStaticShadowMap = _createStaticShadowMap(textureManager, shadowMap.mShadowMap, types::texture::Target::Texture2D, shadowMap.mResolution, shadowMap.mCascadeCount);
+		_resetCache(*this);
+	}
+
+	void ShadowCacheComponent::writeBack(const ShadowCacheComponent& rendered) {
+		// Invalidating only happens from ImGui, which runs after this -- anything the renderer cached is still good
+		for (int i = 0; i < MAX_SLICES; i++) {
+			mStaticCached[i] |= rendered.mStaticCached[i];
+		}
+	}
+
+	void ShadowCacheComponent::imGuiEditor() {
+		for (int i = 0; i < MAX_SLICES; i++) {
+			ImGui::Text("%d: %s %s", i, mStaticDirty[i] ? "Static" : "", mDynamicDirty[i] ? "Dynamic" : "");
+		}
+		if (ImGui::Button("Invalidate")) {
+			mStaticCached.fill(false);
+		}
+	}
 }
\ No newline at end of file
@@ -1,18 +1,55 @@
 #pragma once
 
 #include "ECS/Component/Component.hpp"
+#include "ECS/Component/CameraComponent/CSMCameraComponent.hpp"
+#include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
 
 #include "ResourceManager/TextureManager.hpp"
 
+#include <array>
+#include <optional>
+
 namespace neo {
 	START_COMPONENT(PointLightShadowMapComponent);
-	PointLightShadowMapComponent(int resolution, const TextureManager& textureManager);
+	// Named off the light so rebuilding the component (demo swaps, toggling shadows) finds the same map and static cache
+	PointLightShadowMapComponent(int resolution, const TextureManager& textureManager, const std::string& lightName);
 	TextureHandle mShadowMap;
+	int mResolution;
+	std::optional<float> mFarPlaneOverride;
+
+	// Defaults to half the light's scale. Shared by the renderer and the shadow cache so they agree on what's in range
+	float getFarPlane(const SpatialComponent& lightSpatial) const { return mFarPlaneOverride.value_or(lightSpatial.getScale().x / 2.f); }
+
+	// Bit per cube face (+X, -X, +Y, -Y, +Z, -Z) that the world-space box is visible from
+	static uint8_t getFaceMask(const glm::vec3& lightPos, float range, const glm::vec3& worldMin, const glm::vec3& worldMax);
 	END_COMPONENT();
 
 	START_COMPONENT(CSMShadowMapComponent);
-	CSMShadowMapComponent(int resolution, const TextureManager& textureManager);
+	CSMShadowMapComponent(int resolution, const TextureManager& textureManager, uint8_t cascadeCount = CSM_DEFAULT_CAMERA_COUNT);
 	TextureHandle mShadowMap;
+	int mResolution;
+	uint8_t mCascadeCount = CSM_DEFAULT_CAMERA_COUNT; // One mip per cascade
 	END_COMPONENT();
 
+	// Opt-in, lives alongside a PointLightShadowMapComponent or CSMShadowMapComponent
+	// Static casters are rendered into mStaticShadowMap only when something invalidates them, dynamic casters are composited on top
+	// A slice is a cube face or a cascade. The static cache matches the shadow map it's made from, since slices get copied between the two
+	START_COMPONENT(ShadowCacheComponent);
+	ShadowCacheComponent(const PointLightShadowMapComponent& shadowMap, const TextureManager& textureManager);
+	ShadowCacheComponent(const CSMShadowMapComponent& shadowMap, const TextureManager& textureManager);
+	TextureHandle mStaticShadowMap;
+
+	static constexpr int MAX_SLICES = 6;
+	std::array<bool, MAX_SLICES> mStaticDirty; // Static cache needs to be rerendered
+	std::array<bool, MAX_SLICES> mDynamicDirty; // Shadow map needs to be rebuilt from the static cache
+	std::array<glm::mat4, MAX_SLICES> mLastViewProj; // Cascade PVs from the last update
+	uint32_t mLastLightChangeCount = UINT32_MAX;
+	// Set by the renderer once a slice has actually been drawn into the static cache -- mutable b/c the renderer has a const ref to the ECS
+	mutable std::array<bool, MAX_SLICES> mStaticCached;
+
+	bool needsUpdate(int slice) const { return mStaticDirty[slice] || mDynamicDirty[slice]; }
+	// Pipelined renderers cache slices on a snapshot
+	void writeBack(const ShadowCacheComponent& rendered);
+	virtual void imGuiEditor() override;
+	END_COMPONENT();
 }
\ No newline at end of file
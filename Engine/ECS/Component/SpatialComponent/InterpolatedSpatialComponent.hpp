@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ECS/Component/Component.hpp"
+#include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
+
+namespace neo {
+
+	// The entity's spatial is drawn between its last two fixed steps. Only fixed step systems should move it,
+	// anything else gets stomped when the simulated state is put back next frame
+	START_COMPONENT(InterpolatedSpatialComponent);
+		InterpolatedSpatialComponent() {}
+
+		bool mStepped = false;
+		bool mBlended = false; // The spatial currently holds a blend rather than mCurrent
+		SpatialComponent mPrevious;
+		SpatialComponent mCurrent;
+	END_COMPONENT();
+}
@@ -49,6 +49,7 @@ namespace neo {
 
 		mPosition += delta;
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
 	}
@@ -60,6 +61,7 @@ namespace neo {
 
 		mScale *= glm::clamp(factor, glm::vec3(0.f), factor);
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -68,6 +70,7 @@ namespace neo {
 	void SpatialComponent::rotate(const glm::mat3 & mat) {
 		Orientable::rotate(mat);
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -80,6 +83,7 @@ namespace neo {
 
 		mPosition = loc;
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
 	}
@@ -91,6 +95,7 @@ namespace neo {
 
 		this->mScale = scale;
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -103,6 +108,7 @@ namespace neo {
 	void SpatialComponent::setOrientation(const glm::mat3 & orient) {
 		Orientable::setOrientation(orient);
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -112,6 +118,7 @@ namespace neo {
 		Orientable::setOrientation(glm::mat3(mat));
 		setPosition(glm::vec3(mat[3][0], mat[3][1], mat[3][2]));
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -120,6 +127,7 @@ namespace neo {
 	void SpatialComponent::setUVW(const glm::vec3 & u, const glm::vec3 & v, const glm::vec3 & w) {
 		Orientable::setUVW(u, v, w);
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 		mViewMatDirty = true;
 		// Messenger::sendMessage<SpatialChangeMessage>(&mEntity, *this);
@@ -127,8 +135,15 @@ namespace neo {
 
 	void SpatialComponent::setDirty() {
 		mModelMatrixDirty = true;
+		mChangeCount++;
 		mNormalMatrixDirty = true;
 	}
+
+	void SpatialComponent::setTransform(const SpatialComponent& other) {
+		const uint32_t changeCount = mChangeCount;
+		*this = other;
+		mChangeCount = changeCount + 1;
+	}
 		
 	const glm::mat4 & SpatialComponent::getModelMatrix() const {
 		if (mModelMatrixDirty) {
@@ -31,6 +31,8 @@ namespace neo {
 			void setModelMatrix(const glm::mat4 &);
 			void setUVW(const glm::vec3 &, const glm::vec3 &, const glm::vec3 &);
 			void setDirty();
+			// Takes on the other's whole transform as a single change
+			void setTransform(const SpatialComponent& other);
 
 			/* Getters */
 			glm::vec3 getPosition() const { return mPosition; }
@@ -38,10 +40,13 @@ namespace neo {
 			const glm::mat4& getModelMatrix() const;
 			const glm::mat3& getNormalMatrix() const;
 			const glm::mat4& getView() const;
+			// Bumped whenever the transform is modified -- compare against a cached value to detect movement
+			uint32_t getChangeCount() const { return mChangeCount; }
 
 		private:
 			glm::vec3 mPosition{ 0.f, 0.f, 0.f };
 			glm::vec3 mScale{ 1.f, 1.f, 1.f };
+			uint32_t mChangeCount = 0;
 
 			void _detModelMatrix() const;
 			void _detNormalMatrix() const;
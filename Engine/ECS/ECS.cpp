@@ -4,9 +4,26 @@
 #include "Component/EngineComponents/PinnedComponent.hpp"
 #include "Component/EngineComponents/TagComponent.hpp"
 #include "Component/CollisionComponent/SelectedComponent.hpp"
+#include "Component/EngineComponents/FrameStatsComponent.hpp"
+#include "Component/SpatialComponent/InterpolatedSpatialComponent.hpp"
+
+#include "Util/MemoryTracker.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <chrono>
 
 namespace neo {
 
+	namespace {
+		// Any further behind than this and the time is dropped rather than spiraling
+		constexpr int sMaxFixedSteps = 8;
+	}
+
+	std::mutex ECS::sSnapshotMutex;
+	std::vector<ECS::SnapshotFunc> ECS::sSnapshotFuncs;
+	std::vector<ECS::SnapshotFunc> ECS::sWriteBackFuncs;
+
 	void ECS::_initSystems() {
 		for (auto& system : mSystems) {
 			system.second->init(*this);
@@ -15,11 +32,115 @@ namespace neo {
 
 	void ECS::_updateSystems(const ResourceManagers& resourceManagers) {
 		TRACY_ZONEN("Update Systems");
+		NEO_MEMORY_TAG(ECS);
 		for (auto& system : mSystems) {
-			if (system.second->mActive) {
-				system.second->update(*this, resourceManagers);
+			system.second->mFrameTime = 0.f;
+		}
+		_updateFixedSystems(resourceManagers);
+		for (auto& system : mSystems) {
+			if (system.second->mActive && !system.second->mFixedUpdate) {
+				_updateSystem(*system.second, resourceManagers);
 			}
 		}
+		_recordSystemTimings();
+	}
+
+	void ECS::_updateSystem(System& system, const ResourceManagers& resourceManagers) {
+		const auto start = std::chrono::steady_clock::now();
+		system.update(*this, resourceManagers);
+		system.mFrameTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void ECS::_recordSystemTimings() {
+		for (auto& [_, system] : mSystems) {
+			if (!system->mActive) {
+				continue;
+			}
+			system->_recordTime(system->mFrameTime);
+
+			// Only log on the way over so a slow system doesn't flood the console
+			const bool overBudget = system->mBudgetMS > 0.f && system->mFrameTime > system->mBudgetMS;
+			if (overBudget) {
+				system->mBudgetOverruns++;
+				if (!system->mOverBudget) {
+					NEO_LOG_W("%s took %0.3fms -- over its %0.3fms budget", system->mName.c_str(), system->mFrameTime, system->mBudgetMS);
+				}
+			}
+			system->mOverBudget = overBudget;
+		}
+	}
+
+	std::vector<std::pair<std::string, System::Timings>> ECS::getSystemTimings() const {
+		std::vector<std::pair<std::string, System::Timings>> timings;
+		timings.reserve(mSystems.size());
+		for (auto& [_, system] : mSystems) {
+			timings.emplace_back(system->mName, system->getTimings());
+		}
+		return timings;
+	}
+
+	void ECS::_updateFixedSystems(const ResourceManagers& resourceManagers) {
+		bool hasFixedSystems = false;
+		for (auto& system : mSystems) {
+			hasFixedSystems |= system.second->mActive && system.second->mFixedUpdate;
+		}
+		auto frameStatsOpt = getComponent<FrameStatsComponent>();
+		if (!hasFixedSystems || !frameStatsOpt || mFixedTimestep <= 0.f) {
+			return;
+		}
+		TRACY_ZONEN("Fixed Update");
+		auto&& [_, frameStats] = *frameStatsOpt;
+		const float frameDT = frameStats.mDT;
+		auto interpolatedView = getView<InterpolatedSpatialComponent, SpatialComponent>();
+
+		// Last frame's blend was just for drawing -- step from where the simulation actually left off
+		for (auto&& [entity, interpolated, spatial] : interpolatedView.each()) {
+			if (interpolated.mBlended) {
+				spatial.setTransform(interpolated.mCurrent);
+				interpolated.mBlended = false;
+			}
+		}
+
+		// Fixed systems see the step as their frame time
+		frameStats.mDT = mFixedTimestep;
+		mFixedAccumulator += frameDT;
+		for (int step = 0; mFixedAccumulator >= mFixedTimestep; step++) {
+			if (step == sMaxFixedSteps) {
+				mFixedAccumulator = std::fmod(mFixedAccumulator, mFixedTimestep);
+				break;
+			}
+			for (auto&& [entity, interpolated, spatial] : interpolatedView.each()) {
+				interpolated.mPrevious = spatial;
+			}
+			for (auto& system : mSystems) {
+				if (system.second->mActive && system.second->mFixedUpdate) {
+					_updateSystem(*system.second, resourceManagers);
+				}
+			}
+			for (auto&& [entity, interpolated, spatial] : interpolatedView.each()) {
+				interpolated.mCurrent = spatial;
+				interpolated.mStepped = true;
+			}
+			mFixedAccumulator -= mFixedTimestep;
+		}
+		frameStats.mDT = frameDT;
+
+		// Draw the leftover time as a blend between the last two steps
+		const float alpha = mFixedAccumulator / mFixedTimestep;
+		for (auto&& [entity, interpolated, spatial] : interpolatedView.each()) {
+			// Nothing moved it during the last step, so it's already sitting at mCurrent. Writing the blend anyway would
+			// bump its change count every frame and nothing interpolated would ever look static (shadow cache, etc)
+			if (!interpolated.mStepped || interpolated.mPrevious.getChangeCount() == interpolated.mCurrent.getChangeCount()) {
+				continue;
+			}
+			const glm::quat previousOrientation = glm::quat_cast(interpolated.mPrevious.getOrientation());
+			const glm::quat currentOrientation = glm::quat_cast(interpolated.mCurrent.getOrientation());
+			const glm::mat3 orientation = glm::mat3_cast(glm::slerp(previousOrientation, currentOrientation, alpha));
+			spatial.setPosition(glm::mix(interpolated.mPrevious.getPosition(), interpolated.mCurrent.getPosition(), alpha));
+			spatial.setScale(glm::mix(interpolated.mPrevious.getScale(), interpolated.mCurrent.getScale(), alpha));
+			spatial.setUVW(orientation[0], orientation[1], orientation[2]);
+			interpolated.mBlended = true;
+		}
 	}
 
 	void ECS::submitEntity(EntityBuilder&& builder) {
@@ -34,6 +155,7 @@ namespace neo {
 
 	void ECS::_flush() {
 		TRACY_ZONE();
+		NEO_MEMORY_TAG(ECS);
 
 		{
 			TRACY_ZONEN("Create Entities");
@@ -97,6 +219,28 @@ namespace neo {
 		mRegistry.clear();
 		NEO_ASSERT(mRegistry.alive() == 0, "What");
 		mSystems.clear();
+		mFixedTimestep = 1.f / 60.f;
+		mFixedAccumulator = 0.f;
+	}
+
+	void ECS::_snapshot(ECS& snapshot) const {
+		TRACY_ZONE();
+		NEO_MEMORY_TAG(ECS);
+		snapshot.mRegistry.clear();
+		snapshot.mRegistry.assign(mRegistry.data(), mRegistry.data() + mRegistry.size(), mRegistry.released());
+
+		std::lock_guard<std::mutex> lock(sSnapshotMutex);
+		for (auto& copy : sSnapshotFuncs) {
+			copy(mRegistry, snapshot.mRegistry);
+		}
+	}
+
+	void ECS::_writeBack(const ECS& snapshot) {
+		TRACY_ZONE();
+		std::lock_guard<std::mutex> lock(sSnapshotMutex);
+		for (auto& writeBack : sWriteBackFuncs) {
+			writeBack(snapshot.mRegistry, mRegistry);
+		}
 	}
 
 	void ECS::_imguiEdtor() {
@@ -165,6 +309,18 @@ namespace neo {
 				ImGui::PopID();
 				if (treeActive) {
 					ImGui::Checkbox("Active", &sys->mActive);
+					ImGui::Checkbox("Fixed Update", &sys->mFixedUpdate);
+					const System::Timings timings = sys->getTimings();
+					ImGui::Text("%0.3fms | avg %0.3f min %0.3f max %0.3f", timings.mLast, timings.mAvg, timings.mMin, timings.mMax);
+					ImGui::Text("p50 %0.3f p95 %0.3f p99 %0.3f", timings.mP50, timings.mP95, timings.mP99);
+					if (!sys->mUpdateTimes.empty()) {
+						ImGui::PlotLines("##Timings", sys->mUpdateTimes.data(), static_cast<int>(sys->mUpdateTimes.size()), sys->mUpdateTimesOffset, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 32.f));
+					}
+					ImGui::DragFloat("Budget (ms)", &sys->mBudgetMS, 0.01f, 0.f, 100.f);
+					if (timings.mBudgetOverruns) {
+						ImGui::SameLine();
+						ImGui::Text("%d over", static_cast<int>(timings.mBudgetOverruns));
+					}
 					sys->imguiEditor(*this);
 					ImGui::TreePop();
 				}
@@ -91,6 +91,13 @@ namespace neo {
 		template <typename SysT> bool isSystemEnabled() const;
 		template <typename SysT> void setSystemActive(bool active);
 
+		/* Fixed step systems */
+		void setFixedTimestep(float seconds) { mFixedTimestep = seconds; }
+		float getFixedTimestep() const { return mFixedTimestep; }
+
+		/* System timings */
+		std::vector<std::pair<std::string, System::Timings>> getSystemTimings() const;
+
 
 	private:
 		mutable Registry mRegistry;
@@ -111,15 +118,39 @@ namespace neo {
 		std::vector<ComponentModFunc> mRemoveComponentFuncs;
 
 		std::vector<std::pair<std::type_index, std::unique_ptr<System>>> mSystems;
+		float mFixedTimestep = 1.f / 60.f;
+		float mFixedAccumulator = 0.f;
 		void _initSystems();
 		void _updateSystems(const ResourceManagers& resourceManagers);
+		void _updateFixedSystems(const ResourceManagers& resourceManagers);
+		void _updateSystem(System& system, const ResourceManagers& resourceManagers);
+		void _recordSystemTimings();
 
 
 		void _flush();
 		void _clean();
 		void _imguiEdtor();
+
+		/* Render extraction */
+		// Copies every entity and component into snapshot, keeping entity ids. Pending queues aren't copied
+		void _snapshot(ECS& snapshot) const;
+		// Renderers write some state back into the components they were handed. Components that define
+		// writeBack(const CompT& rendered) get it merged back from the snapshot, everything else is thrown away
+		void _writeBack(const ECS& snapshot);
+		using SnapshotFunc = void(*)(Registry& source, Registry& destination);
+		static std::mutex sSnapshotMutex;
+		static std::vector<SnapshotFunc> sSnapshotFuncs;
+		static std::vector<SnapshotFunc> sWriteBackFuncs;
+		template<typename CompT> static bool _registerSnapshot();
 	};
 
+	namespace {
+		template<typename CompT, typename = void>
+		struct HasWriteBack : std::false_type {};
+		template<typename CompT>
+		struct HasWriteBack<CompT, std::void_t<decltype(std::declval<CompT&>().writeBack(std::declval<const CompT&>()))>> : std::true_type {};
+	}
+
 	template<typename CompT>
 	std::optional<std::tuple<ECS::Entity, CompT&>> ECS::getComponent() {
 		static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
@@ -243,6 +274,9 @@ namespace neo {
 		};
 		mEditor.registerComponent<CompT>(info);
 
+		// Every component type that's ever been added gets copied on extraction
+		[[maybe_unused]] static const bool sSnapshotRegistered = _registerSnapshot<CompT>();
+
 		{
 			std::lock_guard<std::mutex> lock(mAddComponentMutex);
 			mAddComponentFuncs.emplace_back([e, component](Registry& registry) mutable {
@@ -261,6 +295,31 @@ namespace neo {
 		return component;
 	}
 
+	template<typename CompT>
+	bool ECS::_registerSnapshot() {
+		static_assert(std::is_copy_constructible<CompT>::value, "CompT must be copyable to be extracted for rendering");
+		std::lock_guard<std::mutex> lock(sSnapshotMutex);
+		sSnapshotFuncs.push_back([](Registry& source, Registry& destination) {
+			for (auto&& [entity, component] : source.view<const CompT>().each()) {
+				destination.emplace<CompT>(entity, component);
+			}
+		});
+		if constexpr (HasWriteBack<CompT>::value) {
+			sWriteBackFuncs.push_back([](Registry& snapshot, Registry& destination) {
+				for (auto&& [entity, rendered] : snapshot.view<const CompT>().each()) {
+					// The simulation may have destroyed it since
+					if (!destination.valid(entity)) {
+						continue;
+					}
+					if (auto* component = destination.try_get<CompT>(entity)) {
+						component->writeBack(rendered);
+					}
+				}
+			});
+		}
+		return true;
+	}
+
 	template<typename CompT>
 	void ECS::removeComponent(Entity e) {
 		static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
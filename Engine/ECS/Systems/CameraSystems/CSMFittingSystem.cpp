@@ -19,11 +19,11 @@ namespace neo {
 
 	namespace {
 		// https://developer.nvidia.com/gpugems/gpugems3/part-ii-light-and-shadows/chapter-10-parallel-split-shadow-maps-programmable-gpus
-		float _calculateNearSplit(const float lambda, const int lod, const float sourceNear, const float sourceFar) {
+		float _calculateNearSplit(const float lambda, const int lod, const int cascadeCount, const float sourceNear, const float sourceFar) {
 			if (lod == 0) {
 				return sourceNear;
 			}
-			float splitCount = CSM_CAMERA_COUNT + 1; // Near and far are technically their own splits, near already accounted for 
+			float splitCount = static_cast<float>(cascadeCount + 1); // Near and far are technically their own splits, near already accounted for 
 			float cLog = sourceNear * static_cast<float>(glm::pow(sourceFar / sourceNear, lod / splitCount));
 			float cUniform = sourceNear + (sourceFar - sourceNear) * lod / splitCount;
 			return lambda * cLog + (1.f - lambda) * cUniform;
@@ -32,6 +32,7 @@ namespace neo {
 		// https://alextardif.com/shadowmapping.html
 		void _doFitting(
 			const float lambda,
+			const int cascadeCount,
 			const SpatialComponent& sourceSpatial,
 			const CameraComponent& sourceCamera,
 			const SpatialComponent& lightSpatial,
@@ -39,7 +40,7 @@ namespace neo {
 			const float bias,
 			SpatialComponent& receiverSpatial,
 			CameraComponent& receiverCamera,
-			CSMCameraComponent* csmCamera
+			const CSMCameraComponent& csmCamera
 		) {
 
 			// Set base
@@ -51,10 +52,10 @@ namespace neo {
 			glm::mat4 sourceProj = sourceCamera.getProj();
 			{
 
-				float near = _calculateNearSplit(lambda, csmCamera->getLod(), sourceCamera.getNear(), sourceCamera.getFar());
-				float far = csmCamera->getLod() == CSM_CAMERA_COUNT - 1
+				float near = _calculateNearSplit(lambda, csmCamera.getLod(), cascadeCount, sourceCamera.getNear(), sourceCamera.getFar());
+				float far = csmCamera.getLod() == cascadeCount - 1
 					? sourceCamera.getFar()
-					: _calculateNearSplit(lambda, csmCamera->getLod() + 1, sourceCamera.getNear(), sourceCamera.getFar());
+					: _calculateNearSplit(lambda, csmCamera.getLod() + 1, cascadeCount, sourceCamera.getNear(), sourceCamera.getFar());
 
 				CameraComponent sourceCopy = sourceCamera;
 				sourceCopy.setNear(near);
@@ -83,7 +84,7 @@ namespace neo {
 			}
 
 			const float radius = std::ceil(frustumWorldBB.getRadius());
-			const float texelsPerUnit = (shadowMapResolution >> csmCamera->getLod()) / (radius * 2.f);
+			const float texelsPerUnit = (shadowMapResolution >> csmCamera.getLod()) / (radius * 2.f);
 			const glm::mat4 scalar = glm::scale(glm::mat4(1.f), glm::vec3(texelsPerUnit));
 			const glm::mat4 lookAt = scalar * lightSpatial.getView();
 			const glm::mat4 iLookAt = glm::inverse(lookAt);
@@ -134,22 +135,13 @@ namespace neo {
 			shadowMapResolution = std::max(shadowTexture.mWidth, shadowTexture.mHeight);
 		}
 
-		auto csmCamera0Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera0Component>();
-		auto csmCamera1Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera1Component>();
-		auto csmCamera2Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera2Component>();
-		NEO_ASSERT(csmCamera0Tuple && csmCamera1Tuple && csmCamera2Tuple, "CSM Camera's dont exist");
-		auto& [cameraEntity0, cameraSpatial0, cameraCamera0, csmCamera0] = *csmCamera0Tuple;
-		auto& [cameraEntity1, cameraSpatial1, cameraCamera1, csmCamera1] = *csmCamera1Tuple;
-		auto& [cameraEntity2, cameraSpatial2, cameraCamera2, csmCamera2] = *csmCamera2Tuple;
-
-		NEO_ASSERT(
-			cameraCamera0.getType() == CameraComponent::CameraType::Orthographic 
-			&& cameraCamera0.getType() == cameraCamera1.getType() 
-			&& cameraCamera1.getType() == cameraCamera2.getType(), "Frustum fit receiver needs to be orthographic");
-
-		_doFitting(mLambda, sourceSpatial, sourceCamera, lightSpatial, shadowMapResolution, lightReceiver.mBias, cameraSpatial0, cameraCamera0, &csmCamera0);
-		_doFitting(mLambda, sourceSpatial, sourceCamera, lightSpatial, shadowMapResolution, lightReceiver.mBias, cameraSpatial1, cameraCamera1, &csmCamera1);
-		_doFitting(mLambda, sourceSpatial, sourceCamera, lightSpatial, shadowMapResolution, lightReceiver.mBias, cameraSpatial2, cameraCamera2, &csmCamera2);
+		for (auto&& [cameraEntity, cameraSpatial, cameraCamera, csmCamera] : ecs.getView<SpatialComponent, CameraComponent, CSMCameraComponent>().each()) {
+			NEO_ASSERT(cameraCamera.getType() == CameraComponent::CameraType::Orthographic, "Frustum fit receiver needs to be orthographic");
+			if (csmCamera.getLod() >= shadowMap.mCascadeCount) {
+				continue;
+			}
+			_doFitting(mLambda, shadowMap.mCascadeCount, sourceSpatial, sourceCamera, lightSpatial, shadowMapResolution, lightReceiver.mBias, cameraSpatial, cameraCamera, csmCamera);
+		}
 	}
 
 	void CSMFittingSystem::imguiEditor(ECS&) {
@@ -9,6 +9,8 @@
 
 #include "ECS/Systems/CameraSystems/FrustumSystem.hpp"
 
+#include "Util/FrameArena.hpp"
+
 
 namespace neo {
 
@@ -23,7 +25,8 @@ namespace neo {
 		// This is risky
 		uint32_t cameraCount = ecs.entityCount<FrustumComponent>();
 
-		CameraCulledComponent::CameraIDs cameraIDs;
+		// Scratch for this update only. The components keep their own lists and reuse them, so this doesn't allocate after the first frame
+		util::FrameVector<ECS::Entity> cameraIDs;
 		cameraIDs.resize(cameraCount);
 
 		for (auto&& [entity, spatial, bb] : ecs.getView<SpatialComponent, BoundingBoxComponent>().each()) {
@@ -50,10 +53,10 @@ namespace neo {
 
 			// Shove it into ECS
 			if (auto* existingComp = ecs.getComponent<CameraCulledComponent>(entity)) {
-				existingComp->mCameraIDs = cameraIDs;
+				existingComp->mCameraIDs.assign(cameraIDs.begin(), cameraIDs.end());
 			}
 			else {
-				ecs.addComponent<CameraCulledComponent>(entity, cameraIDs);
+				ecs.addComponent<CameraCulledComponent>(entity, CameraCulledComponent::CameraIDs(cameraIDs.begin(), cameraIDs.end()));
 			}
 		}
 	}
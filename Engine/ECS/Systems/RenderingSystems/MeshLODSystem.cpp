@@ -0,0 +1,71 @@
+#include "ECS/pch.hpp"
+#include "MeshLODSystem.hpp"
+
+#include "ECS/ECS.hpp"
+#include "ECS/Component/CameraComponent/CameraComponent.hpp"
+#include "ECS/Component/CameraComponent/MainCameraComponent.hpp"
+#include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
+#include "ECS/Component/HardwareComponent/ViewportDetailsComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
+#include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
+
+namespace neo {
+
+	void MeshLODSystem::update(ECS& ecs, const ResourceManagers& resourceManagers) {
+		TRACY_ZONE();
+		NEO_UNUSED(resourceManagers);
+
+		auto cameraView = ecs.getSingleView<MainCameraComponent, CameraComponent, SpatialComponent>();
+		auto viewport = ecs.cGetComponent<ViewportDetailsComponent>();
+		if (!cameraView || !viewport) {
+			return;
+		}
+		const auto& [cameraEntity, _, camera, cameraSpatial] = *cameraView;
+		const float viewportHeight = static_cast<float>(std::get<1>(*viewport).mSize.y);
+
+		mLODCounts.clear();
+		for (auto&& [entity, lod, mesh, spatial] : ecs.getView<MeshLODComponent, MeshComponent, SpatialComponent>().each()) {
+			if (lod.mLODs.empty()) {
+				continue;
+			}
+
+			// Pixels per world unit at the mesh's nearest point
+			// Imported nodes can sit far from their geometry (all of Sponza hangs off one node at the origin), so go off the world-space box
+			const glm::vec3 scale = spatial.getScale();
+			const float radius = lod.mRadius * std::max(scale.x, std::max(scale.y, scale.z));
+			float distance = glm::distance(spatial.getPosition(), cameraSpatial.getPosition()) - radius;
+			if (const auto* box = ecs.cGetComponent<BoundingBoxComponent>(entity)) {
+				distance = box->getWorldBounds(spatial.getModelMatrix()).getDistance(cameraSpatial.getPosition());
+			}
+			const float pixelsPerUnit = camera.getPixelsPerUnit(distance, viewportHeight);
+			auto errorPixels = [&](size_t i) {
+				return lod.mLODs[i].mError * radius * pixelsPerUnit;
+			};
+
+			size_t current = std::min(static_cast<size_t>(lod.mCurrentLOD), lod.mLODs.size() - 1);
+			while (current + 1 < lod.mLODs.size() && errorPixels(current + 1) < mPixelError * (1.f - mHysteresis)) {
+				current++;
+			}
+			while (current > 0 && errorPixels(current) > mPixelError) {
+				current--;
+			}
+
+			lod.mCurrentLOD = static_cast<uint8_t>(current);
+			mesh.mMeshHandle = lod.mLODs[current].mMeshHandle;
+
+			if (mLODCounts.size() <= current) {
+				mLODCounts.resize(current + 1, 0);
+			}
+			mLODCounts[current]++;
+		}
+	}
+
+	void MeshLODSystem::imguiEditor(ECS&) {
+		ImGui::SliderFloat("Pixel Error", &mPixelError, 0.1f, 16.f);
+		ImGui::SliderFloat("Hysteresis", &mHysteresis, 0.f, 0.9f);
+		for (int i = 0; i < mLODCounts.size(); i++) {
+			ImGui::Text("LOD %d: %d", i, mLODCounts[i]);
+		}
+	}
+}
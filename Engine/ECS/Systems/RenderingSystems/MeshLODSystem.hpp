@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ECS/Systems/System.hpp"
+
+namespace neo {
+
+	// Picks each MeshLODComponent's LOD from its projected error against the main camera and swaps it into the MeshComponent
+	class MeshLODSystem : public neo::System {
+
+	public:
+
+		MeshLODSystem(float pixelError = 1.f, float hysteresis = 0.25f)
+			: neo::System("Mesh LOD System")
+			, mPixelError(pixelError)
+			, mHysteresis(hysteresis)
+		{ }
+
+		virtual void update(neo::ECS& ecs, const ResourceManagers& resourceManagers) override;
+		virtual void imguiEditor(ECS&) override;
+
+	private:
+		float mPixelError = 1.f; // Largest on-screen simplification error allowed
+		float mHysteresis = 0.25f; // Going coarser needs the error to be this much under the threshold -- stops popping back and forth
+		std::vector<int> mLODCounts;
+	};
+}
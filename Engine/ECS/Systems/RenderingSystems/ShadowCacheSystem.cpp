@@ -0,0 +1,155 @@
+#include "ECS/pch.hpp"
+#include "ShadowCacheSystem.hpp"
+
+#include "ECS/ECS.hpp"
+#include "ECS/Component/CameraComponent/CameraComponent.hpp"
+#include "ECS/Component/CameraComponent/CSMCameraComponent.hpp"
+#include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
+#include "ECS/Component/RenderingComponent/ShadowCasterRenderComponent.hpp"
+#include "ECS/Component/RenderingComponent/ShadowMapComponents.hpp"
+#include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
+
+namespace neo {
+
+	namespace {
+		// World-space region a caster entered or left this frame
+		struct ChangedRegion {
+			glm::vec3 mMin;
+			glm::vec3 mMax;
+			bool mStatic;
+		};
+
+		bool _isUnbounded(const ChangedRegion& region) {
+			return glm::any(glm::equal(region.mMin, glm::vec3(-FLT_MAX))) || glm::any(glm::equal(region.mMax, glm::vec3(FLT_MAX)));
+		}
+
+		// Cascades are orthographic so this is just an AABB test in NDC
+		bool _overlapsCascade(const glm::mat4& PV, const ChangedRegion& region) {
+			if (_isUnbounded(region)) {
+				return true;
+			}
+
+			glm::vec3 ndcMin(FLT_MAX);
+			glm::vec3 ndcMax(-FLT_MAX);
+			for (int i = 0; i < 8; i++) {
+				glm::vec4 corner = PV * glm::vec4(
+					(i & 1) ? region.mMax.x : region.mMin.x,
+					(i & 2) ? region.mMax.y : region.mMin.y,
+					(i & 4) ? region.mMax.z : region.mMin.z,
+					1.f
+				);
+				corner /= corner.w;
+				ndcMin = glm::min(ndcMin, glm::vec3(corner));
+				ndcMax = glm::max(ndcMax, glm::vec3(corner));
+			}
+			return !glm::any(glm::lessThan(ndcMax, glm::vec3(-1.f))) && !glm::any(glm::greaterThan(ndcMin, glm::vec3(1.f)));
+		}
+
+		void _markSlice(ShadowCacheComponent& cache, int slice, bool isStatic) {
+			if (isStatic) {
+				cache.mStaticDirty[slice] = true;
+			}
+			else {
+				cache.mDynamicDirty[slice] = true;
+			}
+		}
+	}
+
+	void ShadowCacheSystem::update(ECS& ecs, const ResourceManagers& resourceManagers) {
+		TRACY_ZONE();
+		NEO_UNUSED(resourceManagers);
+
+		std::vector<ChangedRegion> changedRegions;
+		size_t casterCount = 0;
+		for (auto&& [entity, caster, spatial] : ecs.getView<ShadowCasterRenderComponent, SpatialComponent>().each()) {
+			casterCount++;
+
+			const ChangedRegion oldRegion = { caster.mWorldMin, caster.mWorldMax, caster.mStatic };
+			const bool moved = spatial.getChangeCount() != caster.mLastChangeCount;
+			if (moved) {
+				caster.mLastChangeCount = spatial.getChangeCount();
+				caster.mUnchangedFrames = 0;
+
+				// Casters without a box could be anywhere
+				caster.mWorldMin = glm::vec3(-FLT_MAX);
+				caster.mWorldMax = glm::vec3(FLT_MAX);
+				if (const auto* box = ecs.cGetComponent<BoundingBoxComponent>(entity)) {
+					BoundingBoxComponent worldBox;
+					for (int i = 0; i < 8; i++) {
+						worldBox.addPoint(glm::vec3(spatial.getModelMatrix() * glm::vec4(
+							(i & 1) ? box->mMax.x : box->mMin.x,
+							(i & 2) ? box->mMax.y : box->mMin.y,
+							(i & 4) ? box->mMax.z : box->mMin.z,
+							1.f
+						)));
+					}
+					caster.mWorldMin = worldBox.mMin;
+					caster.mWorldMax = worldBox.mMax;
+				}
+			}
+			else if (caster.mUnchangedFrames < UINT16_MAX) {
+				caster.mUnchangedFrames++;
+			}
+			caster.mStatic = caster.mUnchangedFrames >= mStaticFrameThreshold;
+
+			// Both where it was and where it is now need to be redrawn in whichever cache owned it
+			if (moved || oldRegion.mStatic != caster.mStatic) {
+				changedRegions.push_back(oldRegion);
+				changedRegions.push_back(ChangedRegion{ caster.mWorldMin, caster.mWorldMax, caster.mStatic });
+			}
+		}
+
+		// Removed casters don't leave a trail -- just flush everything
+		const bool casterRemoved = casterCount < mLastCasterCount;
+		mLastCasterCount = casterCount;
+
+		for (auto&& [lightEntity, lightSpatial, shadowMap, cache] : ecs.getView<SpatialComponent, PointLightShadowMapComponent, ShadowCacheComponent>().each()) {
+			cache.mStaticDirty.fill(false);
+			cache.mDynamicDirty.fill(false);
+
+			const bool lightMoved = lightSpatial.getChangeCount() != cache.mLastLightChangeCount;
+			cache.mLastLightChangeCount = lightSpatial.getChangeCount();
+			for (int face = 0; face < 6; face++) {
+				cache.mStaticDirty[face] = lightMoved || casterRemoved || !cache.mStaticCached[face];
+			}
+
+			const float range = shadowMap.getFarPlane(lightSpatial);
+			for (const auto& region : changedRegions) {
+				const uint8_t faceMask = PointLightShadowMapComponent::getFaceMask(lightSpatial.getPosition(), range, region.mMin, region.mMax);
+				for (int face = 0; face < 6; face++) {
+					if (faceMask & (1 << face)) {
+						_markSlice(cache, face, region.mStatic);
+					}
+				}
+			}
+		}
+
+		for (auto&& [lightEntity, shadowMap, cache] : ecs.getView<CSMShadowMapComponent, ShadowCacheComponent>().each()) {
+			cache.mStaticDirty.fill(false);
+			cache.mDynamicDirty.fill(false);
+
+			for (auto&& [cameraEntity, cameraSpatial, cameraCamera, csmCamera] : ecs.getView<SpatialComponent, CameraComponent, CSMCameraComponent>().each()) {
+				const int lod = csmCamera.getLod();
+				if (lod >= shadowMap.mCascadeCount) {
+					continue;
+				}
+
+				// Any refit of the cascade invalidates the whole slice
+				const glm::mat4 PV = cameraCamera.getProj() * cameraSpatial.getView();
+				cache.mStaticDirty[lod] = casterRemoved || !cache.mStaticCached[lod] || PV != cache.mLastViewProj[lod];
+				cache.mLastViewProj[lod] = PV;
+
+				for (const auto& region : changedRegions) {
+					if (_overlapsCascade(PV, region)) {
+						_markSlice(cache, lod, region.mStatic);
+					}
+				}
+			}
+		}
+	}
+
+	void ShadowCacheSystem::imguiEditor(ECS&) {
+		ImGui::SliderInt("Static frame threshold", &mStaticFrameThreshold, 1, 120);
+		ImGui::Text("Casters: %d", static_cast<int>(mLastCasterCount));
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ECS/Systems/System.hpp"
+
+namespace neo {
+
+	// Classifies shadow casters as static or dynamic and marks which ShadowCacheComponent slices need to be redrawn
+	// Should run after anything that moves casters, lights, or CSM cameras
+	class ShadowCacheSystem : public neo::System {
+
+	public:
+
+		ShadowCacheSystem(int staticFrameThreshold = 8)
+			: neo::System("Shadow Cache System")
+			, mStaticFrameThreshold(staticFrameThreshold)
+		{ }
+
+		virtual void update(neo::ECS& ecs, const ResourceManagers& resourceManagers) override;
+		virtual void imguiEditor(ECS&) override;
+
+	private:
+		int mStaticFrameThreshold = 8; // Frames a caster has to sit still before it's baked into static caches
+		size_t mLastCasterCount = 0;
+	};
+}
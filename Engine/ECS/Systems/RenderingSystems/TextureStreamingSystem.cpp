@@ -0,0 +1,66 @@
+#include "ECS/pch.hpp"
+#include "TextureStreamingSystem.hpp"
+
+#include "ECS/ECS.hpp"
+#include "ECS/Component/CameraComponent/CameraComponent.hpp"
+#include "ECS/Component/CameraComponent/MainCameraComponent.hpp"
+#include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
+#include "ECS/Component/CollisionComponent/CameraCulledComponent.hpp"
+#include "ECS/Component/HardwareComponent/ViewportDetailsComponent.hpp"
+#include "ECS/Component/RenderingComponent/MaterialComponent.hpp"
+#include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
+
+#include "ResourceManager/ResourceManagers.hpp"
+
+namespace neo {
+
+	void TextureStreamingSystem::update(ECS& ecs, const ResourceManagers& resourceManagers) {
+		TRACY_ZONE();
+
+		auto cameraView = ecs.getSingleView<MainCameraComponent, CameraComponent, SpatialComponent>();
+		auto viewport = ecs.cGetComponent<ViewportDetailsComponent>();
+		if (!cameraView || !viewport) {
+			return;
+		}
+		const auto& [cameraEntity, _, camera, cameraSpatial] = *cameraView;
+		const float viewportHeight = static_cast<float>(std::get<1>(*viewport).mSize.y);
+		const TextureManager& textureManager = resourceManagers.mTextureManager;
+
+		mRequestCount = 0;
+		for (auto&& [entity, material, spatial, box] : ecs.getView<MaterialComponent, SpatialComponent, BoundingBoxComponent>().each()) {
+			if (auto* culled = ecs.cGetComponent<CameraCulledComponent>(entity)) {
+				if (!culled->isInView(ecs, entity, cameraEntity)) {
+					continue;
+				}
+			}
+
+			// Assume the texture is stretched across the whole object
+			// Measured off the world-space box since imported nodes can sit far from their geometry
+			const BoundingBoxComponent worldBox = box.getWorldBounds(spatial.getModelMatrix());
+			const float radius = worldBox.getRadius();
+			const float pixelsPerUnit = camera.getPixelsPerUnit(worldBox.getDistance(cameraSpatial.getPosition()), viewportHeight);
+			const float projectedPixels = std::max(2.f * radius * pixelsPerUnit, 1.f);
+
+			auto request = [&](const TextureHandle& handle) {
+				if (!textureManager.isValid(handle)) {
+					return;
+				}
+				const Texture& texture = textureManager.resolve(handle);
+				const float texels = static_cast<float>(std::max(texture.mWidth, texture.mHeight));
+				const float mip = glm::clamp(std::floor(std::log2(texels / projectedPixels) + mMipBias), 0.f, static_cast<float>(texture.mFormat.mMipCount - 1));
+				textureManager.requestMip(handle, static_cast<uint16_t>(mip));
+				mRequestCount++;
+			};
+			request(material.mAlbedoMap);
+			request(material.mNormalMap);
+			request(material.mMetallicRoughnessMap);
+			request(material.mOcclusionMap);
+			request(material.mEmissiveMap);
+		}
+	}
+
+	void TextureStreamingSystem::imguiEditor(ECS&) {
+		ImGui::SliderFloat("Mip Bias", &mMipBias, -4.f, 4.f);
+		ImGui::Text("Requests: %d", mRequestCount);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ECS/Systems/System.hpp"
+
+namespace neo {
+
+	// Asks the TextureManager for the mip each visible material needs, based on its size on screen from the main camera
+	class TextureStreamingSystem : public neo::System {
+
+	public:
+
+		TextureStreamingSystem(float mipBias = 0.f)
+			: neo::System("Texture Streaming System")
+			, mMipBias(mipBias)
+		{ }
+
+		virtual void update(neo::ECS& ecs, const ResourceManagers& resourceManagers) override;
+		virtual void imguiEditor(ECS&) override;
+
+	private:
+		float mMipBias = 0.f; // Negative streams in sharper mips than the screen needs
+		int mRequestCount = 0;
+	};
+}
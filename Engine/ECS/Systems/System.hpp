@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "Util/Util.hpp"
 
@@ -10,8 +12,24 @@ namespace neo {
 	class ResourceManagers;
 
 	class System {
+		friend class ECS;
 
 		public:
+			static constexpr int sMaxTimingSamples = 400;
+
+			// Update times in ms. Fixed steps are summed into the frame they ran in
+			struct Timings {
+				float mLast = 0.f;
+				float mMin = 0.f;
+				float mAvg = 0.f;
+				float mMax = 0.f;
+				float mP50 = 0.f;
+				float mP95 = 0.f;
+				float mP99 = 0.f;
+				int mSamples = 0;
+				uint32_t mBudgetOverruns = 0;
+			};
+
 			System(const std::string & name) :
 				mName(name)
 			{}
@@ -31,7 +49,55 @@ namespace neo {
 				NEO_UNUSED(ecs);
 			}
 
+			Timings getTimings() const {
+				Timings timings;
+				timings.mSamples = static_cast<int>(mUpdateTimes.size());
+				timings.mBudgetOverruns = mBudgetOverruns;
+				if (mUpdateTimes.empty()) {
+					return timings;
+				}
+				timings.mLast = mUpdateTimes[(mUpdateTimesOffset + mUpdateTimes.size() - 1) % mUpdateTimes.size()];
+
+				std::vector<float> sorted = mUpdateTimes;
+				std::sort(sorted.begin(), sorted.end());
+				float total = 0.f;
+				for (float time : sorted) {
+					total += time;
+				}
+				auto percentile = [&sorted](float p) {
+					return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<float>(sorted.size())))];
+				};
+				timings.mMin = sorted.front();
+				timings.mMax = sorted.back();
+				timings.mAvg = total / static_cast<float>(sorted.size());
+				timings.mP50 = percentile(0.5f);
+				timings.mP95 = percentile(0.95f);
+				timings.mP99 = percentile(0.99f);
+				return timings;
+			}
+
 			bool mActive = true;
+			// Runs at the ECS's fixed timestep -- zero, one, or several times a frame -- rather than once a frame
+			bool mFixedUpdate = false;
+			// Warns when a frame's update runs longer than this. 0 disables
+			float mBudgetMS = 0.f;
 			const std::string mName = 0;
+
+		private:
+			void _recordTime(float ms) {
+				if (mUpdateTimes.size() < sMaxTimingSamples) {
+					mUpdateTimes.push_back(ms);
+				}
+				else {
+					mUpdateTimes[mUpdateTimesOffset] = ms;
+					mUpdateTimesOffset = (mUpdateTimesOffset + 1) % sMaxTimingSamples;
+				}
+			}
+
+			float mFrameTime = 0.f;
+			std::vector<float> mUpdateTimes;
+			int mUpdateTimesOffset = 0;
+			uint32_t mBudgetOverruns = 0;
+			bool mOverBudget = false;
 	};
 }
\ No newline at end of file
@@ -9,17 +9,22 @@ extern "C" {
 #include "Engine.hpp"
 
 #include "Renderer/Renderer.hpp"
+#include "Renderer/GLObjects/StreamingBuffer.hpp"
 
 #include "ECS/Component/CameraComponent/MainCameraComponent.hpp"
 #include "ECS/Component/CameraComponent/CameraComponent.hpp"
 #include "ECS/Component/EngineComponents/FrameStatsComponent.hpp"
 #include "ECS/Component/EngineComponents/SingleFrameComponent.hpp"
-#include "ECS/Component/EngineComponents/AsyncJobComponent.hpp"
-#include "ECS/Component/EngineComponents/TagComponent.hpp"
 #include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
 #include "ECS/Component/EngineComponents/DebugBoundingBox.hpp"
 #include "ECS/Component/RenderingComponent/LineMeshComponent.hpp"
 #include "ECS/Component/RenderingComponent/ImGuiDrawComponent.hpp"
+#include "ECS/Component/RenderingComponent/IBLComponent.hpp"
+#include "ECS/Component/RenderingComponent/MaterialComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
+#include "ECS/Component/RenderingComponent/ShadowMapComponents.hpp"
+#include "ECS/Component/RenderingComponent/SkyboxComponent.hpp"
 #include "ECS/Component/HardwareComponent/MouseComponent.hpp"
 #include "ECS/Component/HardwareComponent/KeyboardComponent.hpp"
 #include "ECS/Component/HardwareComponent/ViewportDetailsComponent.hpp"
@@ -33,6 +38,9 @@ extern "C" {
 #include "Loader/MeshGenerator.hpp"
 #include "ResourceManager/ResourceManagers.hpp"
 
+#include "Util/AsyncJobs.hpp"
+#include "Util/FrameArena.hpp"
+#include "Util/MemoryTracker.hpp"
 #include "Util/Profiler.hpp"
 #include "Util/Log/Log.hpp"
 #include "Util/ServiceLocator.hpp"
@@ -41,6 +49,10 @@ extern "C" {
 
 #include <time.h>
 #include <iostream>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include <GLFW/glfw3.h>
 
@@ -49,6 +61,7 @@ namespace neo {
 	void Engine::init() {
 
 		srand((unsigned int)(time(0)));
+		util::setLogFile("neo.log");
 
 		ServiceLocator<Renderer>::set(4, 4);
 
@@ -105,27 +118,125 @@ namespace neo {
 		TracyGpuContext;
 	}
 
+	namespace {
+		// Long-lived thread that runs one job at a time, so kicking off the simulation doesn't spawn a thread every frame
+		class SimulationThread {
+		public:
+			SimulationThread()
+				: mThread([this]() { _run(); })
+			{}
+			~SimulationThread() {
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mQuit = true;
+				}
+				mCondition.notify_all();
+				mThread.join();
+			}
+			SimulationThread(const SimulationThread&) = delete;
+			SimulationThread& operator=(const SimulationThread&) = delete;
+
+			void kick(std::function<void()> job) {
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					NEO_ASSERT(!mJob, "Kicking off a simulation while one is still running");
+					mJob = std::move(job);
+				}
+				mCondition.notify_all();
+			}
+
+			void wait() {
+				TRACY_ZONEN("Wait for simulation");
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return !mJob; });
+			}
+
+		private:
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			std::function<void()> mJob;
+			bool mQuit = false;
+			std::thread mThread;
+
+			void _run() {
+				while (true) {
+					std::function<void()> job;
+					{
+						std::unique_lock<std::mutex> lock(mMutex);
+						mCondition.wait(lock, [this]() { return mQuit || mJob; });
+						if (mQuit) {
+							return;
+						}
+						job = mJob;
+					}
+					job();
+					{
+						std::lock_guard<std::mutex> lock(mMutex);
+						mJob = nullptr;
+					}
+					mCondition.notify_all();
+				}
+			}
+		};
+	}
+
 	void Engine::run(DemoWrangler&& demos) {
 
 		util::Profiler profiler(mWindow.getDetails().mRefreshRate);
 
 		ECS ecs;
+		// When pipelined, renderers only ever see this -- a copy of the previous frame's simulation
+		ECS renderECS;
+		bool renderECSValid = false;
+		SimulationThread simulationThread;
 		// TODO - managers could just be added to the ecs probably..but how would that work with threading
 		ResourceManagers resourceManagers;
 
+		// Messages only get relayed on the main thread -- their receivers poke at the window
+		auto simulate = [&](bool relayMessages) {
+			/* Destroy and create objects and components */
+			ecs._flush();
+			if (relayMessages) {
+				Messenger::relayMessages(ecs);
+			}
+
+			{
+				TRACY_ZONEN("Demo::update");
+				NEO_MEMORY_TAG(Demo);
+				demos.getCurrentDemo()->update(ecs, resourceManagers);
+			}
+
+			/* Update each system */
+			ecs._updateSystems(resourceManagers);
+			if (relayMessages) {
+				Messenger::relayMessages(ecs);
+			}
+		};
+
 		demos.setForceReload();
+
+		// When the input that fed the frame being drawn was polled
+		double simulatedInputTime = mInputTime;
 		
 		while (!mWindow.shouldClose()) {
 			TRACY_ZONEN("Engine::run");
 
+			// Pipelined frames draw last frame's simulation, so they present last frame's input
+			double renderedInputTime = simulatedInputTime;
+			simulatedInputTime = mInputTime;
+			bool pipelined = false;
 			{
 				TRACY_ZONEN("Frame");
 				{
 					TRACY_ZONEN("Frame Update");
 					profiler.begin(glfwGetTime());
 					if (demos.needsReload()) {
-						if (ecs.mRegistry.storage<AsyncJobComponent>().empty()) {
+						// The old demo's loads write into its ECS -- stop them early rather than waiting them out
+						AsyncJobs::cancelAll();
+						if (AsyncJobs::empty()) {
 							_swapDemo(demos, ecs, resourceManagers);
+							renderECS._clean();
+							renderECSValid = false;
 						}
 						else {
 							NEO_LOG_V("Waiting for async jobs to complete...");
@@ -136,22 +247,30 @@ namespace neo {
 					_startFrame(profiler, ecs, resourceManagers);
 					Messenger::relayMessages(ecs);
 
-					/* Destroy and create objects and components */
-					ecs._flush();
-					Messenger::relayMessages(ecs);
-
-					{
-						TRACY_ZONEN("Demo::update");
-						demos.getCurrentDemo()->update(ecs, resourceManagers);
+					pipelined = mPipelined && mPipelineSupported && renderECSValid && !mWindow.isMinimized();
+					if (pipelined) {
+						// Uploads land before the simulation starts so it never sees the managers mid-tick
+						StreamingBuffer::beginFrame();
+						resourceManagers._tick();
+						simulationThread.kick([&]() { simulate(false); });
+						{
+							TRACY_GPUN("Frame Render");
+							ServiceLocator<Renderer>::ref().render(mWindow, demos.getCurrentDemo(), profiler, renderECS, resourceManagers);
+						}
+						StreamingBuffer::endFrame();
+						simulationThread.wait();
+						// Before ImGui gets a chance to invalidate anything the renderer just cached
+						ecs._writeBack(renderECS);
+						Messenger::relayMessages(ecs);
+					}
+					else {
+						simulate(true);
 					}
-
-					/* Update each system */
-					ecs._updateSystems(resourceManagers);
-					Messenger::relayMessages(ecs);
 
 					/* Update imgui functions */
 					if (!mWindow.isMinimized() && ServiceLocator<ImGuiManager>::ref().isEnabled()) {
 						TRACY_ZONEN("ImGui");
+						NEO_MEMORY_TAG(ImGui);
 						ServiceLocator<ImGuiManager>::ref().begin();
 
 						{
@@ -167,12 +286,19 @@ namespace neo {
 							// TODO - move to its own function hehe
 							TRACY_ZONEN("Engine ImGui");
 							ImGui::Begin("Engine");
+							if (mPipelineSupported) {
+								ImGui::Checkbox("Pipelined", &mPipelined);
+							}
+							if (ImGui::TreeNodeEx("Frame Pacing", ImGuiTreeNodeFlags_DefaultOpen)) {
+								mFramePacer.imGuiEditor();
+								ImGui::TreePop();
+							}
+							if (ImGui::TreeNodeEx("Frame Arenas")) {
+								util::FrameArena::imGuiEditor();
+								ImGui::TreePop();
+							}
 							if (ImGui::TreeNodeEx("Async Jobs", ImGuiTreeNodeFlags_DefaultOpen)) {
-								glm::vec3 warningColor = util::sLogSeverityData.at(util::LogSeverity::Warning).second;
-								ImVec4 imguiColor(warningColor.x, warningColor.y, warningColor.z, 1.f);
-								for (auto&& [_, __, tag] : ecs.getView<AsyncJobComponent, TagComponent>().each()) {
-									ImGui::TextColored(imguiColor, "%s", tag.mTag.c_str());
-								}
+								AsyncJobs::imGuiEditor();
 								ImGui::TreePop();
 							}
 							if (auto hardwareDetails = ecs.getSingleView<MouseComponent, ViewportDetailsComponent>()) {
@@ -211,18 +337,39 @@ namespace neo {
 						}
 						Messenger::relayMessages(ecs);
 					}
-					{
+					if (!pipelined) {
+						// Mesh transactions stream into persistently mapped buffers -- fence them along with the frame's draws
+						StreamingBuffer::beginFrame();
 						resourceManagers._tick();
 						ServiceLocator<Renderer>::ref().render(mWindow, demos.getCurrentDemo(), profiler, ecs, resourceManagers);
+						StreamingBuffer::endFrame();
 						Messenger::relayMessages(ecs);
 					}
 				}
 
 				_endFrame(profiler, ecs);
 				Messenger::relayMessages(ecs);
+
+				// Give the new demo a few frames to draw everything and finish its async loads
+				if (mFramesUntilSweep > 0 && --mFramesUntilSweep == 0) {
+					if (AsyncJobs::empty()) {
+						_sweepResources(ecs, resourceManagers);
+					}
+					else {
+						mFramesUntilSweep = 1;
+					}
+				}
+
+				// Render extraction -- this frame gets drawn while the next one simulates
+				renderECSValid = mPipelined;
+				if (mPipelined) {
+					ecs._snapshot(renderECS);
+				}
 			}
 
 			mWindow.flip();
+			mFramePacer.endFrame(pipelined ? renderedInputTime : simulatedInputTime);
+			mFramePacer.limit();
 			TracyGpuCollect;
 			FrameMark;
 			profiler.end(glfwGetTime());
@@ -238,7 +385,9 @@ namespace neo {
 		/* Destry the old state*/
 		demos.getCurrentDemo()->destroy();
 		ecs._clean();
-		resourceManagers._clear();
+		// Warm swap -- anything the new demo loads or uses is kept, the rest is swept a few frames in
+		resourceManagers._beginSwap();
+		mFramesUntilSweep = 3;
 		ServiceLocator<Renderer>::ref().clean();
 		Messenger::clean();
 
@@ -246,6 +395,8 @@ namespace neo {
 		ServiceLocator<ImGuiManager>::ref().reset();
 		demos.swap();
 		auto config = demos.getConfig();
+		mPipelineSupported = config.pipelined;
+		mPipelined = config.pipelined;
 		mWindow.reset(config.name);
 		mMouse.init();
 		mKeyboard.init();
@@ -256,7 +407,10 @@ namespace neo {
 		ServiceLocator<ImGuiManager>::ref().reload(resourceManagers);
 		resourceManagers._tick();
 
-		demos.getCurrentDemo()->init(ecs, resourceManagers);
+		{
+			NEO_MEMORY_TAG(Demo);
+			demos.getCurrentDemo()->init(ecs, resourceManagers);
+		}
 
 		/* Init systems */
 		ecs._initSystems();
@@ -268,14 +422,10 @@ namespace neo {
 
 	void Engine::_createPrefabs(ResourceManagers& resourceManagers) {
 		/* Generate basic meshes */
+		// Prefabs outlive every demo swap
 		auto loadMesh = [&](HashedString name, MeshLoadDetails& details) {
-			auto id = resourceManagers.mMeshManager.asyncLoad(name, details);
-			for (auto&& [type, buffer] : details.mVertexBuffers) {
-				delete[] buffer.mData;
-			}
-			if (details.mElementBuffer) {
-				delete[] details.mElementBuffer->mData;
-			}
+			auto id = resourceManagers.mMeshManager.asyncLoad(name, std::move(details));
+			resourceManagers.mMeshManager.retain(id);
 			return id;
 		};
 		loadMesh("cube", *prefabs::generateCube());
@@ -293,25 +443,76 @@ namespace neo {
 		{
 			builder.mData = data;
 			auto id = resourceManagers.mTextureManager.asyncLoad(HashedString("black"), builder);
-			NEO_UNUSED(id);
+			resourceManagers.mTextureManager.retain(id);
 		}
 		{
 			data[0] = data[1] = data[2] = 0xFF;
 			builder.mData = data;
 			auto id = resourceManagers.mTextureManager.asyncLoad(HashedString("white"), builder);
-			NEO_UNUSED(id);
+			resourceManagers.mTextureManager.retain(id);
 		}
 	}
 
+	void Engine::_sweepResources(ECS& ecs, ResourceManagers& resourceManagers) {
+		TRACY_ZONE();
+		// Components can hold handles that haven't been drawn yet -- culled, or waiting on a system
+		const MeshManager& meshManager = resourceManagers.mMeshManager;
+		const TextureManager& textureManager = resourceManagers.mTextureManager;
+		for (auto&& [_, mesh] : ecs.getView<MeshComponent>().each()) {
+			meshManager.mark(mesh.mMeshHandle);
+		}
+		for (auto&& [_, line] : ecs.getView<LineMeshComponent>().each()) {
+			meshManager.mark(line.mMeshHandle);
+		}
+		for (auto&& [_, lods] : ecs.getView<MeshLODComponent>().each()) {
+			for (auto& lod : lods.mLODs) {
+				meshManager.mark(lod.mMeshHandle);
+			}
+		}
+		for (auto&& [_, material] : ecs.getView<MaterialComponent>().each()) {
+			textureManager.mark(material.mAlbedoMap);
+			textureManager.mark(material.mMetallicRoughnessMap);
+			textureManager.mark(material.mEmissiveMap);
+			textureManager.mark(material.mNormalMap);
+			textureManager.mark(material.mOcclusionMap);
+		}
+		for (auto&& [_, skybox] : ecs.getView<SkyboxComponent>().each()) {
+			textureManager.mark(skybox.mSkybox);
+		}
+		for (auto&& [_, ibl] : ecs.getView<IBLComponent>().each()) {
+			textureManager.mark(ibl.mConvolvedSkybox);
+			textureManager.mark(ibl.mDFGLut);
+		}
+		for (auto&& [_, shadowMap] : ecs.getView<PointLightShadowMapComponent>().each()) {
+			textureManager.mark(shadowMap.mShadowMap);
+		}
+		for (auto&& [_, shadowMap] : ecs.getView<CSMShadowMapComponent>().each()) {
+			textureManager.mark(shadowMap.mShadowMap);
+		}
+		for (auto&& [_, shadowCache] : ecs.getView<ShadowCacheComponent>().each()) {
+			textureManager.mark(shadowCache.mStaticShadowMap);
+		}
+		for (auto&& [_, draw] : ecs.getView<ImGuiDrawComponent>().each()) {
+			meshManager.mark(draw.mMeshHandle);
+			textureManager.mark(draw.mTextureHandle);
+		}
+		resourceManagers._sweep();
+	}
+
 	void Engine::shutDown(ECS& ecs, ResourceManagers& resourceManagers) {
 		NEO_LOG_I("Shutting down...");
+		// Jobs hold on to the ECS and resource managers
+		AsyncJobs::cancelAll();
+		AsyncJobs::waitAll();
 		ecs._clean();
 		Messenger::clean();
 		resourceManagers._clear();
 		ServiceLocator<Renderer>::ref().clean();
 		ServiceLocator<Renderer>::reset();
 		ServiceLocator<ImGuiManager>::ref().destroy();
+		mFramePacer.destroy();
 		mWindow.shutDown();
+		util::flushLog();
 	}
 
 	void Engine::_startFrame(util::Profiler& profiler, ECS& ecs, ResourceManagers& resourceManagers) {
@@ -337,7 +538,7 @@ namespace neo {
 				.attachComponent<MouseComponent>(mMouse)
 				.attachComponent<KeyboardComponent>(mKeyboard)
 				.attachComponent<ViewportDetailsComponent>(viewportSize, viewportPosition)
-				.attachComponent<FrameStatsComponent>(static_cast<float>(profiler.getRunTime()), static_cast<float>(profiler.getDeltaTime()))
+				.attachComponent<FrameStatsComponent>(static_cast<float>(profiler.getRunTime()), static_cast<float>(profiler.getDeltaTime()), static_cast<float>(mFramePacer.getLatency()))
 				.attachComponent<SingleFrameComponent>()
 			));
 		}
@@ -409,23 +610,16 @@ namespace neo {
 			ecs.removeEntity(entity);
 		}
 
-		for (auto&& [removeEntity, removeJob] : ecs.getView<RemoveAsyncJobComponent>().each()) {
-			bool jobFound = false;
-			for (auto&& [jobEntity, job] : ecs.getView<AsyncJobComponent>().each()) {
-				if (removeJob.mPid == job.mPid) {
-					ecs.removeEntity(removeEntity);
-					ecs.removeEntity(jobEntity);
-					jobFound = true;
-					break;
-				}
-			}
-			NEO_ASSERT(jobFound, "Trying to remove a non-existant async job?");
-		}
+		AsyncJobs::tick();
 
 		// Update display, mouse, keyboard 
 		// Do it here so it coincides w/ vsync instead of stalling engine tick
+		mInputTime = glfwGetTime();
 		mWindow.updateHardware();
 
+		// Everything allocated out of the frame arenas is dead now
+		util::FrameArena::endFrame();
+
 		profiler.markFrame(glfwGetTime());
 	}
 }
@@ -13,6 +13,8 @@
 #include "Hardware/Keyboard.hpp"
 #include "Hardware/Mouse.hpp"
 
+#include "FramePacer.hpp"
+
 namespace neo {
 	namespace util {
 		struct FrameCounter;
@@ -40,12 +42,24 @@ namespace neo {
 
 			void _createPrefabs(ResourceManagers& resourceManagers);
 			void _swapDemo(DemoWrangler& demoWranger, ECS& ecs, ResourceManagers& resourceManagers);
+			void _sweepResources(ECS& ecs, ResourceManagers& resourceManagers);
 
 			/* Hardware */
 			WindowSurface mWindow;
 			Keyboard mKeyboard;
 			Mouse mMouse;
 
+			/* Resources the new demo didn't pick back up are swept once it settles */
+			int mFramesUntilSweep = 0;
+
+			/* Frame pacing */
+			FramePacer mFramePacer;
+			double mInputTime = 0.0;
+
+			/* Render from a snapshot of last frame while the next one simulates */
+			bool mPipelined = false;
+			bool mPipelineSupported = false; // Only demos that opt in through their config can be pipelined
+
 			/* Debug */
 			bool mShowBoundingBoxes = false;
 			MouseRaySystem mMouseRaySystem;
@@ -0,0 +1,83 @@
+#include "FramePacer.hpp"
+
+#include "Util/Profiler.hpp"
+#include "Util/Util.hpp"
+
+#include <ext/imgui_incl.hpp>
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace neo {
+
+	namespace {
+		// OS sleeps overshoot -- stop sleeping this early and spin the rest
+		constexpr std::chrono::microseconds sSpinMargin(2000);
+	}
+
+	void FramePacer::endFrame(double inputTime) {
+		TRACY_ZONE();
+		mFrames.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), inputTime });
+
+		// Harvest whatever's already done so latency is reported as early as possible
+		while (!mFrames.empty() && _retire(mFrames.front(), 0)) {
+			mFrames.pop_front();
+		}
+
+		const size_t framesInFlight = static_cast<size_t>(std::clamp(mFramesInFlight, 1, sMaxFramesInFlight));
+		while (mFrames.size() > framesInFlight) {
+			TRACY_ZONEN("Wait for GPU");
+			// Don't hang forever on a lost context
+			if (!_retire(mFrames.front(), 1000000000ull)) {
+				NEO_LOG_W("Frame fence timed out");
+				glDeleteSync(mFrames.front().mFence);
+			}
+			mFrames.pop_front();
+		}
+	}
+
+	void FramePacer::limit() {
+		using namespace std::chrono;
+		if (mTargetFPS > 0) {
+			TRACY_ZONEN("Frame Limiter");
+			const steady_clock::time_point target = mLastFrameEnd + duration_cast<steady_clock::duration>(duration<double>(1.0 / mTargetFPS));
+			const steady_clock::time_point now = steady_clock::now();
+			if (target - now > sSpinMargin) {
+				std::this_thread::sleep_for(target - now - sSpinMargin);
+			}
+			while (steady_clock::now() < target) {
+				std::this_thread::yield();
+			}
+			// Missed frames don't get made up for with a burst
+			mLastFrameEnd = std::max(target, now);
+		}
+		else {
+			mLastFrameEnd = steady_clock::now();
+		}
+	}
+
+	void FramePacer::destroy() {
+		for (auto& frame : mFrames) {
+			glDeleteSync(frame.mFence);
+		}
+		mFrames.clear();
+	}
+
+	void FramePacer::imGuiEditor() {
+		ImGui::SliderInt("Frames in flight", &mFramesInFlight, 1, sMaxFramesInFlight);
+		ImGui::SliderInt("FPS cap", &mTargetFPS, 0, 240, mTargetFPS ? "%d" : "Uncapped");
+		ImGui::Text("Input latency: %0.2fms", mLatency * 1000.0);
+	}
+
+	bool FramePacer::_retire(Frame& frame, uint64_t timeout) {
+		GLenum result = glClientWaitSync(frame.mFence, timeout ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+		if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+			return false;
+		}
+		mLatency = glfwGetTime() - frame.mInputTime;
+		glDeleteSync(frame.mFence);
+		return true;
+	}
+}
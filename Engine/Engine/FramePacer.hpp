@@ -0,0 +1,45 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <deque>
+
+namespace neo {
+
+	// Caps how far the CPU can run ahead of the GPU and optionally limits the frame rate.
+	// Every frame is fenced once it's flipped -- the fence landing stands in for the frame being presented
+	class FramePacer {
+	public:
+		static constexpr int sMaxFramesInFlight = 3;
+
+		FramePacer() = default;
+		~FramePacer() = default;
+		FramePacer(const FramePacer&) = delete;
+		FramePacer& operator=(const FramePacer&) = delete;
+
+		// Call right after flip. inputTime is when the input that fed the flipped frame was polled
+		void endFrame(double inputTime);
+		// Sleeps, then spins out the rest of the target frame time
+		void limit();
+		void destroy();
+		void imGuiEditor();
+
+		// Input to present, in seconds, of the most recently completed frame
+		double getLatency() const { return mLatency; }
+
+		int mFramesInFlight = 2;
+		int mTargetFPS = 0; // 0 is uncapped
+
+	private:
+		struct Frame {
+			GLsync mFence = nullptr;
+			double mInputTime = 0.0;
+		};
+		std::deque<Frame> mFrames;
+		std::chrono::steady_clock::time_point mLastFrameEnd = std::chrono::steady_clock::now();
+		double mLatency = 0.0;
+
+		bool _retire(Frame& frame, uint64_t timeout);
+	};
+}
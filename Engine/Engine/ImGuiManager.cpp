@@ -14,6 +14,7 @@
 #include "Util/Util.hpp"
 #include "Util/Profiler.hpp"
 #include "Util/Log/Log.hpp"
+#include "Util/MemoryTracker.hpp"
 #include "Util/ServiceLocator.hpp"
 
 #include <GLFW/glfw3.h>
@@ -36,6 +37,7 @@ namespace neo {
 		ImPlot::CreateContext();
 		ImGuizmo::Enable(true);
 		ImGuizmo::SetOrthographic(false);
+		util::setLogConsole(&mConsole);
 		ImGuiIO& io = ImGui::GetIO();
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 		io.FontGlobalScale = dpiScale;
@@ -110,6 +112,7 @@ namespace neo {
 	void ImGuiManager::update() {
 		NEO_ASSERT(mIsEnabled, "ImGui is disabled");
 		TRACY_ZONE();
+		NEO_MEMORY_TAG(ImGui);
 
 		{
 			TRACY_ZONEN("ImGui_ImplGlfw_NewFrame");
@@ -243,37 +246,15 @@ namespace neo {
 		for (int i = 0; i < MAX_IMGUI_MESHES; i++) {
 			MeshLoadDetails loadDetails;
 			loadDetails.mPrimtive = types::mesh::Primitive::Triangles;
-			loadDetails.mVertexBuffers[types::mesh::VertexType::Position] = MeshLoadDetails::VertexBuffer{
-				2,
-				sizeof(ImDrawVert),
-				types::ByteFormats::Float,
-				false,
-				0,
-				offsetof(ImDrawVert, ImDrawVert::pos),
-				0,
-				nullptr
-			};
+			MeshLoadDetails::InterleavedBuffer vertexBuffer;
+			vertexBuffer.mStride = sizeof(ImDrawVert);
+			vertexBuffer.mCount = 0;
+			vertexBuffer.mByteSize = 0;
+			vertexBuffer.mAttributes[types::mesh::VertexType::Position] = { 2, types::ByteFormats::Float, false, offsetof(ImDrawVert, ImDrawVert::pos) };
 			// HEHEHE STORE COLOR IN NORMAL HEHEHE
-			loadDetails.mVertexBuffers[types::mesh::VertexType::Normal] = MeshLoadDetails::VertexBuffer{
-				4,
-				sizeof(ImDrawVert),
-				types::ByteFormats::UnsignedByte,
-				true,
-				0,
-				offsetof(ImDrawVert, ImDrawVert::col),
-				0,
-				nullptr
-			};
-			loadDetails.mVertexBuffers[types::mesh::VertexType::Texture0] = MeshLoadDetails::VertexBuffer{
-				2,
-				sizeof(ImDrawVert),
-				types::ByteFormats::Float,
-				false,
-				0,
-				offsetof(ImDrawVert, ImDrawVert::uv),
-				0,
-				nullptr
-			};
+			vertexBuffer.mAttributes[types::mesh::VertexType::Normal] = { 4, types::ByteFormats::UnsignedByte, true, offsetof(ImDrawVert, ImDrawVert::col) };
+			vertexBuffer.mAttributes[types::mesh::VertexType::Texture0] = { 2, types::ByteFormats::Float, false, offsetof(ImDrawVert, ImDrawVert::uv) };
+			loadDetails.mInterleavedBuffer = vertexBuffer;
 			loadDetails.mElementBuffer = MeshLoadDetails::ElementBuffer{
 				0,
 				sizeof(ImDrawIdx) == 2 ? types::ByteFormats::UnsignedShort : types::ByteFormats::UnsignedInt,
@@ -288,6 +269,7 @@ namespace neo {
 
 	void ImGuiManager::resolveDrawData(ECS& ecs, ResourceManagers& resourceManagers) {
 		TRACY_ZONE();
+		NEO_MEMORY_TAG(ImGui);
 		ImGui::Render();
 
 		ImDrawData* drawData = ImGui::GetDrawData();
@@ -302,43 +284,27 @@ namespace neo {
 		uint32_t drawIndex = 0;
 		for (int i = 0; i < drawData->CmdListsCount; i++) {
 			NEO_ASSERT(i < MAX_IMGUI_MESHES, "ImGui is requesting too many meshes :(");
-			const MeshHandle currentMesh = mImGuiMeshes[mImGuiMeshesOffset];
+			const uint16_t slot = mImGuiMeshesOffset;
+			const MeshHandle currentMesh = mImGuiMeshes[slot];
 			mImGuiMeshesOffset = (mImGuiMeshesOffset + 1) % MAX_IMGUI_MESHES;
 
 			const ImDrawList* cmdList = drawData->CmdLists[i];
 			{
-				std::vector<ImDrawVert> vertices;
-				vertices.resize(cmdList->VtxBuffer.Size);
-				memcpy(vertices.data(), cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size * sizeof(ImDrawVert));
-				std::vector<ImDrawIdx> elements;
-				elements.resize(cmdList->IdxBuffer.Size);
-				memcpy(elements.data(), cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+				// The transaction runs on the next tick, after the frame arena has been rewound, so these can't come out of it.
+				// Each mesh has its own buffers instead, which stop allocating once they've grown to fit
+				mImGuiVertices[slot].assign(cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Data + cmdList->VtxBuffer.Size);
+				mImGuiElements[slot].assign(cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Data + cmdList->IdxBuffer.Size);
 
 				resourceManagers.mMeshManager.transact(currentMesh,
-					[vertices = std::move(vertices),
-					elements = std::move(elements)]
-					(Mesh& mesh) {
-						// Duping the vertex buffer 3x because they need to be indexed separately :(
-						mesh.updateVertexBuffer(
-							types::mesh::VertexType::Position,
+					[this, slot](Mesh& mesh) {
+						const std::vector<ImDrawVert>& vertices = mImGuiVertices[slot];
+						const std::vector<ImDrawIdx>& elements = mImGuiElements[slot];
+						mesh.streamInterleavedBuffer(
 							static_cast<uint32_t>(vertices.size()),
 							static_cast<uint32_t>(vertices.size() * sizeof(ImDrawVert)),
 							reinterpret_cast<const uint8_t*>(vertices.data())
 						);
-						mesh.updateVertexBuffer(
-							types::mesh::VertexType::Texture0,
-							static_cast<uint32_t>(vertices.size()),
-							static_cast<uint32_t>(vertices.size() * sizeof(ImDrawVert)),
-							reinterpret_cast<const uint8_t*>(vertices.data())
-						);
-						mesh.updateVertexBuffer(
-							types::mesh::VertexType::Normal,
-							static_cast<uint32_t>(vertices.size()),
-							static_cast<uint32_t>(vertices.size() * sizeof(ImDrawVert)),
-							reinterpret_cast<const uint8_t*>(vertices.data())
-						);
-						mesh.removeElementBuffer();
-						mesh.addElementBuffer(
+						mesh.streamElementBuffer(
 							static_cast<uint32_t>(elements.size()),
 							sizeof(ImDrawIdx) == 2 ? types::ByteFormats::UnsignedShort : types::ByteFormats::UnsignedInt,
 							static_cast<uint32_t>(elements.size() * sizeof(ImDrawIdx)),
@@ -351,10 +317,8 @@ namespace neo {
 			for (int cmd_i = 0; cmd_i < cmdList->CmdBuffer.Size; cmd_i++) {
 				const ImDrawCmd* cmd = &cmdList->CmdBuffer[cmd_i];
 				if (cmd->UserCallback != nullptr) {
-					if (cmd->UserCallback == ImDrawCallback_ResetRenderState) {
-						NEO_LOG_W("Reset the render state wahoo");
-					}
-					else {
+					// Every draw sets its own render state, so there's nothing to reset
+					if (cmd->UserCallback != ImDrawCallback_ResetRenderState) {
 						NEO_LOG_W("Callback function!?");
 						cmd->UserCallback(cmdList, cmd);
 					}
@@ -427,16 +391,12 @@ namespace neo {
 	}
 
 	void ImGuiManager::destroy() {
+		util::setLogConsole(nullptr);
 		ImGui_ImplGlfw_Shutdown();
 		ImPlot::DestroyContext();
 		ImGui::DestroyContext();
 	}
 
-	void ImGuiManager::log(const char* log, util::LogSeverity severity) {
-		NEO_UNUSED(log, severity);
-		mConsole.addLog(log, severity);
-	}
-
 	void ImGuiManager::imGuiEditor() {
 		TRACY_ZONE();
 		mConsole.imGuiEditor();
@@ -42,7 +42,6 @@ namespace neo {
 		void begin();
 		void end();
 
-		void log(const char* log, util::LogSeverity severity);
 		void imGuiEditor();
 
 		void updateMouse(GLFWwindow* window, int button, int action, int mods);
@@ -65,5 +64,8 @@ namespace neo {
 		
 		std::array<MeshHandle, MAX_IMGUI_MESHES> mImGuiMeshes;
 		uint16_t mImGuiMeshesOffset = 0;
+		// What each mesh gets streamed from on the next tick. Kept around so their capacity gets reused frame to frame
+		std::array<std::vector<ImDrawVert>, MAX_IMGUI_MESHES> mImGuiVertices;
+		std::array<std::vector<ImDrawIdx>, MAX_IMGUI_MESHES> mImGuiElements;
 	};
 }
\ No newline at end of file
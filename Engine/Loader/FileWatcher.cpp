@@ -0,0 +1,163 @@
+#include "Loader/pch.hpp"
+#include "FileWatcher.hpp"
+
+#include "Loader.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace neo {
+
+	FileWatcher::FileWatcher() {
+#ifdef __linux__
+		mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (mInotify < 0) {
+			NEO_LOG_W("inotify unavailable -- falling back to polling");
+		}
+#endif
+	}
+
+	FileWatcher::~FileWatcher() {
+#ifdef _WIN32
+		for (auto&& [path, directory] : mDirectories) {
+			if (directory.mHandle) {
+				FindCloseChangeNotification(directory.mHandle);
+			}
+		}
+#elif defined(__linux__)
+		if (mInotify >= 0) {
+			close(mInotify);
+		}
+#endif
+	}
+
+	void FileWatcher::watch(const std::string& fileName) {
+		if (!mWatched.insert(fileName).second) {
+			return;
+		}
+		auto resolved = Loader::resolveFile(fileName);
+		if (!resolved || resolved->isPacked()) {
+			return;
+		}
+
+		const std::string::size_type split = resolved->mPath.find_last_of("/\\");
+		const std::string path = split == std::string::npos ? "./" : resolved->mPath.substr(0, split + 1);
+		const std::string name = resolved->mPath.substr(split + 1);
+
+		auto [directory, inserted] = mDirectories.try_emplace(path);
+		directory->second.mFiles[name].push_back({ fileName, util::getFileModTime(resolved->mPath.c_str()) });
+		if (!inserted) {
+			return;
+		}
+
+#ifdef _WIN32
+		HANDLE handle = FindFirstChangeNotificationA(path.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		if (handle != INVALID_HANDLE_VALUE) {
+			directory->second.mHandle = handle;
+		}
+#elif defined(__linux__)
+		if (mInotify >= 0) {
+			// Editors that save through a temp file show up as a move
+			int descriptor = inotify_add_watch(mInotify, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+			if (descriptor >= 0) {
+				mWatchDescriptors[descriptor] = path;
+			}
+		}
+#endif
+	}
+
+	std::vector<std::string> FileWatcher::poll(std::chrono::milliseconds timeout) {
+		std::vector<std::string> changed;
+		if (mDirectories.empty()) {
+			std::this_thread::sleep_for(timeout);
+			return changed;
+		}
+
+#ifdef _WIN32
+		std::vector<HANDLE> handles;
+		std::vector<std::pair<const std::string*, WatchedDirectory*>> signaled;
+		for (auto&& [path, directory] : mDirectories) {
+			if (directory.mHandle) {
+				handles.push_back(directory.mHandle);
+				signaled.emplace_back(&path, &directory);
+			}
+		}
+		if (handles.size() == mDirectories.size() && handles.size() <= MAXIMUM_WAIT_OBJECTS) {
+			DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, static_cast<DWORD>(timeout.count()));
+			if (result == WAIT_TIMEOUT || result == WAIT_FAILED) {
+				return changed;
+			}
+			TRACY_ZONEN("Directory changed");
+			// Only look inside directories that were actually touched
+			for (size_t i = 0; i < handles.size(); i++) {
+				if (WaitForSingleObject(handles[i], 0) == WAIT_OBJECT_0) {
+					_checkModTimes(*signaled[i].second, *signaled[i].first, changed);
+					FindNextChangeNotification(handles[i]);
+				}
+			}
+			return changed;
+		}
+#elif defined(__linux__)
+		if (mInotify >= 0) {
+			pollfd descriptor = { mInotify, POLLIN, 0 };
+			if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) {
+				return changed;
+			}
+			TRACY_ZONEN("Directory changed");
+			alignas(inotify_event) char buffer[4096];
+			ssize_t length;
+			while ((length = read(mInotify, buffer, sizeof(buffer))) > 0) {
+				for (char* cursor = buffer; cursor < buffer + length; cursor += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(cursor)->len) {
+					const inotify_event* event = reinterpret_cast<inotify_event*>(cursor);
+					auto path = mWatchDescriptors.find(event->wd);
+					if (event->len == 0 || path == mWatchDescriptors.end()) {
+						continue;
+					}
+					auto& files = mDirectories[path->second].mFiles;
+					auto file = files.find(event->name);
+					if (file != files.end()) {
+						for (auto& watched : file->second) {
+							if (std::find(changed.begin(), changed.end(), watched.mFileName) == changed.end()) {
+								changed.push_back(watched.mFileName);
+							}
+						}
+					}
+				}
+			}
+			return changed;
+		}
+#endif
+
+		// No notifications -- stat everything
+		std::this_thread::sleep_for(timeout);
+		TRACY_ZONEN("Poll mod times");
+		for (auto&& [path, directory] : mDirectories) {
+			_checkModTimes(directory, path, changed);
+		}
+		return changed;
+	}
+
+	void FileWatcher::_checkModTimes(WatchedDirectory& directory, const std::string& path, std::vector<std::string>& changed) {
+		for (auto&& [name, files] : directory.mFiles) {
+			const time_t modTime = util::getFileModTime((path + name).c_str());
+			for (auto& watched : files) {
+				if (modTime > watched.mModTime) {
+					watched.mModTime = modTime;
+					changed.push_back(watched.mFileName);
+				}
+			}
+		}
+	}
+}
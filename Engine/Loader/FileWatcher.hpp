@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace neo {
+
+	// Reports writes to watched files. Uses inotify on Linux and directory change notifications on Windows,
+	// so nothing is stat'd until a directory actually changes. Anything else falls back to polling mod times
+	// Not thread safe -- meant to live on a single watcher thread
+	class FileWatcher {
+	public:
+		FileWatcher();
+		~FileWatcher();
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		// Loader file name. Files inside packs can't change, so they're ignored
+		void watch(const std::string& fileName);
+		// Blocks for up to timeout. Returns the watched file names that were written to
+		std::vector<std::string> poll(std::chrono::milliseconds timeout);
+
+	private:
+		struct WatchedFile {
+			std::string mFileName;
+			time_t mModTime = 0;
+		};
+		struct WatchedDirectory {
+			std::unordered_map<std::string, std::vector<WatchedFile>> mFiles; // Keyed on the file's name in this directory
+#ifdef _WIN32
+			void* mHandle = nullptr;
+#endif
+		};
+		std::unordered_map<std::string, WatchedDirectory> mDirectories;
+		std::unordered_set<std::string> mWatched;
+
+		void _checkModTimes(WatchedDirectory& directory, const std::string& path, std::vector<std::string>& changed);
+
+#ifdef __linux__
+		int mInotify = -1;
+		std::unordered_map<int, std::string> mWatchDescriptors;
+#endif
+	};
+}
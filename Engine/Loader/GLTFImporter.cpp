@@ -1,14 +1,17 @@
 #include "GLTFImporter.hpp"
+#include "MeshPacker.hpp"
+#include "MeshOptimizer.hpp"
 
 #include "Renderer/GLObjects/Mesh.hpp"
 #include "Renderer/GLObjects/Texture.hpp"
 
 #include "ECS/ECS.hpp"
-#include "ECS/Component/EngineComponents/AsyncJobComponent.hpp"
-#include "ECS/Component/EngineComponents/TagComponent.hpp"
 
 #include "ResourceManager/ResourceManagers.hpp"
 
+#include "Util/AsyncJobs.hpp"
+#include "Util/MemoryTracker.hpp"
+
 #pragma warning(push)
 #pragma warning(disable: 4201)
 #include <glm/gtc/quaternion.hpp>
@@ -79,6 +82,52 @@ namespace {
 		}
 	}
 
+	// The model's buffer and image bytes, moved out so they're each shared with the resource managers on their own.
+	// Whatever a mesh or texture references is freed once it's been uploaded, rather than the whole model waiting on the last one
+	struct ModelData {
+		std::vector<std::shared_ptr<std::vector<unsigned char>>> mBuffers;
+		std::vector<std::shared_ptr<std::vector<unsigned char>>> mImages;
+	};
+
+	template<typename T>
+	std::vector<T> _readFloatAccessor(const tinygltf::Model& model, const ModelData& modelData, const tinygltf::Accessor& accessor) {
+		NEO_ASSERT(tinygltf::GetNumComponentsInType(accessor.type) * sizeof(float) == sizeof(T), "Accessor doesn't match output type");
+		const auto& bufferView = model.bufferViews[accessor.bufferView];
+		const uint8_t* data = modelData.mBuffers[bufferView.buffer]->data() + bufferView.byteOffset + accessor.byteOffset;
+		const size_t stride = static_cast<size_t>(accessor.ByteStride(bufferView));
+
+		std::vector<T> out(accessor.count);
+		for (size_t i = 0; i < accessor.count; i++) {
+			memcpy(&out[i], data + i * stride, sizeof(T));
+		}
+		return out;
+	}
+
+	inline std::vector<uint32_t> _readIndices(const tinygltf::Model& model, const ModelData& modelData, const tinygltf::Accessor& accessor) {
+		const auto& bufferView = model.bufferViews[accessor.bufferView];
+		const uint8_t* data = modelData.mBuffers[bufferView.buffer]->data() + bufferView.byteOffset + accessor.byteOffset;
+		const size_t stride = static_cast<size_t>(accessor.ByteStride(bufferView));
+
+		std::vector<uint32_t> out(accessor.count);
+		for (size_t i = 0; i < accessor.count; i++) {
+			switch (accessor.componentType) {
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+				out[i] = data[i * stride];
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				out[i] = *reinterpret_cast<const uint16_t*>(data + i * stride);
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+				out[i] = *reinterpret_cast<const uint32_t*>(data + i * stride);
+				break;
+			default:
+				NEO_FAIL("Invalid index type: %d", accessor.componentType);
+				break;
+			}
+		}
+		return out;
+	}
+
 	inline neo::types::texture::InternalFormats _translateTinyGltfPixelType(int pixel_type, neo::types::texture::BaseFormats baseFormat) {
 		switch (pixel_type) {
 		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
@@ -226,7 +275,7 @@ namespace {
 		}
 	}
 
-	neo::TextureHandle _loadTexture(neo::TextureManager& textureManager, const char* path, const tinygltf::Model& model, int index, int texCoord) {
+	neo::TextureHandle _loadTexture(neo::TextureManager& textureManager, const char* path, const tinygltf::Model& model, const ModelData& modelData, int index, int texCoord) {
 		using namespace neo; 
 		TRACY_ZONE();
 
@@ -261,6 +310,7 @@ namespace {
 		builder.mFormat.mType = _getGLType(image.bits);
 		builder.mFormat.mInternalFormat = _translateTinyGltfPixelType(image.pixel_type, _getGLBaseFormat(image.component));
 		builder.mFormat.mMipCount = 6; // Don't want to risk blowing up vram?
+		builder.mStreamed = true;
 		if (texture.sampler > -1) {
 			const auto& sampler = model.samplers[texture.sampler];
 			if (sampler.minFilter > -1) {
@@ -280,8 +330,9 @@ namespace {
 
 		builder.mDimensions.x = static_cast<uint16_t>(image.width);
 		builder.mDimensions.y = static_cast<uint16_t>(image.height);
-		builder.mData = const_cast<uint8_t*>(image.image.data());
-		return textureManager.asyncLoad(textureHandle, builder, !texture.name.empty() ? texture.name : handleName);
+		const auto& pixels = modelData.mImages[texture.source];
+		builder.setData(pixels->data(), pixels);
+		return textureManager.asyncLoad(textureHandle, std::move(builder), !texture.name.empty() ? texture.name : handleName);
 	}
 
 	neo::SpatialComponent _processSpatial(const tinygltf::Node& node, glm::mat4 parentXform) {
@@ -344,7 +395,7 @@ namespace {
 		};
 	}
 
-	std::vector<neo::GLTFImporter::MeshNode> _processMeshNode(const char* path, const int nodeID, neo::ResourceManagers& resourceManagers, const tinygltf::Model& model, const tinygltf::Node& node, const neo::SpatialComponent& nodeSpatial) {
+	std::vector<neo::GLTFImporter::MeshNode> _processMeshNode(const char* path, const int nodeID, neo::ResourceManagers& resourceManagers, const tinygltf::Model& model, const ModelData& modelData, const tinygltf::Node& node, const neo::SpatialComponent& nodeSpatial, const neo::GLTFImporter::ImportOptions& options) {
 		using namespace neo;
 		TRACY_ZONE();
 
@@ -363,6 +414,20 @@ namespace {
 			MeshLoadDetails builder;
 			builder.mPrimtive = _translateTinyGltfPrimitiveType(gltfMesh.mode);
 
+			// Float attributes get repacked into a single interleaved + quantized buffer. Anything else is uploaded as-is
+			std::optional<MeshPacker::MeshVertexData> vertexData;
+			{
+				bool packable = true;
+				for (const auto& attribute : gltfMesh.attributes) {
+					const auto& accessor = model.accessors[attribute.second];
+					packable &= accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT && !accessor.normalized;
+				}
+				if (packable) {
+					vertexData.emplace();
+					vertexData->mPrimitive = builder.mPrimtive;
+				}
+			}
+
 			// Indices
 			if (gltfMesh.indices > -1)
 			{
@@ -372,15 +437,21 @@ namespace {
 				auto& bufferView = model.bufferViews[accessor.bufferView];
 				NEO_ASSERT(bufferView.target == TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER, "Indices bufferview isn't an index buffer?");
 
-				const auto& buffer = model.buffers[bufferView.buffer];
+				const auto& buffer = modelData.mBuffers[bufferView.buffer];
 
-				builder.mElementBuffer = {
-					static_cast<uint32_t>(accessor.count),
-					_translateTinyGltfComponentType(accessor.componentType),
-					static_cast<uint32_t>(bufferView.byteLength),
-					// TODO - this offset math might be bad
-					static_cast<const uint8_t*>(buffer.data.data()) + bufferView.byteOffset + accessor.byteOffset
-				};
+				if (vertexData) {
+					vertexData->mIndices = _readIndices(model, modelData, accessor);
+				}
+				else {
+					builder.mElementBuffer = {
+						static_cast<uint32_t>(accessor.count),
+						_translateTinyGltfComponentType(accessor.componentType),
+						static_cast<uint32_t>(bufferView.byteLength),
+						// TODO - this offset math might be bad
+						static_cast<const uint8_t*>(buffer->data()) + bufferView.byteOffset + accessor.byteOffset,
+						buffer
+					};
+				}
 			}
 
 			for (const auto& attribute : gltfMesh.attributes) {
@@ -410,10 +481,31 @@ namespace {
 					continue;
 				}
 
+				if (vertexData) {
+					switch (vertexType) {
+					case types::mesh::VertexType::Position:
+						vertexData->mPositions = _readFloatAccessor<glm::vec3>(model, modelData, accessor);
+						break;
+					case types::mesh::VertexType::Normal:
+						vertexData->mNormals = _readFloatAccessor<glm::vec3>(model, modelData, accessor);
+						break;
+					case types::mesh::VertexType::Texture0:
+						vertexData->mUVs = _readFloatAccessor<glm::vec2>(model, modelData, accessor);
+						break;
+					case types::mesh::VertexType::Tangent:
+						vertexData->mTangents = _readFloatAccessor<glm::vec4>(model, modelData, accessor);
+						break;
+					default:
+						break;
+					}
+					continue;
+				}
+
 				const auto& bufferView = model.bufferViews[accessor.bufferView];
-				const auto& buffer = model.buffers[bufferView.buffer];
+				const auto& buffer = modelData.mBuffers[bufferView.buffer];
 
 				// TODO : this is duplicating vertex data. Would be better to split glBufferData from glVertexAttribPointer
+				// The buffer is shared with the mesh manager rather than copied
 				builder.mVertexBuffers[vertexType] = {
 					static_cast<uint32_t>(tinygltf::GetNumComponentsInType(accessor.type)),
 					static_cast<uint32_t>(accessor.ByteStride(bufferView)),
@@ -422,7 +514,8 @@ namespace {
 					static_cast<uint32_t>(accessor.count),
 					static_cast<uint32_t>(accessor.byteOffset),
 					static_cast<uint32_t>(bufferView.byteLength),
-					static_cast<const uint8_t*>(buffer.data.data()) + bufferView.byteOffset
+					static_cast<const uint8_t*>(buffer->data()) + bufferView.byteOffset,
+					buffer
 				};
 			}
 
@@ -438,7 +531,50 @@ namespace {
 				name = ss.str();
 			}
 			NEO_LOG_I("Loaded mesh %s", name.c_str());
-			outNode.mMeshHandle = resourceManagers.mMeshManager.asyncLoad(HashedString(name.c_str()), builder);
+			if (vertexData) {
+				// Reordering triangles would change how blended meshes composite
+				const bool blended = gltfMesh.material > -1 && model.materials[gltfMesh.material].alphaMode == "BLEND";
+				if (options.mOptimize && !blended) {
+					MeshOptimizer::optimize(*vertexData, name.c_str());
+				}
+				auto packed = MeshPacker::pack(*vertexData, options.mQuantize);
+				packed->mDeduplicate = true;
+				outNode.mMeshHandle = resourceManagers.mMeshManager.asyncLoad(HashedString(name.c_str()), std::move(*packed));
+
+				if (options.mLODCount && !blended && vertexData->mPrimitive == types::mesh::Primitive::Triangles) {
+					// Simplification needs shared vertices to collapse
+					if (!options.mOptimize) {
+						MeshOptimizer::weldVertices(*vertexData);
+					}
+					outNode.mLODs.push_back({ outNode.mMeshHandle, 0.f });
+					size_t lastIndexCount = vertexData->mIndices.size();
+					for (int lod = 1; lod <= options.mLODCount; lod++) {
+						const uint32_t target = static_cast<uint32_t>(vertexData->mIndices.size() >> lod) / 3 * 3;
+						MeshPacker::MeshVertexData lodData = *vertexData;
+						float error = 0.f;
+						lodData.mIndices = MeshOptimizer::simplify(*vertexData, target, error);
+						if (lodData.mIndices.empty() || lodData.mIndices.size() >= lastIndexCount) {
+							break;
+						}
+						lastIndexCount = lodData.mIndices.size();
+						MeshOptimizer::optimizeVertexCache(lodData.mIndices, static_cast<uint32_t>(lodData.mPositions.size()));
+						MeshOptimizer::optimizeVertexFetch(lodData);
+
+						const std::string lodName = name + "_LOD" + std::to_string(lod);
+						NEO_LOG_V("Generated %s: %d triangles, error %0.4f", lodName.c_str(), static_cast<int>(lodData.mIndices.size() / 3), error);
+						auto packedLOD = MeshPacker::pack(lodData, options.mQuantize);
+						packedLOD->mDeduplicate = true;
+						outNode.mLODs.push_back({ resourceManagers.mMeshManager.asyncLoad(HashedString(lodName.c_str()), std::move(*packedLOD)), error });
+					}
+					if (outNode.mLODs.size() == 1) {
+						outNode.mLODs.clear();
+					}
+				}
+			}
+			else {
+				builder.mDeduplicate = true;
+				outNode.mMeshHandle = resourceManagers.mMeshManager.asyncLoad(HashedString(name.c_str()), std::move(builder));
+			}
 
 			if (gltfMesh.material > -1) {
 				auto& material = model.materials[gltfMesh.material];
@@ -465,16 +601,16 @@ namespace {
 					NEO_FAIL("Invalid alpha mode");
 				}
 
-				outNode.mMaterial.mNormalMap = _loadTexture(resourceManagers.mTextureManager, path, model, material.normalTexture.index, material.normalTexture.texCoord);
+				outNode.mMaterial.mNormalMap = _loadTexture(resourceManagers.mTextureManager, path, model, modelData, material.normalTexture.index, material.normalTexture.texCoord);
 				outNode.mMaterial.mNormalScale = static_cast<float>(material.normalTexture.scale);
 
-				outNode.mMaterial.mOcclusionMap = _loadTexture(resourceManagers.mTextureManager, path, model, material.occlusionTexture.index, material.occlusionTexture.texCoord);
+				outNode.mMaterial.mOcclusionMap = _loadTexture(resourceManagers.mTextureManager, path, model, modelData, material.occlusionTexture.index, material.occlusionTexture.texCoord);
 				outNode.mMaterial.mOcclusionStrength = static_cast<float>(material.occlusionTexture.strength);
 
 				if (material.emissiveFactor.size() == 3) {
 					outNode.mMaterial.mEmissiveFactor = glm::vec3(material.emissiveFactor[0], material.emissiveFactor[1], material.emissiveFactor[2]);
 				}
-				outNode.mMaterial.mEmissiveMap = _loadTexture(resourceManagers.mTextureManager, path, model, material.emissiveTexture.index, material.emissiveTexture.texCoord);
+				outNode.mMaterial.mEmissiveMap = _loadTexture(resourceManagers.mTextureManager, path, model, modelData, material.emissiveTexture.index, material.emissiveTexture.texCoord);
 
 				outNode.mMaterial.mMetallic = static_cast<float>(material.pbrMetallicRoughness.metallicFactor);
 				outNode.mMaterial.mRoughness = static_cast<float>(material.pbrMetallicRoughness.roughnessFactor);
@@ -486,8 +622,8 @@ namespace {
 						material.pbrMetallicRoughness.baseColorFactor[3]
 					);
 				}
-				outNode.mMaterial.mAlbedoMap = _loadTexture(resourceManagers.mTextureManager, path, model, material.pbrMetallicRoughness.baseColorTexture.index, material.pbrMetallicRoughness.baseColorTexture.texCoord);
-				outNode.mMaterial.mMetallicRoughnessMap = _loadTexture(resourceManagers.mTextureManager, path, model, material.pbrMetallicRoughness.metallicRoughnessTexture.index, material.pbrMetallicRoughness.metallicRoughnessTexture.texCoord);
+				outNode.mMaterial.mAlbedoMap = _loadTexture(resourceManagers.mTextureManager, path, model, modelData, material.pbrMetallicRoughness.baseColorTexture.index, material.pbrMetallicRoughness.baseColorTexture.texCoord);
+				outNode.mMaterial.mMetallicRoughnessMap = _loadTexture(resourceManagers.mTextureManager, path, model, modelData, material.pbrMetallicRoughness.metallicRoughnessTexture.index, material.pbrMetallicRoughness.metallicRoughnessTexture.texCoord);
 
 			}
 			outNodes.emplace_back(outNode);
@@ -496,20 +632,35 @@ namespace {
 		return outNodes;
 	}
 
+	uint32_t _countNodes(const tinygltf::Model& model, const int nodeID) {
+		uint32_t count = 1;
+		for (auto& child : model.nodes[nodeID].children) {
+			count += _countNodes(model, child);
+		}
+		return count;
+	}
+
+	// Advances the job once per node
 	void _processNode(
+		neo::AsyncJob& job,
 		const char* path, 
 		const int nodeID, 
 		neo::ResourceManagers& resourceManagers, 
 		const tinygltf::Model& model, 
+		const ModelData& modelData, 
 		const tinygltf::Node& node, 
 		glm::mat4 parentXform,
 		neo::ECS& ecs,
 		neo::GLTFImporter::MeshNodeOp meshNodeOperator,
-		neo::GLTFImporter::CameraNodeOp cameraNodeOperator
+		neo::GLTFImporter::CameraNodeOp cameraNodeOperator,
+		const neo::GLTFImporter::ImportOptions& options
 	) {
 
 		using namespace neo;
 		TRACY_ZONE();
+		if (job.isCancelled()) {
+			return;
+		}
 		if (!node.name.empty()) {
 			NEO_LOG_V("Processing node %s", node.name.c_str());
 		}
@@ -520,7 +671,10 @@ namespace {
 		SpatialComponent nodeSpatial = _processSpatial(node, parentXform);
 
 		for (auto& child : node.children) {
-			_processNode(path, child, resourceManagers, model, model.nodes[child], nodeSpatial.getModelMatrix(), ecs, meshNodeOperator, cameraNodeOperator);
+			_processNode(job, path, child, resourceManagers, model, modelData, model.nodes[child], nodeSpatial.getModelMatrix(), ecs, meshNodeOperator, cameraNodeOperator, options);
+		}
+		if (job.isCancelled()) {
+			return;
 		}
 
 		if (node.camera > -1) {
@@ -528,7 +682,10 @@ namespace {
 			cameraNodeOperator(ecs, _processCameraNode(model, node, nodeSpatial));
 		}
 		else if (node.mesh > -1) {
-			for (const GLTFImporter::MeshNode& mesh : _processMeshNode(path, nodeID, resourceManagers, model, node, nodeSpatial)) {
+			for (const GLTFImporter::MeshNode& mesh : _processMeshNode(path, nodeID, resourceManagers, model, modelData, node, nodeSpatial, options)) {
+				if (job.isCancelled()) {
+					return;
+				}
 				TRACY_ZONEN("MeshNodeOp");
 				meshNodeOperator(ecs, mesh);
 			}
@@ -539,41 +696,41 @@ namespace {
 				NEO_FAIL("Light with extensions");
 			}
 		}
+		job.advance();
 	}
 }
 
 namespace neo {
 	namespace GLTFImporter {
 
-		void loadScene(std::string _path, glm::mat4 baseTransform, ResourceManagers& resourceManagers, ECS& ecs, MeshNodeOp meshOperator, CameraNodeOp cameraOperator) {
+		void loadScene(std::string _path, FileView file, std::string baseDir, glm::mat4 baseTransform, ResourceManagers& resourceManagers, ECS& ecs, MeshNodeOp meshOperator, CameraNodeOp cameraOperator, const ImportOptions& options) {
 			std::string path = _path;
-			std::thread([path, baseTransform, &resourceManagers, &ecs, meshOperator, cameraOperator]() {
-				tracy::SetThreadName(path.c_str());
+			AsyncJobs::launch(path, [path, file, baseDir, baseTransform, &resourceManagers, &ecs, meshOperator, cameraOperator, options](AsyncJob& job) {
 				TRACY_ZONEN("GLTFImpoter::LoadScene");
-
-				{
-					AsyncJobComponent asyncJob(static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
-					ecs.submitEntity(std::move(ECS::EntityBuilder{}
-						.attachComponent<TagComponent>(path)
-						.attachComponent<AsyncJobComponent>(asyncJob)
-					));
-				}
+				NEO_MEMORY_TAG(Loader);
 
 				tinygltf::Model model;
 				tinygltf::TinyGLTF loader;
 				std::string err;
 				std::string warn;
 
+				// Parsing is a step of its own until we know how many nodes there are
+				job.setTotal(1);
+				if (job.isCancelled()) {
+					return;
+				}
+
 				bool ret = false;
 				stbi_set_flip_vertically_on_load_thread(false);
 				NEO_LOG_I("Loading gltf %s", path.c_str());
+				// Parse straight out of the mapped file
 				if (path.size() > 5 && path.find(".gltf", path.size() - 5) != std::string::npos) {
-					TRACY_ZONEN("LoadASCIIFromFile");
-					ret = loader.LoadASCIIFromFile(&model, &err, &warn, path.c_str());
+					TRACY_ZONEN("LoadASCIIFromString");
+					ret = loader.LoadASCIIFromString(&model, &err, &warn, file.asString().data(), static_cast<unsigned int>(file.size()), baseDir);
 				}
 				else if (path.size() > 4 && path.find(".glb", path.size() - 4) != std::string::npos) {
-					TRACY_ZONEN("LoadBinaryFromFile");
-					ret = loader.LoadBinaryFromFile(&model, &err, &warn, path.c_str());
+					TRACY_ZONEN("LoadBinaryFromMemory");
+					ret = loader.LoadBinaryFromMemory(&model, &err, &warn, file.data(), static_cast<unsigned int>(file.size()), baseDir);
 				}
 
 				if (!warn.empty()) {
@@ -587,6 +744,7 @@ namespace neo {
 				if (!ret) {
 					return;
 				}
+				job.advance();
 
 				// Translate tinygltf::Model to Loader::GltfScene
 				if (model.lights.size()) {
@@ -605,19 +763,34 @@ namespace neo {
 					NEO_FAIL("%s has required extensions", path.c_str());
 				}
 
-				for (const auto& nodeID : model.scenes[model.defaultScene].nodes) {
-					const auto& node = model.nodes[nodeID];
-					_processNode(path.c_str(), nodeID, resourceManagers, model, node, baseTransform, ecs, meshOperator, cameraOperator);
+				// Shared with the resource managers so they can upload straight out of the model's buffers and images
+				ModelData modelData;
+				modelData.mBuffers.reserve(model.buffers.size());
+				for (auto& buffer : model.buffers) {
+					modelData.mBuffers.emplace_back(std::make_shared<std::vector<unsigned char>>(std::move(buffer.data)));
+				}
+				modelData.mImages.reserve(model.images.size());
+				for (auto& image : model.images) {
+					modelData.mImages.emplace_back(std::make_shared<std::vector<unsigned char>>(std::move(image.image)));
 				}
 
-				RemoveAsyncJobComponent asyncJob(static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
-				ecs.submitEntity(std::move(ECS::EntityBuilder{}
-					.attachComponent<RemoveAsyncJobComponent>(asyncJob)
-				));
+				// Progress and cancellation go per node -- Sponza is all hanging off a single root
+				const auto& rootNodes = model.scenes[model.defaultScene].nodes;
+				uint32_t nodeCount = 0;
+				for (const auto& nodeID : rootNodes) {
+					nodeCount += _countNodes(model, nodeID);
+				}
+				job.setTotal(1 + nodeCount);
+				for (const auto& nodeID : rootNodes) {
+					const auto& node = model.nodes[nodeID];
+					_processNode(job, path.c_str(), nodeID, resourceManagers, model, modelData, node, baseTransform, ecs, meshOperator, cameraOperator, options);
+					if (job.isCancelled()) {
+						return;
+					}
+				}
 
 				NEO_LOG_I("Successfully imported %s", path.c_str());
-			})
-				.detach();
+			});
 		}
 	}
 }
\ No newline at end of file
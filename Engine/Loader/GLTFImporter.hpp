@@ -3,8 +3,10 @@
 #include "ECS/Component/SpatialComponent/SpatialComponent.hpp"
 #include "ECS/Component/CameraComponent/CameraComponent.hpp"
 #include "ECS/Component/RenderingComponent/MaterialComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
 
 #include "ResourceManager/MeshManager.hpp"
+#include "Loader/VirtualFileSystem.hpp"
 
 #include <string>
 #include <vector>
@@ -32,6 +34,7 @@ namespace neo {
 			};
 
 			MeshHandle mMeshHandle;
+			std::vector<MeshLODComponent::LOD> mLODs; // Includes mMeshHandle as LOD 0. Empty unless ImportOptions::mLODCount is set
 			glm::vec3 mMin = glm::vec3(0.f);
 			glm::vec3 mMax = glm::vec3(0.f);
 
@@ -40,9 +43,16 @@ namespace neo {
 			bool mDoubleSided = false;
 		};
 
+		struct ImportOptions {
+			bool mQuantize = true; // Pack float vertex attributes down to 16/10 bit formats
+			bool mOptimize = true; // Weld vertices and reorder triangles for the vertex cache + overdraw
+			uint8_t mLODCount = 0; // Simplified meshes to generate, each with half the triangles of the last
+		};
+
 		using MeshNodeOp = std::function<void(ECS&, const MeshNode&)>;
 		using CameraNodeOp = std::function<void(ECS&, const CameraNode&)>;
-		void loadScene(std::string fileName, glm::mat4 baseTransform, ResourceManagers& resourceManagers, 
-			ECS& ecs, MeshNodeOp meshOperator, CameraNodeOp cameraOperator);
+		// baseDir is where external buffers are looked up -- empty for files that came out of a pack
+		void loadScene(std::string fileName, FileView file, std::string baseDir, glm::mat4 baseTransform, ResourceManagers& resourceManagers, 
+			ECS& ecs, MeshNodeOp meshOperator, CameraNodeOp cameraOperator, const ImportOptions& options = {});
 	}
 }
@@ -2,6 +2,7 @@
 #include "Loader.hpp"
 
 #include "GLTFImporter.hpp"
+#include "ShaderPreprocessor.hpp"
 
 #include "Util/Profiler.hpp"
 
@@ -15,18 +16,28 @@ namespace neo {
 	std::string Loader::APP_SHADER_DIR = "";
 	std::string Loader::ENGINE_RES_DIR = "../Engine/res/";
 	std::string Loader::ENGINE_SHADER_DIR = "../Engine/shaders/";
+	VirtualFileSystem Loader::sFileSystem;
 
 	void Loader::init(const std::string &res, const std::string& shaderDir) {
 		APP_RES_DIR = res;
 		APP_SHADER_DIR = shaderDir;
+
+		sFileSystem.unmountAll();
+		sFileSystem.mountDirectory(ENGINE_SHADER_DIR);
+		sFileSystem.mountDirectory(APP_SHADER_DIR);
+		sFileSystem.mountDirectory(APP_RES_DIR);
+		sFileSystem.mountDirectory(ENGINE_RES_DIR);
+		// Includes might resolve somewhere else now
+		ShaderPreprocessor::clear();
+	}
+
+	bool Loader::mountPack(const std::string& packPath) {
+		return sFileSystem.mountPack(packPath);
 	}
 
 	time_t Loader::getFileModTime(const std::string& fileName) {
-		time_t ret = 0;
-		bool success = _operate(fileName, [&ret](const char* fullPath) {
-			ret = util::getFileModTime(fullPath);
-		});
-		if (!success) {
+		time_t ret = sFileSystem.getModTime(fileName);
+		if (!ret) {
 			// TODO - this is called in parallel! Log needs a mutex!
 			NEO_LOG_E("Unable to get mod time for %s", fileName.c_str());
 		}
@@ -34,45 +45,49 @@ namespace neo {
 	}
 
 	const char* Loader::loadFileString(const std::string& fileName) {
-		const char* ret = nullptr;
-		bool success = _operate(fileName, [&ret](const char* fullPath) {
-			// This does a malloc..
-			ret = util::textFileRead(fullPath);
-		});
-
-		if (!success) {
+		FileView file = sFileSystem.open(fileName);
+		if (!file) {
 			NEO_LOG_E("Unable to find string file %s", fileName.c_str());
+			return nullptr;
 		}
+
+		// Callers own the string
+		char* ret = new char[file.size() + 1];
+		memcpy(ret, file.data(), file.size());
+		ret[file.size()] = '\0';
 		return ret;
 	}
 
+	FileView Loader::openFile(const std::string& fileName) {
+		TRACY_ZONE();
+		return sFileSystem.open(fileName);
+	}
+
+	std::optional<ResolvedFile> Loader::resolveFile(const std::string& fileName) {
+		return sFileSystem.resolve(fileName);
+	}
+
 	void Loader::loadGltfScene(
 		ECS& ecs, 
 		ResourceManagers& resourceManagers, 
 		const std::string& fileName, 
 		glm::mat4 baseTransform, 
 		GLTFImporter::MeshNodeOp meshOperator, 
-		GLTFImporter::CameraNodeOp cameraOperator
+		GLTFImporter::CameraNodeOp cameraOperator,
+		const GLTFImporter::ImportOptions& options
 	) {
-		bool success = _operate(fileName, [&](const char* fullPath) {
-			GLTFImporter::loadScene(fullPath, baseTransform, resourceManagers, ecs, meshOperator, cameraOperator);
-		});
-		if (!success) {
+		auto resolved = sFileSystem.resolve(fileName);
+		FileView file = sFileSystem.open(fileName);
+		if (!resolved || !file) {
 			NEO_LOG_E("Unable to find GLTF scene %s", fileName.c_str());
+			return;
 		}
-	}
-
-	bool Loader::_operate(const std::string& fileName, std::function<void(const char*)> callback) {
-		char fullPath[512];
-		auto searchDir = [&fullPath, &fileName, callback](const std::string& dir) {
-			sprintf(fullPath, "%s%s\0", dir.c_str(), fileName.c_str());
-			if (util::fileExists(fullPath)) {
-				callback(fullPath);
-				return true;
-			}
-			return false;
-		};
 
-		return searchDir(ENGINE_SHADER_DIR) || searchDir(APP_SHADER_DIR) || searchDir(APP_RES_DIR) || searchDir(ENGINE_RES_DIR);
+		// External buffers can't be found for scenes inside a pack -- pack .glbs instead
+		std::string baseDir;
+		if (!resolved->isPacked()) {
+			baseDir = resolved->mPath.substr(0, resolved->mPath.find_last_of("/\\") + 1);
+		}
+		GLTFImporter::loadScene(resolved->isPacked() ? fileName : resolved->mPath, file, baseDir, baseTransform, resourceManagers, ecs, meshOperator, cameraOperator, options);
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GLTFImporter.hpp"
+#include "VirtualFileSystem.hpp"
 
 #include <optional>
 #include <vector>
@@ -27,9 +28,13 @@ namespace neo {
 			Loader& operator=(const Loader&) = delete;
 
 			static void init(const std::string &resDir, const std::string &shaderDir);
+			// Searched after every directory. Packs are dropped on the next init
+			static bool mountPack(const std::string& packPath);
 
 			static time_t getFileModTime(const std::string& fileName);
 			static const char* loadFileString(const std::string&);
+			static FileView openFile(const std::string& fileName);
+			static std::optional<ResolvedFile> resolveFile(const std::string& fileName);
 
 			static void loadGltfScene(
 				ECS& ecs, 
@@ -39,7 +44,8 @@ namespace neo {
 				GLTFImporter::MeshNodeOp meshOp,
 				GLTFImporter::CameraNodeOp cameraOperator = [](ECS&, const GLTFImporter::CameraNode&) {
 					NEO_LOG_W("Default CameraNodeOp called?");
-				}
+				},
+				const GLTFImporter::ImportOptions& options = {}
 			);
 
 			static std::string APP_RES_DIR;
@@ -48,6 +54,6 @@ namespace neo {
 			static std::string ENGINE_SHADER_DIR;
 
 		private:
-			static bool _operate(const std::string& fileName, std::function<void(const char*)> callback);
+			static VirtualFileSystem sFileSystem;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ResourceManager/MeshManager.hpp"
+#include "Loader/MeshOptimizer.hpp"
 
 #include "ext/PerlinNoise.hpp"
 #include "ext/par/par_shapes.h"
@@ -16,46 +17,72 @@ namespace neo {
 			buffer.mOffset = 0;
 			buffer.mByteSize = byteSize;
 			buffer.mData = new uint8_t[byteSize];
+			buffer.mOwner = util::adoptBytes(buffer.mData);
 			if (buffer.mData) {
 				memcpy(const_cast<uint8_t*>(buffer.mData), data, byteSize);
 			}
 		}
 
-		void _uploadParShape(MeshLoadDetails& details, par_shapes_mesh* mesh) {
-			if (!mesh || !mesh->points || !mesh->triangles) {
-				return;
-			}
-			par_shapes_scale(mesh, 0.5f, 0.5f, 0.5f); // [-0.5, 0.5f] bounds
-			par_shapes_unweld(mesh, true);
-			par_shapes_compute_normals(mesh);
-
-			details.mPrimtive = types::mesh::Primitive::Triangles;
+		void _uploadVertexData(MeshLoadDetails& details, MeshPacker::MeshVertexData& data) {
+			details.mPrimtive = data.mPrimitive;
 			_uploadFloatBuffer(
 				details.mVertexBuffers[types::mesh::VertexType::Position],
 				3,
-				static_cast<uint32_t>(mesh->npoints * 3),
-				static_cast<uint32_t>(mesh->npoints * 3 * sizeof(float)),
-				reinterpret_cast<uint8_t*>(mesh->points)
+				static_cast<uint32_t>(data.mPositions.size() * 3),
+				static_cast<uint32_t>(data.mPositions.size() * sizeof(glm::vec3)),
+				reinterpret_cast<uint8_t*>(data.mPositions.data())
 			);
-			if (mesh->normals) {
+			if (!data.mNormals.empty()) {
 				_uploadFloatBuffer(
 					details.mVertexBuffers[types::mesh::VertexType::Normal],
 					3,
-					static_cast<uint32_t>(mesh->npoints * 3),
-					static_cast<uint32_t>(mesh->npoints * 3 * sizeof(float)),
-					reinterpret_cast<uint8_t*>(mesh->normals)
+					static_cast<uint32_t>(data.mNormals.size() * 3),
+					static_cast<uint32_t>(data.mNormals.size() * sizeof(glm::vec3)),
+					reinterpret_cast<uint8_t*>(data.mNormals.data())
 				);
 			}
-			{
-				uint32_t byteSize = static_cast<uint32_t>(mesh->ntriangles) * sizeof(PAR_SHAPES_T) * 3u;
+			if (!data.mUVs.empty()) {
+				_uploadFloatBuffer(
+					details.mVertexBuffers[types::mesh::VertexType::Texture0],
+					2,
+					static_cast<uint32_t>(data.mUVs.size() * 2),
+					static_cast<uint32_t>(data.mUVs.size() * sizeof(glm::vec2)),
+					reinterpret_cast<uint8_t*>(data.mUVs.data())
+				);
+			}
+			if (!data.mIndices.empty()) {
+				uint32_t byteSize = static_cast<uint32_t>(data.mIndices.size() * sizeof(uint32_t));
 				details.mElementBuffer = {
-					static_cast<uint32_t>(mesh->ntriangles * 3),
-					types::ByteFormats::UnsignedShort,
+					static_cast<uint32_t>(data.mIndices.size()),
+					types::ByteFormats::UnsignedInt,
 					byteSize
 				};
 				details.mElementBuffer->mData = new uint8_t[byteSize];
-				memcpy(const_cast<uint8_t*>(details.mElementBuffer->mData), mesh->triangles, byteSize);
+				details.mElementBuffer->mOwner = util::adoptBytes(details.mElementBuffer->mData);
+				memcpy(const_cast<uint8_t*>(details.mElementBuffer->mData), data.mIndices.data(), byteSize);
 			}
+		}
+
+		void _uploadParShape(MeshLoadDetails& details, par_shapes_mesh* mesh) {
+			if (!mesh || !mesh->points || !mesh->triangles) {
+				return;
+			}
+			par_shapes_scale(mesh, 0.5f, 0.5f, 0.5f); // [-0.5, 0.5f] bounds
+			par_shapes_unweld(mesh, true);
+			par_shapes_compute_normals(mesh);
+
+			MeshPacker::MeshVertexData data;
+			data.mPrimitive = types::mesh::Primitive::Triangles;
+			data.mPositions.resize(mesh->npoints);
+			memcpy(data.mPositions.data(), mesh->points, mesh->npoints * sizeof(glm::vec3));
+			if (mesh->normals) {
+				data.mNormals.resize(mesh->npoints);
+				memcpy(data.mNormals.data(), mesh->normals, mesh->npoints * sizeof(glm::vec3));
+			}
+			data.mIndices.assign(mesh->triangles, mesh->triangles + mesh->ntriangles * 3);
+
+			MeshOptimizer::optimize(data, "par_shapes");
+			_uploadVertexData(details, data);
 
 			par_shapes_free_mesh(mesh);
 		}
@@ -199,6 +226,7 @@ namespace neo {
 					byteSize
 				};
 				builder->mElementBuffer->mData = new uint8_t[byteSize];
+				builder->mElementBuffer->mOwner = util::adoptBytes(builder->mElementBuffer->mData);
 				memcpy(const_cast<uint8_t*>(builder->mElementBuffer->mData), indices.data(), byteSize);
 			}
 
@@ -265,6 +293,7 @@ namespace neo {
 					byteSize
 				};
 				builder->mElementBuffer->mData = new uint8_t[byteSize];
+				builder->mElementBuffer->mOwner = util::adoptBytes(builder->mElementBuffer->mData);
 				memcpy(const_cast<uint8_t*>(builder->mElementBuffer->mData), indices.data(), byteSize);
 			}
 
@@ -361,49 +390,23 @@ namespace neo {
 				ele = ele2;
 			}
 
-			// calculate UV coords
-			std::vector<float> tex;
-			for (unsigned i = 0; i < verts.size(); i += 3) {
-				tex.push_back(glm::clamp(0.5f + std::atan2(verts[i + 2], verts[i]) / (2.f * util::PI), 0.f, 1.f));
-				tex.push_back(glm::clamp(0.5f + std::asin(verts[i + 1]) / util::PI, 0.f, 1.f));
-			}
-
-			{
-				uint32_t byteSize = static_cast<uint32_t>(verts.size() * sizeof(float));
-				_uploadFloatBuffer(
-					builder->mVertexBuffers[types::mesh::VertexType::Position], 
-					3, 
-					static_cast<uint32_t>(verts.size()), 
-					byteSize,
-					reinterpret_cast<uint8_t*>(verts.data())
-				);
-				_uploadFloatBuffer(
-					builder->mVertexBuffers[types::mesh::VertexType::Normal], 
-					3, 
-					static_cast<uint32_t>(verts.size()), 
-					byteSize,
-					reinterpret_cast<uint8_t*>(verts.data())
+			// Midpoints are generated once per face, so shared edges get welded here
+			MeshPacker::MeshVertexData data;
+			data.mPrimitive = types::mesh::Primitive::Triangles;
+			data.mPositions.resize(verts.size() / 3);
+			memcpy(data.mPositions.data(), verts.data(), verts.size() * sizeof(float));
+			data.mNormals = data.mPositions;
+			for (const auto& position : data.mPositions) {
+				// calculate UV coords
+				data.mUVs.emplace_back(
+					glm::clamp(0.5f + std::atan2(position.z, position.x) / (2.f * util::PI), 0.f, 1.f),
+					glm::clamp(0.5f + std::asin(position.y) / util::PI, 0.f, 1.f)
 				);
 			}
-			{
-				_uploadFloatBuffer(
-					builder->mVertexBuffers[types::mesh::VertexType::Texture0], 
-					2, 
-					static_cast<uint32_t>(tex.size()), 
-					static_cast<uint32_t>(tex.size() * sizeof(float)), 
-					reinterpret_cast<uint8_t*>(tex.data())
-				);
-			}
-			{
-				uint32_t byteSize = static_cast<uint32_t>(ele.size() * sizeof(uint32_t));
-				builder->mElementBuffer = {
-					static_cast<uint32_t>(ele.size()),
-					types::ByteFormats::UnsignedInt,
-					byteSize
-				};
-				builder->mElementBuffer->mData = new uint8_t[byteSize];
-				memcpy(const_cast<uint8_t*>(builder->mElementBuffer->mData), ele.data(), byteSize);
-			}
+			data.mIndices = std::move(ele);
+
+			MeshOptimizer::optimize(data, "sphere");
+			_uploadVertexData(*builder, data);
 
 			return std::move(builder);
 		}
@@ -0,0 +1,615 @@
+#include "MeshOptimizer.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace neo {
+	namespace MeshOptimizer {
+		namespace {
+			template<typename T>
+			void _remapAttribute(std::vector<T>& attribute, const std::vector<uint32_t>& remap, uint32_t newCount) {
+				if (attribute.empty()) {
+					return;
+				}
+				std::vector<T> out(newCount);
+				for (size_t i = 0; i < remap.size(); i++) {
+					if (remap[i] != UINT32_MAX) {
+						out[remap[i]] = attribute[i];
+					}
+				}
+				attribute = std::move(out);
+			}
+
+			template<typename T>
+			void _hashAttribute(size_t& hash, const std::vector<T>& attribute, uint32_t index) {
+				if (attribute.empty()) {
+					return;
+				}
+				// FNV-1a over the raw bytes -- bitwise equality is what matters here
+				const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&attribute[index]);
+				for (size_t i = 0; i < sizeof(T); i++) {
+					hash = (hash ^ bytes[i]) * 1099511628211ull;
+				}
+			}
+
+			template<typename T>
+			bool _attributeEqual(const std::vector<T>& attribute, uint32_t a, uint32_t b) {
+				return attribute.empty() || memcmp(&attribute[a], &attribute[b], sizeof(T)) == 0;
+			}
+
+			// Forsyth's linear-speed vertex cache optimization
+			const int sScoringCacheSize = 32;
+			const float sCacheDecayPower = 1.5f;
+			const float sLastTriScore = 0.75f;
+			const float sValenceBoostScale = 2.f;
+			const float sValenceBoostPower = 0.5f;
+
+			inline float _vertexScore(int cachePosition, uint32_t remainingTriangles) {
+				if (remainingTriangles == 0) {
+					return -1.f;
+				}
+
+				float score = 0.f;
+				if (cachePosition >= 0) {
+					if (cachePosition < 3) {
+						// Used by the last triangle -- don't reward it, it would just repeat the same triangle fan
+						score = sLastTriScore;
+					}
+					else {
+						const float scaler = 1.f / static_cast<float>(sScoringCacheSize - 3);
+						score = std::pow(1.f - static_cast<float>(cachePosition - 3) * scaler, sCacheDecayPower);
+					}
+				}
+
+				// Bonus for vertices with few triangles left, so they get finished off instead of left dangling
+				score += sValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -sValenceBoostPower);
+				return score;
+			}
+
+			// Area weighted sum of squared plane distances, stored as the 10 unique terms of the symmetric 4x4
+			struct Quadric {
+				float mA2 = 0.f, mAB = 0.f, mAC = 0.f, mAD = 0.f;
+				float mB2 = 0.f, mBC = 0.f, mBD = 0.f;
+				float mC2 = 0.f, mCD = 0.f;
+				float mD2 = 0.f;
+				float mWeight = 0.f;
+
+				Quadric() = default;
+				Quadric(const glm::vec3& n, float d, float weight)
+					: mA2(n.x * n.x * weight), mAB(n.x * n.y * weight), mAC(n.x * n.z * weight), mAD(n.x * d * weight)
+					, mB2(n.y * n.y * weight), mBC(n.y * n.z * weight), mBD(n.y * d * weight)
+					, mC2(n.z * n.z * weight), mCD(n.z * d * weight)
+					, mD2(d * d * weight)
+					, mWeight(weight)
+				{}
+
+				void operator+=(const Quadric& other) {
+					mA2 += other.mA2; mAB += other.mAB; mAC += other.mAC; mAD += other.mAD;
+					mB2 += other.mB2; mBC += other.mBC; mBD += other.mBD;
+					mC2 += other.mC2; mCD += other.mCD;
+					mD2 += other.mD2;
+					mWeight += other.mWeight;
+				}
+
+				// Average squared distance from p to the accumulated planes
+				float error(const glm::vec3& p) const {
+					const float e =
+						mA2 * p.x * p.x + mB2 * p.y * p.y + mC2 * p.z * p.z
+						+ 2.f * (mAB * p.x * p.y + mAC * p.x * p.z + mBC * p.y * p.z)
+						+ 2.f * (mAD * p.x + mBD * p.y + mCD * p.z)
+						+ mD2;
+					return std::max(e, 0.f) / std::max(mWeight, 1e-8f);
+				}
+			};
+
+			struct Collapse {
+				float mCost;
+				uint32_t mFrom;
+				uint32_t mTo;
+				uint32_t mFromVersion;
+				uint32_t mToVersion;
+
+				bool operator>(const Collapse& other) const {
+					return mCost > other.mCost;
+				}
+			};
+		}
+
+		VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+			VertexCacheStats stats;
+			stats.mVertexCount = vertexCount;
+			stats.mTriangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+			std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+			uint32_t timestamp = cacheSize + 1;
+			for (const uint32_t index : indices) {
+				if (timestamp - cacheTimestamps[index] > cacheSize) {
+					cacheTimestamps[index] = timestamp++;
+					stats.mTransformedCount++;
+				}
+			}
+
+			if (stats.mTriangleCount) {
+				stats.mACMR = static_cast<float>(stats.mTransformedCount) / static_cast<float>(stats.mTriangleCount);
+			}
+			if (stats.mVertexCount) {
+				stats.mATVR = static_cast<float>(stats.mTransformedCount) / static_cast<float>(stats.mVertexCount);
+			}
+			return stats;
+		}
+
+		void weldVertices(MeshPacker::MeshVertexData& data) {
+			TRACY_ZONE();
+			const uint32_t vertexCount = static_cast<uint32_t>(data.mPositions.size());
+
+			auto hasher = [&data](uint32_t index) {
+				size_t hash = 14695981039346656037ull;
+				_hashAttribute(hash, data.mPositions, index);
+				_hashAttribute(hash, data.mNormals, index);
+				_hashAttribute(hash, data.mUVs, index);
+				_hashAttribute(hash, data.mTangents, index);
+				return hash;
+			};
+			auto equal = [&data](uint32_t a, uint32_t b) {
+				return _attributeEqual(data.mPositions, a, b)
+					&& _attributeEqual(data.mNormals, a, b)
+					&& _attributeEqual(data.mUVs, a, b)
+					&& _attributeEqual(data.mTangents, a, b);
+			};
+			std::unordered_map<uint32_t, uint32_t, decltype(hasher), decltype(equal)> uniqueVertices(vertexCount, hasher, equal);
+
+			std::vector<uint32_t> remap(vertexCount);
+			uint32_t uniqueCount = 0;
+			for (uint32_t i = 0; i < vertexCount; i++) {
+				auto [it, inserted] = uniqueVertices.emplace(i, uniqueCount);
+				remap[i] = it->second;
+				if (inserted) {
+					uniqueCount++;
+				}
+			}
+			if (uniqueCount == vertexCount) {
+				return;
+			}
+
+			_remapAttribute(data.mPositions, remap, uniqueCount);
+			_remapAttribute(data.mNormals, remap, uniqueCount);
+			_remapAttribute(data.mUVs, remap, uniqueCount);
+			_remapAttribute(data.mTangents, remap, uniqueCount);
+			for (auto& index : data.mIndices) {
+				index = remap[index];
+			}
+		}
+
+		void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount) {
+			TRACY_ZONE();
+			const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+			if (triangleCount == 0) {
+				return;
+			}
+
+			// Vertex -> triangle adjacency
+			std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+			for (const uint32_t index : indices) {
+				adjacencyOffsets[index + 1]++;
+			}
+			for (uint32_t i = 0; i < vertexCount; i++) {
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			}
+			std::vector<uint32_t> adjacency(indices.size());
+			{
+				std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (uint32_t i = 0; i < indices.size(); i++) {
+					adjacency[fill[indices[i]]++] = i / 3;
+				}
+			}
+
+			std::vector<uint32_t> remainingTriangles(vertexCount);
+			std::vector<int> cachePosition(vertexCount, -1);
+			std::vector<float> vertexScores(vertexCount);
+			for (uint32_t i = 0; i < vertexCount; i++) {
+				remainingTriangles[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+				vertexScores[i] = _vertexScore(-1, remainingTriangles[i]);
+			}
+
+			std::vector<float> triangleScores(triangleCount);
+			std::vector<bool> emitted(triangleCount, false);
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				triangleScores[t] = vertexScores[indices[t * 3 + 0]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+			}
+
+			std::vector<uint32_t> output;
+			output.reserve(indices.size());
+			std::vector<uint32_t> cache;
+			cache.reserve(sScoringCacheSize + 3);
+			uint32_t bestTriangle = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+			uint32_t scanCursor = 0;
+
+			while (bestTriangle != UINT32_MAX) {
+				emitted[bestTriangle] = true;
+
+				// Emit and push its vertices to the front of the cache
+				std::vector<uint32_t> newCache;
+				newCache.reserve(sScoringCacheSize + 3);
+				for (int i = 0; i < 3; i++) {
+					const uint32_t vertex = indices[bestTriangle * 3 + i];
+					output.push_back(vertex);
+					newCache.push_back(vertex);
+
+					auto begin = adjacency.begin() + adjacencyOffsets[vertex];
+					auto end = begin + remainingTriangles[vertex];
+					std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+					remainingTriangles[vertex]--;
+				}
+				for (const uint32_t vertex : cache) {
+					if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+						newCache.push_back(vertex);
+					}
+				}
+				for (size_t i = sScoringCacheSize; i < newCache.size(); i++) {
+					cachePosition[newCache[i]] = -1;
+					vertexScores[newCache[i]] = _vertexScore(-1, remainingTriangles[newCache[i]]);
+				}
+				newCache.resize(std::min(newCache.size(), static_cast<size_t>(sScoringCacheSize)));
+				std::swap(cache, newCache);
+
+				// Only vertices in the cache changed score, so only their triangles need rescoring
+				for (int i = 0; i < static_cast<int>(cache.size()); i++) {
+					cachePosition[cache[i]] = i;
+					vertexScores[cache[i]] = _vertexScore(i, remainingTriangles[cache[i]]);
+				}
+				bestTriangle = UINT32_MAX;
+				float bestScore = -1.f;
+				for (const uint32_t vertex : cache) {
+					for (uint32_t a = 0; a < remainingTriangles[vertex]; a++) {
+						const uint32_t t = adjacency[adjacencyOffsets[vertex] + a];
+						triangleScores[t] = vertexScores[indices[t * 3 + 0]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+						if (triangleScores[t] > bestScore) {
+							bestScore = triangleScores[t];
+							bestTriangle = t;
+						}
+					}
+				}
+
+				// Nothing touches the cache anymore -- start a new strip from the next unemitted triangle
+				if (bestTriangle == UINT32_MAX) {
+					while (scanCursor < triangleCount && emitted[scanCursor]) {
+						scanCursor++;
+					}
+					if (scanCursor < triangleCount) {
+						bestTriangle = scanCursor;
+					}
+				}
+			}
+
+			indices = std::move(output);
+		}
+
+		void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, uint32_t cacheSize) {
+			TRACY_ZONE();
+			const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+			if (triangleCount == 0) {
+				return;
+			}
+
+			// Split the cache-optimized order into clusters wherever the cache fully misses. Reordering whole clusters
+			// keeps the cache behavior within them intact
+			std::vector<uint32_t> clusterStarts;
+			{
+				std::vector<uint32_t> cacheTimestamps(positions.size(), 0);
+				uint32_t timestamp = cacheSize + 1;
+				for (uint32_t t = 0; t < triangleCount; t++) {
+					int misses = 0;
+					for (int i = 0; i < 3; i++) {
+						const uint32_t index = indices[t * 3 + i];
+						if (timestamp - cacheTimestamps[index] > cacheSize) {
+							cacheTimestamps[index] = timestamp++;
+							misses++;
+						}
+					}
+					if (t == 0 || misses == 3) {
+						clusterStarts.push_back(t);
+					}
+				}
+			}
+			const uint32_t clusterCount = static_cast<uint32_t>(clusterStarts.size());
+			if (clusterCount < 2) {
+				return;
+			}
+			clusterStarts.push_back(triangleCount);
+
+			// Area weighted centroid + normal of each cluster
+			glm::vec3 meshCentroid(0.f);
+			float meshArea = 0.f;
+			std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.f));
+			std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.f));
+			for (uint32_t c = 0; c < clusterCount; c++) {
+				float clusterArea = 0.f;
+				for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++) {
+					const glm::vec3& a = positions[indices[t * 3 + 0]];
+					const glm::vec3& b = positions[indices[t * 3 + 1]];
+					const glm::vec3& v = positions[indices[t * 3 + 2]];
+					const glm::vec3 normal = glm::cross(b - a, v - a);
+					const float area = glm::length(normal);
+					const glm::vec3 centroid = (a + b + v) / 3.f;
+					clusterCentroids[c] += centroid * area;
+					clusterNormals[c] += normal;
+					clusterArea += area;
+				}
+				meshCentroid += clusterCentroids[c];
+				meshArea += clusterArea;
+				clusterCentroids[c] /= clusterArea > 0.f ? clusterArea : 1.f;
+			}
+			meshCentroid /= meshArea > 0.f ? meshArea : 1.f;
+
+			// Clusters facing away from the center are likely to occlude the rest -- draw them first
+			std::vector<float> sortKeys(clusterCount);
+			for (uint32_t c = 0; c < clusterCount; c++) {
+				const float length = glm::length(clusterNormals[c]);
+				sortKeys[c] = length > 0.f ? glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c] / length) : 0.f;
+			}
+			std::vector<uint32_t> clusterOrder(clusterCount);
+			for (uint32_t c = 0; c < clusterCount; c++) {
+				clusterOrder[c] = c;
+			}
+			std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32_t a, uint32_t b) {
+				return sortKeys[a] > sortKeys[b];
+			});
+
+			std::vector<uint32_t> output;
+			output.reserve(indices.size());
+			for (const uint32_t c : clusterOrder) {
+				output.insert(output.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+			}
+			indices = std::move(output);
+		}
+
+		void optimizeVertexFetch(MeshPacker::MeshVertexData& data) {
+			TRACY_ZONE();
+			// Lay vertices out in the order they're first referenced. Unreferenced vertices are dropped
+			std::vector<uint32_t> remap(data.mPositions.size(), UINT32_MAX);
+			uint32_t vertexCount = 0;
+			for (auto& index : data.mIndices) {
+				if (remap[index] == UINT32_MAX) {
+					remap[index] = vertexCount++;
+				}
+				index = remap[index];
+			}
+
+			_remapAttribute(data.mPositions, remap, vertexCount);
+			_remapAttribute(data.mNormals, remap, vertexCount);
+			_remapAttribute(data.mUVs, remap, vertexCount);
+			_remapAttribute(data.mTangents, remap, vertexCount);
+		}
+
+		void optimize(MeshPacker::MeshVertexData& data, const char* debugName) {
+			TRACY_ZONE();
+			if (data.mPrimitive != types::mesh::Primitive::Triangles || data.mPositions.empty()) {
+				return;
+			}
+
+			// Unindexed meshes get indexed first so welding has something to work with
+			if (data.mIndices.empty()) {
+				data.mIndices.resize(data.mPositions.size());
+				for (uint32_t i = 0; i < data.mIndices.size(); i++) {
+					data.mIndices[i] = i;
+				}
+			}
+
+			const VertexCacheStats before = analyzeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size()));
+
+			weldVertices(data);
+			optimizeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size()));
+			optimizeOverdraw(data.mIndices, data.mPositions);
+			optimizeVertexFetch(data);
+
+			const VertexCacheStats after = analyzeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size()));
+			NEO_LOG_V("Optimized mesh %s: %d -> %d verts, ACMR %0.3f -> %0.3f, ATVR %0.3f -> %0.3f",
+				debugName ? debugName : "",
+				before.mVertexCount, after.mVertexCount,
+				before.mACMR, after.mACMR,
+				before.mATVR, after.mATVR
+			);
+		}
+
+		std::vector<uint32_t> simplify(const MeshPacker::MeshVertexData& data, uint32_t targetIndexCount, float& outError) {
+			TRACY_ZONE();
+			outError = 0.f;
+			std::vector<uint32_t> indices = data.mIndices;
+			if (data.mPrimitive != types::mesh::Primitive::Triangles || targetIndexCount >= indices.size()) {
+				return indices;
+			}
+			const uint32_t vertexCount = static_cast<uint32_t>(data.mPositions.size());
+			const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+			// Seams split one position into several vertices -- collapses happen on unique positions instead
+			std::vector<uint32_t> positionIDs(vertexCount);
+			std::vector<glm::vec3> positions;
+			{
+				auto hasher = [&data](uint32_t index) {
+					size_t hash = 14695981039346656037ull;
+					_hashAttribute(hash, data.mPositions, index);
+					return hash;
+				};
+				auto equal = [&data](uint32_t a, uint32_t b) {
+					return _attributeEqual(data.mPositions, a, b);
+				};
+				std::unordered_map<uint32_t, uint32_t, decltype(hasher), decltype(equal)> uniquePositions(vertexCount, hasher, equal);
+				for (uint32_t i = 0; i < vertexCount; i++) {
+					auto [it, inserted] = uniquePositions.emplace(i, static_cast<uint32_t>(positions.size()));
+					positionIDs[i] = it->second;
+					if (inserted) {
+						positions.push_back(data.mPositions[i]);
+					}
+				}
+			}
+			const uint32_t positionCount = static_cast<uint32_t>(positions.size());
+
+			// Adjacency, seams, and borders
+			std::vector<std::vector<uint32_t>> triangles(positionCount);
+			std::vector<uint32_t> firstVertex(positionCount, UINT32_MAX);
+			std::vector<bool> locked(positionCount, false);
+			std::unordered_map<uint64_t, uint32_t> edgeCounts;
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				for (int i = 0; i < 3; i++) {
+					const uint32_t vertex = indices[t * 3 + i];
+					const uint32_t position = positionIDs[vertex];
+					triangles[position].push_back(t);
+					if (firstVertex[position] == UINT32_MAX) {
+						firstVertex[position] = vertex;
+					}
+					else if (firstVertex[position] != vertex) {
+						locked[position] = true;
+					}
+
+					const uint32_t other = positionIDs[indices[t * 3 + (i + 1) % 3]];
+					edgeCounts[(static_cast<uint64_t>(std::min(position, other)) << 32) | std::max(position, other)]++;
+				}
+			}
+			for (auto&& [edge, count] : edgeCounts) {
+				if (count == 1) {
+					locked[static_cast<uint32_t>(edge >> 32)] = true;
+					locked[static_cast<uint32_t>(edge & UINT32_MAX)] = true;
+				}
+			}
+
+			std::vector<Quadric> quadrics(positionCount);
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				const glm::vec3& a = positions[positionIDs[indices[t * 3 + 0]]];
+				const glm::vec3& b = positions[positionIDs[indices[t * 3 + 1]]];
+				const glm::vec3& c = positions[positionIDs[indices[t * 3 + 2]]];
+				glm::vec3 normal = glm::cross(b - a, c - a);
+				const float area = glm::length(normal);
+				if (area <= 0.f) {
+					continue;
+				}
+				normal /= area;
+				const Quadric quadric(normal, -glm::dot(normal, a), area * 0.5f);
+				for (int i = 0; i < 3; i++) {
+					quadrics[positionIDs[indices[t * 3 + i]]] += quadric;
+				}
+			}
+
+			std::vector<bool> removed(triangleCount, false);
+			std::vector<bool> collapsed(positionCount, false);
+			std::vector<uint32_t> versions(positionCount, 0);
+			std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+			// Whatever to ends up with is both quadrics -- from's alone would undercount what to's planes see
+			auto pushCollapse = [&](uint32_t from, uint32_t to) {
+				if (!locked[from] && from != to) {
+					Quadric combined = quadrics[from];
+					combined += quadrics[to];
+					queue.push({ combined.error(positions[to]), from, to, versions[from], versions[to] });
+				}
+			};
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				for (int i = 0; i < 3; i++) {
+					pushCollapse(positionIDs[indices[t * 3 + i]], positionIDs[indices[t * 3 + (i + 1) % 3]]);
+					pushCollapse(positionIDs[indices[t * 3 + (i + 1) % 3]], positionIDs[indices[t * 3 + i]]);
+				}
+			}
+
+			uint32_t liveTriangles = triangleCount;
+			float maxError = 0.f;
+			while (liveTriangles * 3 > targetIndexCount && !queue.empty()) {
+				const Collapse collapse = queue.top();
+				queue.pop();
+				if (collapsed[collapse.mFrom] || collapsed[collapse.mTo] || versions[collapse.mFrom] != collapse.mFromVersion || versions[collapse.mTo] != collapse.mToVersion) {
+					continue;
+				}
+
+				// The edge has to still exist, and moving from onto to can't flip anything
+				uint32_t toVertex = UINT32_MAX;
+				bool valid = true;
+				for (const uint32_t t : triangles[collapse.mFrom]) {
+					if (removed[t]) {
+						continue;
+					}
+					glm::vec3 before[3];
+					glm::vec3 after[3];
+					bool containsTo = false;
+					for (int i = 0; i < 3; i++) {
+						const uint32_t position = positionIDs[indices[t * 3 + i]];
+						if (position == collapse.mTo) {
+							containsTo = true;
+							toVertex = indices[t * 3 + i];
+						}
+						before[i] = positions[position];
+						after[i] = position == collapse.mFrom ? positions[collapse.mTo] : positions[position];
+					}
+					if (containsTo) {
+						continue;
+					}
+					const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+					const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+					if (glm::dot(normalBefore, normalAfter) <= 0.f) {
+						valid = false;
+						break;
+					}
+				}
+				if (!valid || toVertex == UINT32_MAX) {
+					continue;
+				}
+
+				// from isn't on a seam, so its fan only ever sees one of to's vertices
+				for (const uint32_t t : triangles[collapse.mFrom]) {
+					if (removed[t]) {
+						continue;
+					}
+					bool containsTo = false;
+					for (int i = 0; i < 3; i++) {
+						containsTo |= positionIDs[indices[t * 3 + i]] == collapse.mTo;
+					}
+					if (containsTo) {
+						removed[t] = true;
+						liveTriangles--;
+						continue;
+					}
+					for (int i = 0; i < 3; i++) {
+						if (positionIDs[indices[t * 3 + i]] == collapse.mFrom) {
+							indices[t * 3 + i] = toVertex;
+						}
+					}
+					triangles[collapse.mTo].push_back(t);
+				}
+				quadrics[collapse.mTo] += quadrics[collapse.mFrom];
+				collapsed[collapse.mFrom] = true;
+				versions[collapse.mTo]++;
+				maxError = std::max(maxError, collapse.mCost);
+
+				// to's quadric changed, and it picked up all of from's neighbors
+				for (const uint32_t t : triangles[collapse.mTo]) {
+					if (removed[t]) {
+						continue;
+					}
+					for (int i = 0; i < 3; i++) {
+						const uint32_t neighbor = positionIDs[indices[t * 3 + i]];
+						pushCollapse(collapse.mTo, neighbor);
+						pushCollapse(neighbor, collapse.mTo);
+					}
+				}
+			}
+
+			std::vector<uint32_t> output;
+			output.reserve(liveTriangles * 3);
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				if (!removed[t]) {
+					output.insert(output.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+				}
+			}
+
+			glm::vec3 min(std::numeric_limits<float>::max());
+			glm::vec3 max(std::numeric_limits<float>::lowest());
+			for (const auto& position : positions) {
+				min = glm::min(min, position);
+				max = glm::max(max, position);
+			}
+			const float radius = glm::length(max - min) * 0.5f;
+			outError = radius > 0.f ? std::sqrt(maxError) / radius : 0.f;
+			return output;
+		}
+	}
+}
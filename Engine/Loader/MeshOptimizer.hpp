@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Loader/MeshPacker.hpp"
+
+#include <vector>
+
+namespace neo {
+
+	namespace MeshOptimizer {
+
+		struct VertexCacheStats {
+			uint32_t mVertexCount = 0;
+			uint32_t mTriangleCount = 0;
+			uint32_t mTransformedCount = 0;
+			float mACMR = 0.f; // Transformed vertices per triangle -- 0.5 is the best a regular grid can do
+			float mATVR = 0.f; // Transformed vertices per unique vertex -- 1.0 is perfect
+		};
+
+		// Simulates a FIFO post-transform cache
+		VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+		// Individual stages. All of these operate on indexed triangle lists and preserve winding
+		void weldVertices(MeshPacker::MeshVertexData& data);
+		void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+		void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, uint32_t cacheSize = 16);
+		void optimizeVertexFetch(MeshPacker::MeshVertexData& data);
+
+		// Runs all of the above in order and logs the before/after cache stats
+		void optimize(MeshPacker::MeshVertexData& data, const char* debugName);
+
+		// Quadric edge collapse down to roughly targetIndexCount. Vertices are only collapsed onto existing vertices,
+		// so the returned indices still reference data's vertex buffer. Borders and attribute seams are locked.
+		// outError is the largest collapse error relative to the mesh's bounding radius
+		std::vector<uint32_t> simplify(const MeshPacker::MeshVertexData& data, uint32_t targetIndexCount, float& outError);
+	}
+}
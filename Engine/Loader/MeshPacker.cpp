@@ -0,0 +1,153 @@
+#include "MeshPacker.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+#include <limits>
+
+namespace neo {
+	namespace MeshPacker {
+		namespace {
+			template<typename T>
+			void _write(uint8_t* dst, const T& value) {
+				memcpy(dst, &value, sizeof(T));
+			}
+
+			// Degenerate normals and tangents show up in real assets -- keep them zero instead of packing NaNs
+			glm::vec3 _safeNormalize(const glm::vec3& v) {
+				const float length = glm::length(v);
+				return length > 0.f ? v / length : glm::vec3(0.f);
+			}
+		}
+
+		std::unique_ptr<MeshLoadDetails> pack(const MeshVertexData& data, bool quantize) {
+			TRACY_ZONE();
+			NEO_ASSERT(!data.mPositions.empty(), "Packing a mesh without positions");
+
+			const uint32_t vertexCount = static_cast<uint32_t>(data.mPositions.size());
+			const bool hasNormals = data.mNormals.size() == vertexCount;
+			const bool hasUVs = data.mUVs.size() == vertexCount;
+			const bool hasTangents = data.mTangents.size() == vertexCount;
+
+			auto builder = std::make_unique<MeshLoadDetails>();
+			builder->mPrimtive = data.mPrimitive;
+
+			// Layout
+			MeshLoadDetails::InterleavedBuffer buffer;
+			uint32_t stride = 0;
+			buffer.mAttributes[types::mesh::VertexType::Position] = quantize ?
+				MeshLoadDetails::InterleavedBuffer::Attribute{ 4, types::ByteFormats::UnsignedShort, true, stride } :
+				MeshLoadDetails::InterleavedBuffer::Attribute{ 3, types::ByteFormats::Float, false, stride };
+			stride += static_cast<uint32_t>(quantize ? 4 * sizeof(uint16_t) : sizeof(glm::vec3));
+			uint32_t normalOffset = stride;
+			if (hasNormals) {
+				// 2_10_10_10 has to be fetched as 4 components
+				buffer.mAttributes[types::mesh::VertexType::Normal] = quantize ?
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 4, types::ByteFormats::Int2_10_10_10_Rev, true, stride } :
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 3, types::ByteFormats::Float, false, stride };
+				stride += static_cast<uint32_t>(quantize ? sizeof(uint32_t) : sizeof(glm::vec3));
+			}
+			uint32_t uvOffset = stride;
+			if (hasUVs) {
+				buffer.mAttributes[types::mesh::VertexType::Texture0] = quantize ?
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 2, types::ByteFormats::HalfFloat, false, stride } :
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 2, types::ByteFormats::Float, false, stride };
+				stride += static_cast<uint32_t>(quantize ? sizeof(uint32_t) : sizeof(glm::vec2));
+			}
+			uint32_t tangentOffset = stride;
+			if (hasTangents) {
+				buffer.mAttributes[types::mesh::VertexType::Tangent] = quantize ?
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 4, types::ByteFormats::Int2_10_10_10_Rev, true, stride } :
+					MeshLoadDetails::InterleavedBuffer::Attribute{ 4, types::ByteFormats::Float, false, stride };
+				stride += static_cast<uint32_t>(quantize ? sizeof(uint32_t) : sizeof(glm::vec4));
+			}
+			buffer.mStride = stride;
+			buffer.mCount = vertexCount;
+			buffer.mByteSize = stride * vertexCount;
+
+			// Positions are quantized relative to the mesh's bounds
+			glm::vec3 min(std::numeric_limits<float>::max());
+			glm::vec3 max(std::numeric_limits<float>::lowest());
+			for (const auto& position : data.mPositions) {
+				min = glm::min(min, position);
+				max = glm::max(max, position);
+			}
+			glm::vec3 extent = max - min;
+			for (int i = 0; i < 3; i++) {
+				if (extent[i] <= 0.f) {
+					extent[i] = 1.f;
+				}
+			}
+			if (quantize) {
+				builder->mPositionScale = extent;
+				builder->mPositionBias = min;
+			}
+
+			uint8_t* vertices = new uint8_t[buffer.mByteSize];
+			for (uint32_t i = 0; i < vertexCount; i++) {
+				uint8_t* vertex = vertices + i * stride;
+				if (quantize) {
+					_write(vertex, glm::packUnorm4x16(glm::vec4((data.mPositions[i] - min) / extent, 0.f)));
+					if (hasNormals) {
+						_write(vertex + normalOffset, glm::packSnorm3x10_1x2(glm::vec4(_safeNormalize(data.mNormals[i]), 0.f)));
+					}
+					if (hasUVs) {
+						_write(vertex + uvOffset, glm::packHalf2x16(data.mUVs[i]));
+					}
+					if (hasTangents) {
+						// w is handedness, which survives the 2 bits
+						const glm::vec4& tangent = data.mTangents[i];
+						_write(vertex + tangentOffset, glm::packSnorm3x10_1x2(glm::vec4(_safeNormalize(glm::vec3(tangent)), tangent.w < 0.f ? -1.f : 1.f)));
+					}
+				}
+				else {
+					_write(vertex, data.mPositions[i]);
+					if (hasNormals) {
+						_write(vertex + normalOffset, data.mNormals[i]);
+					}
+					if (hasUVs) {
+						_write(vertex + uvOffset, data.mUVs[i]);
+					}
+					if (hasTangents) {
+						_write(vertex + tangentOffset, data.mTangents[i]);
+					}
+				}
+			}
+			buffer.mData = vertices;
+			buffer.mOwner = util::adoptBytes(vertices);
+			builder->mInterleavedBuffer = buffer;
+
+			// Indices drop to 16 bits whenever they fit
+			if (!data.mIndices.empty()) {
+				const uint32_t indexCount = static_cast<uint32_t>(data.mIndices.size());
+				if (vertexCount <= std::numeric_limits<uint16_t>::max()) {
+					uint8_t* indices = new uint8_t[indexCount * sizeof(uint16_t)];
+					for (uint32_t i = 0; i < indexCount; i++) {
+						_write(indices + i * sizeof(uint16_t), static_cast<uint16_t>(data.mIndices[i]));
+					}
+					builder->mElementBuffer = {
+						indexCount,
+						types::ByteFormats::UnsignedShort,
+						static_cast<uint32_t>(indexCount * sizeof(uint16_t)),
+						indices,
+						util::adoptBytes(indices)
+					};
+				}
+				else {
+					uint8_t* indices = new uint8_t[indexCount * sizeof(uint32_t)];
+					memcpy(indices, data.mIndices.data(), indexCount * sizeof(uint32_t));
+					builder->mElementBuffer = {
+						indexCount,
+						types::ByteFormats::UnsignedInt,
+						static_cast<uint32_t>(indexCount * sizeof(uint32_t)),
+						indices,
+						util::adoptBytes(indices)
+					};
+				}
+			}
+
+			return builder;
+		}
+	}
+}
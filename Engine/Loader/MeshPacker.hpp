@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ResourceManager/MeshManager.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace neo {
+
+	namespace MeshPacker {
+
+		// Deinterleaved float vertex data as it comes out of an importer
+		struct MeshVertexData {
+			types::mesh::Primitive mPrimitive = types::mesh::Primitive::Triangles;
+			std::vector<glm::vec3> mPositions;
+			std::vector<glm::vec3> mNormals;
+			std::vector<glm::vec2> mUVs;
+			std::vector<glm::vec4> mTangents;
+			std::vector<uint32_t> mIndices;
+		};
+
+		// Packs everything into a single interleaved buffer. Quantized vertices are 20 bytes instead of 48:
+		// positions as unorm16 within the mesh bounds, normals/tangents as snorm 10_10_10_2, uvs as halfs.
+		// Caller owns the returned buffers
+		[[nodiscard]] std::unique_ptr<MeshLoadDetails> pack(const MeshVertexData& data, bool quantize);
+	}
+}
@@ -22,6 +22,26 @@ namespace neo {
 			NEO_FAIL("Invalid byte format for stbi");
 		}
 	}
+
+	STBImageData::STBImageData(const char* _filePath, const uint8_t* bytes, size_t byteSize, types::texture::BaseFormats baseFormat, types::ByteFormats byteFormat, bool flip) {
+		mFilePath = _filePath;
+		stbi_set_flip_vertically_on_load(flip);
+		int _components;
+		int _byteSize = static_cast<int>(byteSize);
+		if (byteFormat == types::ByteFormats::UnsignedByte) {
+			mData = stbi_load_from_memory(bytes, _byteSize, &mWidth, &mHeight, &_components, baseFormat == types::texture::BaseFormats::RGBA ? STBI_rgb_alpha : STBI_rgb);
+		}
+		else if (byteFormat == types::ByteFormats::UnsignedShort) {
+			mData = reinterpret_cast<uint8_t*>(stbi_load_16_from_memory(bytes, _byteSize, &mWidth, &mHeight, &_components, baseFormat == types::texture::BaseFormats::RGBA ? STBI_rgb_alpha : STBI_rgb));
+		}
+		else if (byteFormat == types::ByteFormats::Float) {
+			mData = reinterpret_cast<uint8_t*>(stbi_loadf_from_memory(bytes, _byteSize, &mWidth, &mHeight, &_components, baseFormat == types::texture::BaseFormats::RGBA ? STBI_rgb_alpha : STBI_rgb));
+		}
+		else {
+			NEO_FAIL("Invalid byte format for stbi");
+		}
+	}
+
 	STBImageData::~STBImageData() {
 		stbi_image_free(mData);
 	}
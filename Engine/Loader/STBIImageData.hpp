@@ -6,6 +6,8 @@
 namespace neo {
 	struct STBImageData {
 		STBImageData(const char* _filePath, types::texture::BaseFormats baseFormat, types::ByteFormats byteFormat, bool flip);
+		// Decodes an already loaded file -- filePath is just for logging
+		STBImageData(const char* _filePath, const uint8_t* bytes, size_t byteSize, types::texture::BaseFormats baseFormat, types::ByteFormats byteFormat, bool flip);
 		~STBImageData();
 
 		operator bool() const {
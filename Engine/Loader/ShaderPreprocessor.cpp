@@ -0,0 +1,134 @@
+#include "Loader/pch.hpp"
+#include "ShaderPreprocessor.hpp"
+
+#include "Loader.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <algorithm>
+
+namespace neo {
+
+	namespace {
+		const std::string_view sUniversalInclude = "#include \"universal.glsl\"\n";
+		const std::string_view sIncludeToken = "#include \"";
+	}
+
+	std::mutex ShaderPreprocessor::sMutex;
+	std::unordered_map<std::string, ShaderPreprocessor::Chunk> ShaderPreprocessor::sChunks;
+	std::unordered_map<std::string, std::unordered_set<std::string>> ShaderPreprocessor::sIncludedBy;
+
+	std::string ShaderPreprocessor::expand(std::string_view source) {
+		TRACY_ZONE();
+		std::lock_guard<std::mutex> lock(sMutex);
+		std::string expanded;
+		std::unordered_set<std::string> dependencies;
+		std::vector<std::string> directIncludes;
+		std::vector<std::string> visiting;
+		_expand(sUniversalInclude, &expanded, dependencies, directIncludes, visiting);
+		expanded.reserve(expanded.size() + source.size());
+		_expand(source, &expanded, dependencies, directIncludes, visiting);
+		return expanded;
+	}
+
+	void ShaderPreprocessor::collectDependencies(std::string_view source, std::unordered_set<std::string>& dependencies) {
+		TRACY_ZONE();
+		std::lock_guard<std::mutex> lock(sMutex);
+		std::vector<std::string> directIncludes;
+		std::vector<std::string> visiting;
+		_expand(sUniversalInclude, nullptr, dependencies, directIncludes, visiting);
+		_expand(source, nullptr, dependencies, directIncludes, visiting);
+	}
+
+	std::unordered_set<std::string> ShaderPreprocessor::invalidate(const std::vector<std::string>& changedFiles) {
+		TRACY_ZONE();
+		std::lock_guard<std::mutex> lock(sMutex);
+		std::unordered_set<std::string> affected;
+		std::vector<std::string> stack(changedFiles.begin(), changedFiles.end());
+		while (!stack.empty()) {
+			std::string fileName = std::move(stack.back());
+			stack.pop_back();
+			if (!affected.insert(fileName).second) {
+				continue;
+			}
+			sChunks.erase(fileName);
+			auto includedBy = sIncludedBy.find(fileName);
+			if (includedBy != sIncludedBy.end()) {
+				stack.insert(stack.end(), includedBy->second.begin(), includedBy->second.end());
+			}
+		}
+		return affected;
+	}
+
+	void ShaderPreprocessor::clear() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		sChunks.clear();
+		sIncludedBy.clear();
+	}
+
+	const ShaderPreprocessor::Chunk* ShaderPreprocessor::_chunk(const std::string& fileName, std::vector<std::string>& visiting) {
+		auto it = sChunks.find(fileName);
+		if (it != sChunks.end()) {
+			return &it->second;
+		}
+		if (std::find(visiting.begin(), visiting.end(), fileName) != visiting.end()) {
+			NEO_LOG_E("#include %s is circular -- skipping", fileName.c_str());
+			return nullptr;
+		}
+
+		FileView file = Loader::openFile(fileName);
+		if (!file) {
+			NEO_LOG_E("Found #include %s but it's empty? Skipping", fileName.c_str());
+			return nullptr;
+		}
+
+		TRACY_ZONEN("Expand include");
+		Chunk chunk;
+		chunk.mExpanded.reserve(file.size());
+		std::vector<std::string> directIncludes;
+		visiting.push_back(fileName);
+		_expand(file.asString(), &chunk.mExpanded, chunk.mDependencies, directIncludes, visiting);
+		visiting.pop_back();
+
+		for (const std::string& include : directIncludes) {
+			sIncludedBy[include].insert(fileName);
+		}
+		return &sChunks.emplace(fileName, std::move(chunk)).first->second;
+	}
+
+	void ShaderPreprocessor::_expand(std::string_view source, std::string* expanded, std::unordered_set<std::string>& dependencies, std::vector<std::string>& directIncludes, std::vector<std::string>& visiting) {
+		size_t start = 0;
+		while (start < source.size()) {
+			size_t end = source.find('\n', start);
+			const bool lastLine = end == std::string_view::npos;
+			if (lastLine) {
+				end = source.size();
+			}
+			std::string_view line = source.substr(start, end - start);
+
+			std::string_view::size_type nameStart = line.find(sIncludeToken);
+			std::string_view::size_type nameEnd = nameStart != std::string_view::npos ? line.find('"', nameStart + sIncludeToken.size()) : std::string_view::npos;
+			if (nameEnd != std::string_view::npos) {
+				// The whole line gets replaced with the included source
+				std::string includedFile(line.substr(nameStart + sIncludeToken.size(), nameEnd - nameStart - sIncludeToken.size()));
+				const Chunk* chunk = _chunk(includedFile, visiting);
+				if (chunk) {
+					if (expanded) {
+						expanded->append(chunk->mExpanded);
+					}
+					dependencies.insert(chunk->mDependencies.begin(), chunk->mDependencies.end());
+				}
+				dependencies.insert(includedFile);
+				directIncludes.push_back(std::move(includedFile));
+			}
+			else if (expanded) {
+				expanded->append(line);
+			}
+
+			if (expanded && !lastLine) {
+				expanded->push_back('\n');
+			}
+			start = end + 1;
+		}
+	}
+}
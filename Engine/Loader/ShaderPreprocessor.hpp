@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace neo {
+
+	// Expands #includes. Every include is expanded once and cached along with everything it pulls in,
+	// so resolving more variants is a single linear pass over the top level source
+	class ShaderPreprocessor {
+	public:
+		// Every shader gets universal.glsl up top
+		static std::string expand(std::string_view source);
+		// Every file the source includes, directly or not
+		static void collectDependencies(std::string_view source, std::unordered_set<std::string>& dependencies);
+
+		// Drops cached expansions of the changed files and everything that includes them.
+		// Returns the changed files along with every file that includes one of them
+		static std::unordered_set<std::string> invalidate(const std::vector<std::string>& changedFiles);
+		static void clear();
+
+	private:
+		struct Chunk {
+			std::string mExpanded;
+			std::unordered_set<std::string> mDependencies;
+		};
+
+		static std::mutex sMutex;
+		static std::unordered_map<std::string, Chunk> sChunks;
+		static std::unordered_map<std::string, std::unordered_set<std::string>> sIncludedBy;
+
+		static const Chunk* _chunk(const std::string& fileName, std::vector<std::string>& visiting);
+		static void _expand(std::string_view source, std::string* expanded, std::unordered_set<std::string>& dependencies, std::vector<std::string>& directIncludes, std::vector<std::string>& visiting);
+	};
+}
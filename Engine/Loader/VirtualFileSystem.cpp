@@ -0,0 +1,348 @@
+#include "Loader/pch.hpp"
+#include "VirtualFileSystem.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace neo {
+
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile() {
+#ifdef _WIN32
+			if (mData) {
+				UnmapViewOfFile(mData);
+			}
+			if (mMapping) {
+				CloseHandle(mMapping);
+			}
+			if (mFile != INVALID_HANDLE_VALUE) {
+				CloseHandle(mFile);
+			}
+#else
+			if (mData) {
+				munmap(const_cast<uint8_t*>(mData), mSize);
+			}
+#endif
+		}
+
+		static std::shared_ptr<const MappedFile> open(const std::string& path) {
+			TRACY_ZONE();
+			auto file = std::make_shared<MappedFile>();
+#ifdef _WIN32
+			file->mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file->mFile == INVALID_HANDLE_VALUE) {
+				return nullptr;
+			}
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file->mFile, &size)) {
+				return nullptr;
+			}
+			file->mSize = static_cast<size_t>(size.QuadPart);
+			if (file->mSize == 0) {
+				return file; // Can't map an empty file
+			}
+			file->mMapping = CreateFileMappingA(file->mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!file->mMapping) {
+				return nullptr;
+			}
+			file->mData = static_cast<const uint8_t*>(MapViewOfFile(file->mMapping, FILE_MAP_READ, 0, 0, 0));
+			if (!file->mData) {
+				return nullptr;
+			}
+#else
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0) {
+				return nullptr;
+			}
+			struct stat info;
+			if (fstat(fd, &info) != 0) {
+				close(fd);
+				return nullptr;
+			}
+			file->mSize = static_cast<size_t>(info.st_size);
+			if (file->mSize) {
+				void* data = mmap(nullptr, file->mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED) {
+					close(fd);
+					return nullptr;
+				}
+				file->mData = static_cast<const uint8_t*>(data);
+			}
+			close(fd);
+#endif
+			return file;
+		}
+
+		const uint8_t* mData = nullptr;
+		size_t mSize = 0;
+
+	private:
+#ifdef _WIN32
+		HANDLE mFile = INVALID_HANDLE_VALUE;
+		HANDLE mMapping = nullptr;
+#endif
+	};
+
+	namespace {
+		constexpr uint32_t sPackMagic = 0x4b41504e; // "NPAK"
+		constexpr uint32_t sPackVersion = 1;
+		constexpr uint64_t sPackAlignment = 16;
+
+		struct PackHeader {
+			uint32_t mMagic = sPackMagic;
+			uint32_t mVersion = sPackVersion;
+			uint32_t mEntryCount = 0;
+			uint32_t mReserved = 0;
+		};
+
+		std::string _normalize(const std::string& fileName) {
+			std::string normalized = fileName;
+			std::replace(normalized.begin(), normalized.end(), '\\', '/');
+			return normalized;
+		}
+
+		bool _isFile(const std::string& path) {
+			struct stat info;
+			return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFREG;
+		}
+
+		template<typename T>
+		bool _readPOD(const uint8_t* data, size_t size, size_t& cursor, T& out) {
+			if (cursor + sizeof(T) > size) {
+				return false;
+			}
+			memcpy(&out, data + cursor, sizeof(T));
+			cursor += sizeof(T);
+			return true;
+		}
+
+		template<typename T>
+		void _writePOD(std::ofstream& out, const T& value) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+	}
+
+	void VirtualFileSystem::mountDirectory(const std::string& dir) {
+		std::unique_lock lock(mMutex);
+		mDirectories.push_back(dir);
+		mResolved.clear();
+	}
+
+	bool VirtualFileSystem::mountPack(const std::string& packPath) {
+		TRACY_ZONE();
+		Pack pack;
+		pack.mPath = packPath;
+		pack.mModTime = util::getFileModTime(packPath.c_str());
+		pack.mMapping = MappedFile::open(packPath);
+		if (!pack.mMapping) {
+			NEO_LOG_E("Unable to open pack %s", packPath.c_str());
+			return false;
+		}
+
+		const uint8_t* data = pack.mMapping->mData;
+		const size_t size = pack.mMapping->mSize;
+		size_t cursor = 0;
+		PackHeader header;
+		if (!_readPOD(data, size, cursor, header) || header.mMagic != sPackMagic || header.mVersion != sPackVersion) {
+			NEO_LOG_E("%s isn't a valid pack", packPath.c_str());
+			return false;
+		}
+		pack.mEntries.reserve(header.mEntryCount);
+		for (uint32_t i = 0; i < header.mEntryCount; i++) {
+			uint32_t pathLength = 0;
+			PackEntry entry;
+			if (!_readPOD(data, size, cursor, pathLength) || cursor + pathLength > size) {
+				NEO_LOG_E("%s has a truncated index", packPath.c_str());
+				return false;
+			}
+			std::string path(reinterpret_cast<const char*>(data + cursor), pathLength);
+			cursor += pathLength;
+			if (!_readPOD(data, size, cursor, entry.mOffset) || !_readPOD(data, size, cursor, entry.mSize) || entry.mOffset + entry.mSize > size) {
+				NEO_LOG_E("%s has a truncated index", packPath.c_str());
+				return false;
+			}
+			pack.mEntries.emplace(std::move(path), entry);
+		}
+
+		NEO_LOG_I("Mounted pack %s with %d files", packPath.c_str(), header.mEntryCount);
+		std::unique_lock lock(mMutex);
+		mPacks.push_back(std::move(pack));
+		mResolved.clear();
+		return true;
+	}
+
+	void VirtualFileSystem::unmountAll() {
+		std::unique_lock lock(mMutex);
+		mDirectories.clear();
+		mPacks.clear(); // Outstanding views keep their pack's mapping alive
+		mResolved.clear();
+	}
+
+	std::optional<ResolvedFile> VirtualFileSystem::resolve(const std::string& fileName) const {
+		const std::string key = _normalize(fileName);
+		{
+			std::shared_lock lock(mMutex);
+			auto it = mResolved.find(key);
+			if (it != mResolved.end()) {
+				return it->second;
+			}
+		}
+
+		TRACY_ZONE();
+		std::unique_lock lock(mMutex);
+		// Someone else might've resolved it while we were waiting
+		auto it = mResolved.find(key);
+		if (it != mResolved.end()) {
+			return it->second;
+		}
+
+		ResolvedFile resolved;
+		bool found = false;
+		for (const std::string& dir : mDirectories) {
+			resolved.mPath = dir + key;
+			if (_isFile(resolved.mPath)) {
+				found = true;
+				break;
+			}
+		}
+		for (int i = 0; !found && i < static_cast<int>(mPacks.size()); i++) {
+			auto entry = mPacks[i].mEntries.find(key);
+			if (entry != mPacks[i].mEntries.end()) {
+				resolved.mPath = mPacks[i].mPath;
+				resolved.mPack = i;
+				resolved.mOffset = entry->second.mOffset;
+				resolved.mSize = entry->second.mSize;
+				found = true;
+			}
+		}
+
+		// Misses aren't cached so files that show up later still get found
+		if (!found) {
+			return std::nullopt;
+		}
+		mResolved.emplace(key, resolved);
+		return resolved;
+	}
+
+	FileView VirtualFileSystem::open(const std::string& fileName) const {
+		FileView view;
+		auto resolved = resolve(fileName);
+		if (!resolved) {
+			return view;
+		}
+
+		if (resolved->isPacked()) {
+			std::shared_lock lock(mMutex);
+			if (resolved->mPack < static_cast<int>(mPacks.size()) && mPacks[resolved->mPack].mPath == resolved->mPath) {
+				view.mMapping = mPacks[resolved->mPack].mMapping;
+				view.mData = view.mMapping->mData + resolved->mOffset;
+				view.mSize = static_cast<size_t>(resolved->mSize);
+			}
+			return view;
+		}
+
+		view.mMapping = MappedFile::open(resolved->mPath);
+		if (!view.mMapping) {
+			// Stale resolve -- the file moved or was deleted
+			invalidate(fileName);
+			return view;
+		}
+		view.mData = view.mMapping->mData;
+		view.mSize = view.mMapping->mSize;
+		return view;
+	}
+
+	time_t VirtualFileSystem::getModTime(const std::string& fileName) const {
+		auto resolved = resolve(fileName);
+		if (!resolved) {
+			return 0;
+		}
+		if (resolved->isPacked()) {
+			std::shared_lock lock(mMutex);
+			return resolved->mPack < static_cast<int>(mPacks.size()) ? mPacks[resolved->mPack].mModTime : 0;
+		}
+		return util::getFileModTime(resolved->mPath.c_str());
+	}
+
+	void VirtualFileSystem::invalidate(const std::string& fileName) const {
+		std::unique_lock lock(mMutex);
+		mResolved.erase(_normalize(fileName));
+	}
+
+	bool VirtualFileSystem::writePack(const std::string& packPath, const std::string& rootDir) {
+		TRACY_ZONE();
+		namespace fs = std::filesystem;
+		std::error_code error;
+		std::vector<std::pair<std::string, fs::path>> files;
+		for (const auto& entry : fs::recursive_directory_iterator(rootDir, error)) {
+			if (entry.is_regular_file()) {
+				files.emplace_back(_normalize(fs::relative(entry.path(), rootDir).generic_string()), entry.path());
+			}
+		}
+		if (error) {
+			NEO_LOG_E("Unable to walk %s: %s", rootDir.c_str(), error.message().c_str());
+			return false;
+		}
+
+		// Index goes up front so mounting only touches the first few pages
+		uint64_t offset = sizeof(PackHeader);
+		for (const auto& [name, path] : files) {
+			offset += sizeof(uint32_t) + name.size() + 2 * sizeof(uint64_t);
+		}
+		std::vector<PackEntry> entries;
+		entries.reserve(files.size());
+		for (const auto& [name, path] : files) {
+			offset = (offset + sPackAlignment - 1) & ~(sPackAlignment - 1);
+			entries.push_back({ offset, static_cast<uint64_t>(fs::file_size(path)) });
+			offset += entries.back().mSize;
+		}
+
+		std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			NEO_LOG_E("Unable to write pack %s", packPath.c_str());
+			return false;
+		}
+		PackHeader header;
+		header.mEntryCount = static_cast<uint32_t>(files.size());
+		_writePOD(out, header);
+		for (size_t i = 0; i < files.size(); i++) {
+			_writePOD(out, static_cast<uint32_t>(files[i].first.size()));
+			out.write(files[i].first.data(), files[i].first.size());
+			_writePOD(out, entries[i].mOffset);
+			_writePOD(out, entries[i].mSize);
+		}
+		for (size_t i = 0; i < files.size(); i++) {
+			const uint64_t padding = entries[i].mOffset - static_cast<uint64_t>(out.tellp());
+			for (uint64_t p = 0; p < padding; p++) {
+				out.put(0);
+			}
+			auto contents = MappedFile::open(files[i].second.string());
+			if (!contents || contents->mSize != entries[i].mSize) {
+				NEO_LOG_E("Unable to read %s while packing", files[i].second.string().c_str());
+				return false;
+			}
+			out.write(reinterpret_cast<const char*>(contents->mData), contents->mSize);
+		}
+
+		NEO_LOG_I("Packed %d files from %s into %s", static_cast<int>(files.size()), rootDir.c_str(), packPath.c_str());
+		return static_cast<bool>(out);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace neo {
+
+	class MappedFile;
+
+	// Read-only view of a file's contents. Directory files are mapped on open, pack files point into the pack's mapping
+	// Copies share the mapping, which stays alive until the last view goes away
+	class FileView {
+		friend class VirtualFileSystem;
+	public:
+		FileView() = default;
+
+		const uint8_t* data() const { return mData; }
+		size_t size() const { return mSize; }
+		std::string_view asString() const { return std::string_view(reinterpret_cast<const char*>(mData), mSize); }
+		explicit operator bool() const { return mMapping != nullptr; }
+
+	private:
+		std::shared_ptr<const MappedFile> mMapping;
+		const uint8_t* mData = nullptr;
+		size_t mSize = 0;
+	};
+
+	struct ResolvedFile {
+		std::string mPath; // Full path on disk -- the pack's path for packed files
+		int mPack = -1;
+		uint64_t mOffset = 0;
+		uint64_t mSize = 0;
+
+		bool isPacked() const { return mPack >= 0; }
+	};
+
+	// Directories are searched in mount order, then packs in mount order
+	class VirtualFileSystem {
+	public:
+		VirtualFileSystem() = default;
+		~VirtualFileSystem() = default;
+		VirtualFileSystem(const VirtualFileSystem&) = delete;
+		VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+		void mountDirectory(const std::string& dir);
+		bool mountPack(const std::string& packPath);
+		void unmountAll();
+
+		std::optional<ResolvedFile> resolve(const std::string& fileName) const;
+		FileView open(const std::string& fileName) const;
+		// Not cached -- hot reload needs to see edits
+		time_t getModTime(const std::string& fileName) const;
+		// Drop a cached resolve, ie when a file gets added or removed on disk
+		void invalidate(const std::string& fileName) const;
+
+		// Packs every file under rootDir. Paths are stored relative to rootDir
+		static bool writePack(const std::string& packPath, const std::string& rootDir);
+
+	private:
+		struct PackEntry {
+			uint64_t mOffset = 0;
+			uint64_t mSize = 0;
+		};
+		struct Pack {
+			std::string mPath;
+			time_t mModTime = 0;
+			std::shared_ptr<const MappedFile> mMapping;
+			std::unordered_map<std::string, PackEntry> mEntries;
+		};
+
+		std::vector<std::string> mDirectories;
+		std::vector<Pack> mPacks;
+
+		mutable std::shared_mutex mMutex;
+		mutable std::unordered_map<std::string, ResolvedFile> mResolved;
+	};
+}
@@ -100,7 +100,12 @@ namespace neo {
 
 		mTextures.emplace_back(id);
 		bind();
-		glFramebufferTexture2D(GL_FRAMEBUFFER, _getGLAttachment(attachment, mColorAttachments - 1), _getGLTarget(target), texture.mTextureID, mip);
+		if (target == types::framebuffer::AttachmentTarget::TargetLayered) {
+			glFramebufferTexture(GL_FRAMEBUFFER, _getGLAttachment(attachment, mColorAttachments - 1), texture.mTextureID, mip);
+		}
+		else {
+			glFramebufferTexture2D(GL_FRAMEBUFFER, _getGLAttachment(attachment, mColorAttachments - 1), _getGLTarget(target), texture.mTextureID, mip);
+		}
 		CHECK_GL_FRAMEBUFFER();
 	}
 
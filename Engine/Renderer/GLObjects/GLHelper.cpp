@@ -120,6 +120,10 @@ namespace neo {
 				return GL_DOUBLE;
 			case types::ByteFormats::Float:
 				return GL_FLOAT;
+			case types::ByteFormats::HalfFloat:
+				return GL_HALF_FLOAT;
+			case types::ByteFormats::Int2_10_10_10_Rev:
+				return GL_INT_2_10_10_10_REV;
 			default:
 				NEO_FAIL("Invalid byte format");
 				return GL_FLOAT;
@@ -8,6 +8,18 @@
 
 namespace neo {
 	namespace {
+		// Generic attributes that model.vert reads for position dequantization
+		const GLuint sPositionScaleLocation = 4;
+		const GLuint sPositionBiasLocation = 5;
+
+		void _setAttribPointer(const VertexBuffer& vertexBuffer, uint32_t baseOffset) {
+			glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.vboID);
+#pragma warning(push)
+#pragma warning(disable: 4312)
+			glVertexAttribPointer(vertexBuffer.attribArray, vertexBuffer.components, vertexBuffer.format, vertexBuffer.normalized ? GL_TRUE : GL_FALSE, vertexBuffer.stride, reinterpret_cast<uint8_t*>(NULL + baseOffset + vertexBuffer.attribOffset));
+#pragma warning(pop)
+		}
+
 		GLenum _translatePrimitive(types::mesh::Primitive primitive) {
 			switch (primitive) {
 			case types::mesh::Primitive::Points:
@@ -45,11 +57,15 @@ namespace neo {
 
 		glBindVertexArray(mVAOID);
 
+		// Generic attribute values aren't VAO state, so every draw resets them
+		glVertexAttrib3fv(sPositionScaleLocation, &mPositionScale[0]);
+		glVertexAttrib3fv(sPositionBiasLocation, &mPositionBias[0]);
+
 		const auto& positions = getVBO(types::mesh::VertexType::Position);
 		if (mElementVBO) {
 			uint32_t usedSize = size ? size : mElementVBO->elementCount;
 			ServiceLocator<Renderer>::ref().mStats.mNumPrimitives += usedSize / positions.components;
-			glDrawElements(_translatePrimitive(mPrimitiveType), usedSize, mElementVBO->format, reinterpret_cast<void*>(offset));
+			glDrawElements(_translatePrimitive(mPrimitiveType), usedSize, mElementVBO->format, reinterpret_cast<void*>(static_cast<uintptr_t>(mElementVBO->offset) + offset));
 		}
 		else if (size) {
 			ServiceLocator<Renderer>::ref().mStats.mNumPrimitives += size / positions.components;
@@ -70,6 +86,8 @@ namespace neo {
 		vertexBuffer.components = components;
 		vertexBuffer.elementCount = count;
 		vertexBuffer.format = GLHelper::getGLByteFormat(format);
+		vertexBuffer.normalized = normalized;
+		vertexBuffer.attribOffset = offset;
 
 		glBindVertexArray(mVAOID);
 		glGenBuffers(1, (GLuint*)&vertexBuffer.vboID);
@@ -78,6 +96,7 @@ namespace neo {
 		if (byteSize) {
 			glBufferData(GL_ARRAY_BUFFER, byteSize, buffer, GL_STATIC_DRAW);
 		}
+		vertexBuffer.byteSize = byteSize;
 		glEnableVertexAttribArray(vertexBuffer.attribArray);
 		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.vboID);
 
@@ -93,6 +112,7 @@ namespace neo {
 		const auto& vbo = mVBOs.find(type);
 		NEO_ASSERT(vbo != mVBOs.end(), "Attempting to update a VertexBuffer that doesn't exist");
 		auto& vertexBuffer = vbo->second;
+		NEO_ASSERT(!vertexBuffer.streamed, "Attempting to update a streamed VertexBuffer");
 		vertexBuffer.elementCount = count;
 
 		glBindVertexArray(mVAOID);
@@ -100,6 +120,85 @@ namespace neo {
 		if (byteSize) {
 			TRACY_GPUN("glBufferData");
 			glBufferData(GL_ARRAY_BUFFER, byteSize, data, GL_DYNAMIC_DRAW);
+			vertexBuffer.byteSize = byteSize;
+		}
+	}
+
+	void Mesh::streamVertexBuffer(types::mesh::VertexType type, uint32_t count, uint32_t byteSize, const uint8_t* data) {
+		const auto& vbo = mVBOs.find(type);
+		NEO_ASSERT(vbo != mVBOs.end(), "Attempting to stream a VertexBuffer that doesn't exist");
+		auto& vertexBuffer = vbo->second;
+		vertexBuffer.elementCount = count;
+
+		// First stream swaps the static storage out
+		if (!vertexBuffer.streamed) {
+			glDeleteBuffers(1, (GLuint*)&vertexBuffer.vboID);
+			vertexBuffer.streamed = true;
+		}
+		vertexBuffer.offset = vertexBuffer.stream.write(data, byteSize);
+		vertexBuffer.vboID = vertexBuffer.stream.mBufferID;
+
+		// The attribute has to follow the data around the ring
+		glBindVertexArray(mVAOID);
+		_setAttribPointer(vertexBuffer, vertexBuffer.offset);
+	}
+
+	void Mesh::addInterleavedBuffer(uint32_t stride, uint32_t count, uint32_t byteSize, const uint8_t* data) {
+		NEO_ASSERT(!mInterleavedVBO.has_value(), "Attempting to add 2 interleaved buffers");
+
+		mInterleavedVBO = std::make_optional<VertexBuffer>();
+		mInterleavedVBO->stride = stride;
+		mInterleavedVBO->elementCount = count;
+
+		glBindVertexArray(mVAOID);
+		glGenBuffers(1, (GLuint*)&mInterleavedVBO->vboID);
+		glBindBuffer(GL_ARRAY_BUFFER, mInterleavedVBO->vboID);
+		if (byteSize) {
+			glBufferData(GL_ARRAY_BUFFER, byteSize, data, GL_STATIC_DRAW);
+		}
+		mInterleavedVBO->byteSize = byteSize;
+	}
+
+	void Mesh::addInterleavedAttribute(types::mesh::VertexType type, uint32_t components, types::ByteFormats format, bool normalized, uint32_t offset) {
+		NEO_ASSERT(mInterleavedVBO.has_value(), "Attempting to add an interleaved attribute without an interleaved buffer");
+		NEO_ASSERT(mVBOs.find(type) == mVBOs.end(), "Attempting to add a VertexBuffer that already exists");
+
+		auto vertexBuffer = VertexBuffer{};
+		vertexBuffer.vboID = mInterleavedVBO->vboID;
+		vertexBuffer.attribArray = static_cast<uint32_t>(type);
+		vertexBuffer.stride = mInterleavedVBO->stride;
+		vertexBuffer.components = components;
+		vertexBuffer.elementCount = mInterleavedVBO->elementCount * components;
+		vertexBuffer.format = GLHelper::getGLByteFormat(format);
+		vertexBuffer.normalized = normalized;
+		vertexBuffer.attribOffset = offset;
+		vertexBuffer.interleaved = true;
+
+		glBindVertexArray(mVAOID);
+		glEnableVertexAttribArray(vertexBuffer.attribArray);
+		_setAttribPointer(vertexBuffer, mInterleavedVBO->offset);
+
+		mVBOs[type] = vertexBuffer;
+	}
+
+	void Mesh::streamInterleavedBuffer(uint32_t count, uint32_t byteSize, const uint8_t* data) {
+		NEO_ASSERT(mInterleavedVBO.has_value(), "Attempting to stream an interleaved buffer that doesn't exist");
+		mInterleavedVBO->elementCount = count;
+
+		if (!mInterleavedVBO->streamed) {
+			glDeleteBuffers(1, (GLuint*)&mInterleavedVBO->vboID);
+			mInterleavedVBO->streamed = true;
+		}
+		mInterleavedVBO->offset = mInterleavedVBO->stream.write(data, byteSize);
+		mInterleavedVBO->vboID = mInterleavedVBO->stream.mBufferID;
+
+		glBindVertexArray(mVAOID);
+		for (auto&& [type, vertexBuffer] : mVBOs) {
+			if (vertexBuffer.interleaved) {
+				vertexBuffer.vboID = mInterleavedVBO->vboID;
+				vertexBuffer.elementCount = count * vertexBuffer.components;
+				_setAttribPointer(vertexBuffer, mInterleavedVBO->offset);
+			}
 		}
 	}
 
@@ -108,8 +207,16 @@ namespace neo {
 
 		if (vbo != mVBOs.end()) {
 			glBindVertexArray(mVAOID);
-			glBindBuffer(GL_ARRAY_BUFFER, vbo->second.vboID);
-			glDeleteBuffers(1, (GLuint *)&vbo->second.vboID);
+			if (vbo->second.interleaved) {
+				glDisableVertexAttribArray(vbo->second.attribArray);
+			}
+			else if (vbo->second.streamed) {
+				vbo->second.stream.destroy();
+			}
+			else {
+				glBindBuffer(GL_ARRAY_BUFFER, vbo->second.vboID);
+				glDeleteBuffers(1, (GLuint *)&vbo->second.vboID);
+			}
 		}
 		mVBOs.erase(type);
 	}
@@ -118,6 +225,26 @@ namespace neo {
 		return mVBOs.find(type) != mVBOs.end();
 	}
 
+	uint64_t Mesh::getByteSize() const {
+		auto bufferSize = [](const VertexBuffer& buffer) -> uint64_t {
+			return buffer.streamed ? static_cast<uint64_t>(buffer.stream.mRegionSize) * StreamingBuffer::FRAMES_IN_FLIGHT : buffer.byteSize;
+		};
+		uint64_t bytes = 0;
+		for (auto&& [type, buffer] : mVBOs) {
+			// Interleaved attributes all point into the one buffer
+			if (!buffer.interleaved) {
+				bytes += bufferSize(buffer);
+			}
+		}
+		if (mInterleavedVBO) {
+			bytes += bufferSize(*mInterleavedVBO);
+		}
+		if (mElementVBO) {
+			bytes += bufferSize(*mElementVBO);
+		}
+		return bytes;
+	}
+
 	const VertexBuffer& Mesh::getVBO(types::mesh::VertexType type) const {
 		auto vbo = mVBOs.find(type);
 		NEO_ASSERT(vbo != mVBOs.end(), "Attempting to retrieve a VertexBuffer that doesn't exist");
@@ -140,13 +267,38 @@ namespace neo {
 		if (byteSize) {
 			glBufferData(GL_ELEMENT_ARRAY_BUFFER, byteSize, data, GL_STATIC_DRAW);
 		}
+		mElementVBO->byteSize = byteSize;
+	}
+
+	void Mesh::streamElementBuffer(uint32_t count, types::ByteFormats format, uint32_t byteSize, const uint8_t* data) {
+		if (mElementVBO.has_value() && !mElementVBO->streamed) {
+			removeElementBuffer();
+		}
+		if (!mElementVBO.has_value()) {
+			mElementVBO = std::make_optional<VertexBuffer>();
+			mElementVBO->stride = 0;
+			mElementVBO->components = 1;
+			mElementVBO->streamed = true;
+		}
+		mElementVBO->elementCount = count;
+		mElementVBO->format = GLHelper::getGLByteFormat(format);
+		mElementVBO->offset = mElementVBO->stream.write(data, byteSize);
+		mElementVBO->vboID = mElementVBO->stream.mBufferID;
+
+		glBindVertexArray(mVAOID);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementVBO->vboID);
 	}
 
 	void Mesh::removeElementBuffer() {
 		if (mElementVBO.has_value()) {
 			glBindVertexArray(mVAOID);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementVBO->vboID);
-			glDeleteBuffers(1, (GLuint *)&mElementVBO->vboID);
+			if (mElementVBO->streamed) {
+				mElementVBO->stream.destroy();
+			}
+			else {
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementVBO->vboID);
+				glDeleteBuffers(1, (GLuint *)&mElementVBO->vboID);
+			}
 			mElementVBO = std::nullopt;
 		}
 
@@ -155,11 +307,37 @@ namespace neo {
 		}
 	}
 
+	void Mesh::copyVertexBuffer(types::mesh::VertexType type, uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize) {
+		const auto& vbo = mVBOs.find(type);
+		NEO_ASSERT(vbo != mVBOs.end() && !vbo->second.streamed && !vbo->second.interleaved, "Attempting to copy into an invalid VertexBuffer");
+		glCopyNamedBufferSubData(srcBufferID, vbo->second.vboID, srcOffset, 0, byteSize);
+	}
+
+	void Mesh::copyInterleavedBuffer(uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize) {
+		NEO_ASSERT(mInterleavedVBO.has_value() && !mInterleavedVBO->streamed, "Attempting to copy into an invalid interleaved buffer");
+		glCopyNamedBufferSubData(srcBufferID, mInterleavedVBO->vboID, srcOffset, 0, byteSize);
+	}
+
+	void Mesh::copyElementBuffer(uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize) {
+		NEO_ASSERT(mElementVBO.has_value() && !mElementVBO->streamed, "Attempting to copy into an invalid ElementBuffer");
+		glCopyNamedBufferSubData(srcBufferID, mElementVBO->vboID, srcOffset, 0, byteSize);
+	}
+
 	void Mesh::clear() {
 		for (int i = 0; i < static_cast<int>(types::mesh::VertexType::COUNT); i++) {
 			removeVertexBuffer(static_cast<types::mesh::VertexType>(i));
 		}
 		removeElementBuffer();
+
+		if (mInterleavedVBO.has_value()) {
+			if (mInterleavedVBO->streamed) {
+				mInterleavedVBO->stream.destroy();
+			}
+			else {
+				glDeleteBuffers(1, (GLuint*)&mInterleavedVBO->vboID);
+			}
+			mInterleavedVBO = std::nullopt;
+		}
 	}
 
 	void Mesh::init(const std::optional<std::string>& debugName) {
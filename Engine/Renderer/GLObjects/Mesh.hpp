@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Renderer/Types.hpp"
+#include "Renderer/GLObjects/StreamingBuffer.hpp"
 
 #include <optional>
 #include <unordered_map>
@@ -15,6 +16,15 @@ namespace neo {
 		uint32_t stride = 0;
 		uint32_t elementCount = 0;
 		uint32_t format = 0;
+		bool normalized = false;
+		uint32_t attribOffset = 0;
+		bool interleaved = false; // vboID belongs to the mesh's interleaved buffer
+		uint32_t byteSize = 0; // Allocated storage, for stats
+
+		// Streamed buffers live in vboID at a byte offset that moves every update
+		bool streamed = false;
+		uint32_t offset = 0;
+		StreamingBuffer stream;
 	};
 
 	class Mesh {
@@ -28,16 +38,35 @@ namespace neo {
 			/* VBOs */
 			void addVertexBuffer(types::mesh::VertexType type, uint32_t components, uint32_t stride, types::ByteFormats format, bool normalized, uint32_t count, uint32_t offset, uint32_t byteSize, const uint8_t* data = nullptr);
 			void updateVertexBuffer(types::mesh::VertexType type, uint32_t count, uint32_t byteSize, const uint8_t* data);
+			// For buffers that are rewritten often -- writes into persistently mapped storage instead of reallocating
+			void streamVertexBuffer(types::mesh::VertexType type, uint32_t count, uint32_t byteSize, const uint8_t* data);
 			void removeVertexBuffer(types::mesh::VertexType type);
 
+			/* Single VBO shared by several attributes */
+			void addInterleavedBuffer(uint32_t stride, uint32_t count, uint32_t byteSize, const uint8_t* data = nullptr);
+			void addInterleavedAttribute(types::mesh::VertexType type, uint32_t components, types::ByteFormats format, bool normalized, uint32_t offset);
+			void streamInterleavedBuffer(uint32_t count, uint32_t byteSize, const uint8_t* data);
+
 			void addElementBuffer(uint32_t count, types::ByteFormats format, uint32_t byteSize, const uint8_t* data = nullptr);
+			void streamElementBuffer(uint32_t count, types::ByteFormats format, uint32_t byteSize, const uint8_t* data);
 			void removeElementBuffer();
 
+			/* Fill buffers that were added without data from another GL buffer -- used by staged uploads */
+			void copyVertexBuffer(types::mesh::VertexType type, uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize);
+			void copyInterleavedBuffer(uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize);
+			void copyElementBuffer(uint32_t srcBufferID, uint32_t srcOffset, uint32_t byteSize);
+
 			bool hasVBO(types::mesh::VertexType type) const;
+			// GPU storage across every buffer
+			uint64_t getByteSize() const;
 			const VertexBuffer& getVBO(types::mesh::VertexType type) const;
 
 			types::mesh::Primitive mPrimitiveType = types::mesh::Primitive::TriangleStrip;
 
+			// Dequantizes normalized 16-bit positions in the vertex shader -- identity for float positions
+			glm::vec3 mPositionScale = glm::vec3(1.f);
+			glm::vec3 mPositionBias = glm::vec3(0.f);
+
 			void draw(uint32_t = 0, uint16_t = 0) const;
 
 			void init(const std::optional<std::string>& debugName);
@@ -47,6 +76,7 @@ namespace neo {
 		private:
 			std::unordered_map<types::mesh::VertexType, VertexBuffer> mVBOs;
 			std::optional<VertexBuffer> mElementVBO;
+			std::optional<VertexBuffer> mInterleavedVBO;
 			
 	};
 }
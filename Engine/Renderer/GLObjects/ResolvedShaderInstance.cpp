@@ -8,7 +8,7 @@
 #include "Renderer/GLObjects/Texture.hpp"
 
 #include "Util/Util.hpp"
-#include "Loader/Loader.hpp"
+#include "Loader/ShaderPreprocessor.hpp"
 
 namespace neo {
 	namespace {
@@ -65,41 +65,8 @@ namespace neo {
 			if (!shaderString) {
 				return "";
 			}
-			std::string sourceString(shaderString);
-			sourceString = "#include \"universal.glsl\"\n" + sourceString;
-
 			// Handle #includes 
-			{
-				TRACY_ZONEN("Handle includes");
-				std::string::size_type start = 0;
-				std::string::size_type end = 0;
-				while ((end = sourceString.find("\n", start)) != std::string::npos) {
-					std::string line = sourceString.substr(start, end - start);
-
-					// Find name
-					std::string::size_type nameStart = line.find("#include \"");
-					std::string::size_type nameEnd = line.find("\"", nameStart + 10);
-					if (nameStart != std::string::npos && nameEnd != std::string::npos && nameStart != nameEnd) {
-						std::string includedFile = line.substr(nameStart + 10, nameEnd - nameStart - 10);
-						const char* includedFileSrc = Loader::loadFileString(includedFile.c_str());
-
-						sourceString.erase(start, end - start);
-						if (includedFileSrc) {
-							// Replace include with source
-							sourceString.insert(start, includedFileSrc);
-							delete includedFileSrc;
-						}
-						else {
-							NEO_LOG_E("Found #include %s but it's empty? Skipping", includedFile.c_str());
-						}
-
-						// Reset processing incase there are internal #includes
-						start = end = 0;
-
-					}
-					start = end + 1;
-				}
-			}
+			std::string sourceString = ShaderPreprocessor::expand(shaderString);
 
 			// #version, #defines
 			std::stringstream preambleBuilder;
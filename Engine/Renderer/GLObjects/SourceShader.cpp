@@ -13,11 +13,15 @@ namespace neo {
 		, mShaderSources(sources) {
 	}
 
-	void SourceShader::destroy() {
+	void SourceShader::destroyVariants() {
 		for (auto& instance : mResolvedShaders) {
 			instance.second.destroy();
 		}
 		mResolvedShaders.clear();
+	}
+
+	void SourceShader::destroy() {
+		destroyVariants();
 		mShaderSources.clear();
 	}
 
@@ -25,6 +25,8 @@ namespace neo {
 		SourceShader(const char* name, const ShaderCode& args);
 
 		const ResolvedShaderInstance& getResolvedInstance(const ShaderDefines& defines) const;
+		// Variants get rebuilt the next time they're asked for
+		void destroyVariants();
 		void destroy();
 	private:
 		std::string mName;
@@ -0,0 +1,86 @@
+#include "Renderer/pch.hpp"
+#include "StreamingBuffer.hpp"
+
+#include "GL/glew.h"
+
+namespace neo {
+	namespace {
+		const GLbitfield sMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const uint32_t sMinRegionSize = 256;
+	}
+
+	uint64_t StreamingBuffer::sFrame = 0;
+	std::array<void*, StreamingBuffer::FRAMES_IN_FLIGHT> StreamingBuffer::sFences = {};
+
+	void StreamingBuffer::beginFrame() {
+		void*& fence = sFences[sFrame % FRAMES_IN_FLIGHT];
+		if (!fence) {
+			return;
+		}
+
+		TRACY_ZONEN("Wait for streaming fence");
+		GLsync sync = static_cast<GLsync>(fence);
+		GLenum result = glClientWaitSync(sync, 0, 0);
+		while (result == GL_TIMEOUT_EXPIRED) {
+			result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+		NEO_ASSERT(result != GL_WAIT_FAILED, "Failed waiting on streaming fence");
+		glDeleteSync(sync);
+		fence = nullptr;
+	}
+
+	void StreamingBuffer::endFrame() {
+		sFences[sFrame % FRAMES_IN_FLIGHT] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		sFrame++;
+	}
+
+	void StreamingBuffer::init(uint32_t regionSize) {
+		NEO_ASSERT(!mBufferID, "StreamingBuffer already initialized");
+
+		// Keep regions aligned for any attribute or index format
+		mRegionSize = std::max(sMinRegionSize, regionSize);
+		mRegionSize = (mRegionSize + sMinRegionSize - 1) & ~(sMinRegionSize - 1);
+
+		glCreateBuffers(1, &mBufferID);
+		glNamedBufferStorage(mBufferID, static_cast<GLsizeiptr>(mRegionSize) * FRAMES_IN_FLIGHT, nullptr, sMapFlags);
+		mMappedData = static_cast<uint8_t*>(glMapNamedBufferRange(mBufferID, 0, static_cast<GLsizeiptr>(mRegionSize) * FRAMES_IN_FLIGHT, sMapFlags));
+		NEO_ASSERT(mMappedData, "Failed to map streaming buffer");
+		mRegion = 0;
+		mLastWriteFrame = UINT64_MAX;
+	}
+
+	void StreamingBuffer::destroy() {
+		if (mBufferID) {
+			glUnmapNamedBuffer(mBufferID);
+			glDeleteBuffers(1, &mBufferID);
+		}
+		mBufferID = 0;
+		mRegionSize = 0;
+		mMappedData = nullptr;
+	}
+
+	uint32_t StreamingBuffer::write(const uint8_t* data, uint32_t byteSize) {
+		if (!mBufferID || byteSize > mRegionSize) {
+			// Old storage is kept alive by the driver until the GPU is done with it
+			TRACY_ZONEN("Grow streaming buffer");
+			uint32_t regionSize = std::max(mRegionSize, sMinRegionSize);
+			while (regionSize < byteSize) {
+				regionSize *= 2;
+			}
+			destroy();
+			init(regionSize);
+		}
+
+		// Multiple writes in one frame land in the same region -- the GPU hasn't seen this frame's data yet
+		if (mLastWriteFrame != sFrame) {
+			mRegion = (mRegion + 1) % FRAMES_IN_FLIGHT;
+			mLastWriteFrame = sFrame;
+		}
+
+		const uint32_t offset = mRegion * mRegionSize;
+		if (data && byteSize) {
+			memcpy(mMappedData + offset, data, byteSize);
+		}
+		return offset;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace neo {
+
+	// Persistently mapped buffer for data that gets rewritten from the CPU
+	// Storage is split into one region per frame in flight and writes rotate through them, so the GPU can keep reading older regions
+	// beginFrame/endFrame fence the whole frame -- at most one region is written per frame
+	class StreamingBuffer {
+	public:
+		static constexpr uint8_t FRAMES_IN_FLIGHT = 3;
+
+		// Blocks until the GPU is done with the frame that last used the regions about to be written
+		static void beginFrame();
+		static void endFrame();
+
+		void init(uint32_t regionSize);
+		void destroy();
+
+		// Returns the byte offset of the data within mBufferID. Grows the storage if needed, which can change mBufferID
+		uint32_t write(const uint8_t* data, uint32_t byteSize);
+
+		uint32_t mBufferID = 0;
+		uint32_t mRegionSize = 0;
+
+	private:
+		uint8_t* mMappedData = nullptr;
+		uint8_t mRegion = 0;
+		uint64_t mLastWriteFrame = UINT64_MAX;
+
+		static uint64_t sFrame;
+		static std::array<void*, FRAMES_IN_FLIGHT> sFences; // GLsync
+	};
+}
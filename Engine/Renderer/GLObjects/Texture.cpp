@@ -80,6 +80,27 @@ namespace neo {
 			}
 		}
 
+		// Filter + wrap state of the currently bound texture
+		void _applyParameters(const TextureFormat& format) {
+			GLenum target = _getGLTarget(format.mTarget);
+			std::pair<GLenum, GLenum> glFilters = _getGLFilter(format.mFilter);
+			glTexParameteri(target, GL_TEXTURE_MIN_FILTER, glFilters.first);
+			glTexParameteri(target, GL_TEXTURE_MAG_FILTER, glFilters.second);
+			switch (format.mTarget) {
+			case types::texture::Target::Texture3D:
+			case types::texture::Target::TextureCube:
+				glTexParameteri(target, GL_TEXTURE_WRAP_R, _getGLWrap(format.mWrap.mR));
+			case types::texture::Target::Texture2D:
+				glTexParameteri(target, GL_TEXTURE_WRAP_T, _getGLWrap(format.mWrap.mT));
+			case types::texture::Target::Texture1D:
+				glTexParameteri(target, GL_TEXTURE_WRAP_S, _getGLWrap(format.mWrap.mS));
+				break;
+			default:
+				NEO_FAIL("Invalid texture class");
+				break;
+			}
+		}
+
 		GLenum _getGLBaseFormat(types::texture::BaseFormats format) {
 			switch (format) {
 			case types::texture::BaseFormats::R: return GL_RED;
@@ -163,24 +184,8 @@ namespace neo {
 		// }
 
 		// Apply format
-		GLenum target = _getGLTarget(format.mTarget);
-		std::pair<GLenum, GLenum> glFilters = _getGLFilter(mFormat.mFilter);
-		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, glFilters.first);
-		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, glFilters.second);
-		switch (mFormat.mTarget) {
-		case types::texture::Target::Texture3D:
-		case types::texture::Target::TextureCube:
-			glTexParameteri(target, GL_TEXTURE_WRAP_R, _getGLWrap(mFormat.mWrap.mR));
-		case types::texture::Target::Texture2D:
-			glTexParameteri(target, GL_TEXTURE_WRAP_T, _getGLWrap(mFormat.mWrap.mT));
-		case types::texture::Target::Texture1D:
-			glTexParameteri(target, GL_TEXTURE_WRAP_S, _getGLWrap(mFormat.mWrap.mS));
-			break;
-		default:
-			NEO_FAIL("Invalid texture class");
-			break;
-		}
-		
+		_applyParameters(mFormat);
+
 		// Override mips
 		uint16_t maxDim = std::max(mWidth, std::max(mHeight, mDepth));
 		uint16_t mips = 0;
@@ -251,6 +256,85 @@ namespace neo {
 		glGenerateTextureMipmap(mTextureID);
 	}
 
+	void Texture::setResidentMip(uint16_t mip) {
+		NEO_ASSERT(mFormat.mTarget == types::texture::Target::Texture2D, "Only 2D textures can be streamed");
+		NEO_ASSERT(mip < mFormat.mMipCount, "Invalid resident mip %d", mip);
+		if (mip == mResidentMip) {
+			return;
+		}
+
+		// Immutable storage can't grow or shrink in place -- swap in a new texture and carry over the overlapping levels
+		GLuint newTextureID = 0;
+		glGenTextures(1, &newTextureID);
+		glBindTexture(GL_TEXTURE_2D, newTextureID);
+		_applyParameters(mFormat);
+		glTexStorage2D(GL_TEXTURE_2D, mFormat.mMipCount - mip, GLHelper::getGLInternalFormat(mFormat.mInternalFormat), std::max(1, mWidth >> mip), std::max(1, mHeight >> mip));
+
+		for (uint16_t level = std::max(mip, mResidentMip); level < mFormat.mMipCount; level++) {
+			glCopyImageSubData(
+				mTextureID, GL_TEXTURE_2D, level - mResidentMip, 0, 0, 0,
+				newTextureID, GL_TEXTURE_2D, level - mip, 0, 0, 0,
+				std::max(1, mWidth >> level), std::max(1, mHeight >> level), 1
+			);
+		}
+
+		glDeleteTextures(1, &mTextureID);
+		mTextureID = newTextureID;
+		mResidentMip = mip;
+	}
+
+	void Texture::uploadMip(uint16_t mip, const void* data) {
+		NEO_ASSERT(mFormat.mTarget == types::texture::Target::Texture2D, "Only 2D textures can upload single mips");
+		NEO_ASSERT(mip >= mResidentMip && mip < mFormat.mMipCount, "Mip %d isn't resident", mip);
+
+		// Small mips of RGB textures aren't 4 byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(mTextureID, mip - mResidentMip, 0, 0, std::max(1, mWidth >> mip), std::max(1, mHeight >> mip),
+			_getGLBaseFormat(TextureFormat::deriveBaseFormat(mFormat.mInternalFormat)), GLHelper::getGLByteFormat(mFormat.mType), data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void Texture::uploadFromBuffer(uint32_t bufferID, uint32_t offset) {
+		NEO_ASSERT(mFormat.mTarget != types::texture::Target::TextureCube, "Cubemaps can't be uploaded from a buffer");
+
+		const GLenum baseFormat = _getGLBaseFormat(TextureFormat::deriveBaseFormat(mFormat.mInternalFormat));
+		const GLenum type = GLHelper::getGLByteFormat(mFormat.mType);
+		// With a bound unpack buffer the data pointer is an offset into it
+		const void* data = reinterpret_cast<const void*>(static_cast<uintptr_t>(offset));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bufferID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		switch (mFormat.mTarget) {
+		case types::texture::Target::Texture1D:
+			glTextureSubImage1D(mTextureID, 0, 0, mWidth, baseFormat, type, data);
+			break;
+		case types::texture::Target::Texture2D:
+			glTextureSubImage2D(mTextureID, 0, 0, 0, mWidth, mHeight, baseFormat, type, data);
+			break;
+		case types::texture::Target::Texture3D:
+			glTextureSubImage3D(mTextureID, 0, 0, 0, 0, mWidth, mHeight, mDepth, baseFormat, type, data);
+			break;
+		default:
+			NEO_FAIL("Invalid texture class");
+			break;
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void Texture::copyTo(const Texture& destination, uint16_t mip, uint16_t layer) const {
+		NEO_ASSERT(mFormat.mTarget == destination.mFormat.mTarget && mFormat.mInternalFormat == destination.mFormat.mInternalFormat, "Texture copies need matching formats");
+		NEO_ASSERT(mWidth == destination.mWidth && mHeight == destination.mHeight, "Texture copies need matching dimensions");
+		NEO_ASSERT(mip < mFormat.mMipCount && mip < destination.mFormat.mMipCount, "Invalid mip %d", mip);
+
+		GLsizei width = std::max(1, mWidth >> mip);
+		GLsizei height = std::max(1, mHeight >> mip);
+		glCopyImageSubData(
+			mTextureID, _getGLTarget(mFormat.mTarget), mip, 0, 0, layer,
+			destination.mTextureID, _getGLTarget(destination.mFormat.mTarget), mip, 0, 0, layer,
+			width, height, 1
+		);
+	}
+
 	void Texture::destroy() {
 		glDeleteTextures(1, &mTextureID);
 		mTextureID = 0;
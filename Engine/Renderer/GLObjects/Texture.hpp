@@ -70,6 +70,15 @@ namespace neo {
 		void bind() const;
 		void genMips();
 		void destroy();
+		// Copies a single mip/layer into an identically-formatted texture. Cubemap faces are layers
+		void copyTo(const Texture& destination, uint16_t mip = 0, uint16_t layer = 0) const;
+
+		// Streamed textures only keep mips [mResidentMip, mMipCount) in vram. Mip indices are always relative to the full texture
+		void setResidentMip(uint16_t mip);
+		void uploadMip(uint16_t mip, const void* data);
+
+		// Uploads the base level out of a pixel buffer instead of client memory. Not for cubemaps
+		void uploadFromBuffer(uint32_t bufferID, uint32_t offset);
 
 		uint32_t mTextureID = 0;
 		TextureFormat mFormat;
@@ -77,5 +86,6 @@ namespace neo {
 		uint16_t mWidth = 1;
 		uint16_t mHeight = 1;
 		uint16_t mDepth = 0;
+		uint16_t mResidentMip = 0;
 	};
 }
@@ -0,0 +1,132 @@
+#include "Renderer/pch.hpp"
+#include "UploadBuffer.hpp"
+
+#include "GL/glew.h"
+
+namespace neo {
+	namespace {
+		const GLbitfield sMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		// Enough for any pixel or index format
+		const uint32_t sAlignment = 256;
+	}
+
+	void UploadBuffer::init(uint32_t size) {
+		NEO_ASSERT(!mBufferID, "UploadBuffer already initialized");
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mSize = (size + sAlignment - 1) & ~(sAlignment - 1);
+		glCreateBuffers(1, &mBufferID);
+		glNamedBufferStorage(mBufferID, mSize, nullptr, sMapFlags);
+		mMappedData = static_cast<uint8_t*>(glMapNamedBufferRange(mBufferID, 0, mSize, sMapFlags));
+		NEO_ASSERT(mMappedData, "Failed to map upload buffer");
+		mHead = mTail = 0;
+		mAllocations.clear();
+	}
+
+	void UploadBuffer::destroy() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mBufferID) {
+			glUnmapNamedBuffer(mBufferID);
+			glDeleteBuffers(1, &mBufferID);
+		}
+		mBufferID = 0;
+		mSize = 0;
+		mMappedData = nullptr;
+		mHead = mTail = 0;
+		mAllocations.clear();
+	}
+
+	void UploadBuffer::reset() {
+		glFinish();
+		std::lock_guard<std::mutex> lock(mMutex);
+		mHead = mTail = 0;
+		mAllocations.clear();
+	}
+
+	uint8_t* UploadBuffer::allocate(uint32_t byteSize) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		const uint64_t alignedSize = (static_cast<uint64_t>(byteSize) + sAlignment - 1) & ~static_cast<uint64_t>(sAlignment - 1);
+		if (!mMappedData || !byteSize || alignedSize > mSize) {
+			return nullptr;
+		}
+
+		// Allocations never straddle the end of the buffer -- skip ahead to the start instead
+		uint64_t begin = mHead;
+		const uint64_t wrapped = begin % mSize;
+		if (wrapped + alignedSize > mSize) {
+			begin += mSize - wrapped;
+		}
+		if (begin + alignedSize - mTail > mSize) {
+			return nullptr;
+		}
+
+		mAllocations.push_back({ begin, begin + alignedSize, false });
+		mHead = begin + alignedSize;
+		return mMappedData + (begin % mSize);
+	}
+
+	void UploadBuffer::release(const void* data) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		const uint64_t offset = static_cast<const uint8_t*>(data) - mMappedData;
+		for (auto& allocation : mAllocations) {
+			if (allocation.mBegin % mSize == offset && !allocation.mReleased) {
+				allocation.mReleased = true;
+				break;
+			}
+		}
+
+		// Space only comes back in order
+		while (!mAllocations.empty() && mAllocations.front().mReleased) {
+			mTail = mAllocations.front().mEnd;
+			mAllocations.pop_front();
+		}
+	}
+
+	bool UploadBuffer::contains(const void* data) const {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		return mMappedData && bytes >= mMappedData && bytes < mMappedData + mSize;
+	}
+
+	uint32_t UploadBuffer::getOffset(const void* data) const {
+		NEO_ASSERT(contains(data), "Data isn't in the upload buffer");
+		return static_cast<uint32_t>(static_cast<const uint8_t*>(data) - mMappedData);
+	}
+
+	void* UploadBuffer::insertFence() {
+		return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	bool UploadBuffer::pollFence(void*& fence) {
+		if (!fence) {
+			return true;
+		}
+		GLenum result = glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		NEO_ASSERT(result != GL_WAIT_FAILED, "Failed polling upload fence");
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+			deleteFence(fence);
+			return true;
+		}
+		return false;
+	}
+
+	void UploadBuffer::waitFence(void*& fence) {
+		if (!fence) {
+			return;
+		}
+		TRACY_ZONEN("Wait for upload fence");
+		GLsync sync = static_cast<GLsync>(fence);
+		GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		while (result == GL_TIMEOUT_EXPIRED) {
+			result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+		NEO_ASSERT(result != GL_WAIT_FAILED, "Failed waiting on upload fence");
+		deleteFence(fence);
+	}
+
+	void UploadBuffer::deleteFence(void*& fence) {
+		if (fence) {
+			glDeleteSync(static_cast<GLsync>(fence));
+		}
+		fence = nullptr;
+	}
+}
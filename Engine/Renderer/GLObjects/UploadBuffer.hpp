@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace neo {
+
+	// Persistently mapped staging memory for resource uploads
+	// Any thread can allocate and write into it, the render thread then copies out of it with glCopy*/PBO uploads instead of reading client memory
+	// Allocations are carved out of a ring and handed back once the GPU is done with them
+	class UploadBuffer {
+	public:
+		void init(uint32_t size);
+		void destroy();
+		// Drops every allocation. Waits on the GPU since copies could still be reading
+		void reset();
+
+		// Returns nullptr if there isn't room -- callers should fall back to their own memory
+		uint8_t* allocate(uint32_t byteSize);
+		// Call once the GPU is done reading the allocation
+		void release(const void* data);
+
+		bool contains(const void* data) const;
+		uint32_t getOffset(const void* data) const;
+
+		// GLsync helpers for tracking when copies out of the buffer have finished
+		static void* insertFence();
+		// Returns true and deletes the fence once it has been signaled
+		static bool pollFence(void*& fence);
+		static void waitFence(void*& fence);
+		static void deleteFence(void*& fence);
+
+		uint32_t mBufferID = 0;
+		uint32_t mSize = 0;
+
+	private:
+		struct Allocation {
+			uint64_t mBegin = 0;
+			uint64_t mEnd = 0;
+			bool mReleased = false;
+		};
+
+		mutable std::mutex mMutex;
+		uint8_t* mMappedData = nullptr;
+		// Monotonic -- wrapped into the buffer with % mSize
+		uint64_t mHead = 0;
+		uint64_t mTail = 0;
+		std::deque<Allocation> mAllocations;
+	};
+}
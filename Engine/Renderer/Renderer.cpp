@@ -11,6 +11,9 @@
 #include "Renderer/RenderingSystems/ImGuiRenderer.hpp"
 #include "Renderer/RenderingSystems/RenderPass.hpp"
 
+#include "Util/GPUTimers.hpp"
+#include "Util/MemoryTracker.hpp"
+
 #include "ECS/Component/CameraComponent/MainCameraComponent.hpp"
 #include "ECS/Component/CameraComponent/CameraComponent.hpp"
 #include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
@@ -39,6 +42,8 @@
 
 #include <ImGuizmo.h>
 
+#include <fstream>
+
 namespace neo {
 
 	Renderer::Renderer(int GLMajor, int GLMinor) {
@@ -51,6 +56,7 @@ namespace neo {
 
 	Renderer::~Renderer() {
 		mGPUQuery.destroy();
+		util::GPUTimers::destroy();
 	}
 
 	void Renderer::setDemoConfig(IDemo::Config config) {
@@ -83,6 +89,7 @@ namespace neo {
 
 		mGPUQuery.destroy();
 		mGPUQuery.init();
+		util::GPUTimers::destroy();
 
 		glEnable(GL_LINE_SMOOTH);
 		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
@@ -90,6 +97,7 @@ namespace neo {
 
 	void Renderer::render(WindowSurface& window, IDemo* demo, util::Profiler& profiler, const ECS& ecs, ResourceManagers& resourceManagers) {
 		TRACY_GPU();
+		NEO_MEMORY_TAG(Renderer);
 		if (window.isMinimized()) {
 			return;
 		}
@@ -100,38 +108,32 @@ namespace neo {
 		mStats = {};
 
 		auto viewport = std::get<1>(*ecs.cGetComponent<ViewportDetailsComponent>());
-		mSceneColorTextureHandle = resourceManagers.mTextureManager.asyncLoad("Main Color",
-			TextureBuilder{}
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D,
+		if (viewport.mSize.x == 0 || viewport.mSize.y == 0) {
+			return;
+		}
+		// Pooled on format and size, so a resize just picks up different targets instead of dropping the frame
+		// Last frame's scene color is still on screen until the ImGui pass below -- don't let anything render into it first
+		resourceManagers.mTextureManager.holdTransient(mDisplayedSceneColorHandle);
+		mDisplayedSceneColorHandle = NEO_INVALID_HANDLE;
+		const glm::u16vec3 viewportDimension(viewport.mSize.x, viewport.mSize.y, 0);
+		mSceneColorTextureHandle = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D,
 				types::texture::InternalFormats::RGB16_UNORM,
 				{ types::texture::Filters::Linear, types::texture::Filters::Linear },
 				{ types::texture::Wraps::Clamp, types::texture::Wraps::Clamp }
-				})
-			.setDimension(glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0))
+			},
+			viewportDimension
 		);
-		TextureHandle sceneDepthTextureHandle = resourceManagers.mTextureManager.asyncLoad("Main Depth",
-			TextureBuilder{}
-			.setFormat(TextureFormat{ types::texture::Target::Texture2D,
+		TextureHandle sceneDepthTextureHandle = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D,
 				types::texture::InternalFormats::D16,
 				{ types::texture::Filters::Linear, types::texture::Filters::Linear },
 				{ types::texture::Wraps::Clamp, types::texture::Wraps::Clamp }
-				})
-			.setDimension(glm::u16vec3(viewport.mSize.x, viewport.mSize.y, 0))
+			},
+			viewportDimension
 		);
 
-		if (!resourceManagers.mTextureManager.isValid(mSceneColorTextureHandle) || !resourceManagers.mTextureManager.isValid(sceneDepthTextureHandle)) {
-			return;
-		}
-		else {
-			const Texture& sceneColor = resourceManagers.mTextureManager.resolve(mSceneColorTextureHandle);
-			if (sceneColor.mWidth != viewport.mSize.x || sceneColor.mHeight != viewport.mSize.y) {
-				// Resize, evict it
-				resourceManagers.mTextureManager.discard(mSceneColorTextureHandle);
-				resourceManagers.mTextureManager.discard(sceneDepthTextureHandle);
-				return;
-			}
-		}
-
+		util::GPUTimers::beginFrame();
 		RenderPasses renderPasses;
 		{
 			TRACY_ZONEN("Demo::render");
@@ -140,7 +142,7 @@ namespace neo {
 
 		if (mShowBoundingBoxes) {
 			TRACY_ZONEN("Bounding boxes");
-			auto debugDrawTarget = resourceManagers.mFramebufferManager.asyncLoad(
+			auto debugDrawTarget = resourceManagers.mFramebufferManager.acquireTransient(
 				"DebugDraw Target",
 				FramebufferExternalAttachments{
 					FramebufferAttachment{mSceneColorTextureHandle},
@@ -173,6 +175,7 @@ namespace neo {
 		}
 
 		renderPasses._execute(mStats, resourceManagers, ecs, mWireframe);
+		util::GPUTimers::endFrame();
 	}
 
 	void Renderer::_imGuiEditor(WindowSurface& window, ECS& ecs, ResourceManagers& resourceManager) {
@@ -188,6 +191,7 @@ namespace neo {
 #pragma warning(disable: 4312)
 				ImGui::Image(mSceneColorTextureHandle.mHandle, {viewportSize.x, viewportSize.y}, ImVec2(0, 1), ImVec2(1, 0));
 #pragma warning(pop)
+				mDisplayedSceneColorHandle = mSceneColorTextureHandle;
 			}
 		}
 		ImGuizmo::SetDrawlist();
@@ -233,8 +237,44 @@ namespace neo {
 			ImGui::TreePop();
 		}
 		if (ImGui::TreeNodeEx("Render Passes")) {
-			for (const auto& pass : mStats.mRenderPasses) {
-				ImGui::TextWrapped("%s", pass.c_str());
+			ImGui::Checkbox("GPU Timers", &util::GPUTimers::sEnabled);
+			ImGui::SameLine();
+			if (ImGui::Button("Export")) {
+				_exportPassStats("render_passes.csv");
+			}
+			if (ImGui::BeginTable("##Passes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+				ImGui::TableSetupColumn("Pass");
+				ImGui::TableSetupColumn("GPU ms");
+				ImGui::TableSetupColumn("Draws");
+				ImGui::TableSetupColumn("Triangles");
+				ImGui::TableSetupColumn("Uniforms");
+				ImGui::TableHeadersRow();
+				for (int i = 0; i < static_cast<int>(mStats.mRenderPasses.size()); i++) {
+					const auto& pass = mStats.mRenderPasses[i];
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", pass.mName.c_str());
+					ImGui::TableNextColumn();
+					if (auto gpuTime = _getPassGPUTime(i)) {
+						ImGui::Text("%0.3f", *gpuTime);
+					}
+					else {
+						ImGui::TextDisabled("-");
+					}
+					ImGui::TableNextColumn();
+					ImGui::Text("%d", pass.mNumDraws);
+					ImGui::TableNextColumn();
+					ImGui::Text("%d", pass.mNumPrimitives);
+					ImGui::TableNextColumn();
+					ImGui::Text("%d", pass.mNumUniforms);
+				}
+				ImGui::EndTable();
+			}
+			if (ImGui::TreeNodeEx("GPU Scopes")) {
+				for (const auto& result : util::GPUTimers::getResults()) {
+					ImGui::Text("%*s%s: %0.3fms", result.mDepth * 2, "", result.mName.c_str(), result.mGPUTime);
+				}
+				ImGui::TreePop();
 			}
 			ImGui::TreePop();
 		}
@@ -264,5 +304,38 @@ namespace neo {
 	void Renderer::clean() {
 	}
 
+	std::optional<float> Renderer::_getPassGPUTime(int passIndex) const {
+		// GPU results are a few frames behind -- only trust them if the pass in that slot hasn't changed since
+		for (const auto& result : util::GPUTimers::getResults()) {
+			if (result.mTag == passIndex) {
+				if (passIndex < static_cast<int>(mStats.mRenderPasses.size()) && result.mName == mStats.mRenderPasses[passIndex].mName) {
+					return result.mGPUTime;
+				}
+				return std::nullopt;
+			}
+		}
+		return std::nullopt;
+	}
+
+	bool Renderer::_exportPassStats(const std::string& path) const {
+		std::ofstream out(path, std::ios::trunc);
+		if (!out) {
+			NEO_LOG_E("Unable to export render pass stats to %s", path.c_str());
+			return false;
+		}
+		out << "pass,gpu_ms,draws,primitives,uniforms,samplers\n";
+		for (int i = 0; i < static_cast<int>(mStats.mRenderPasses.size()); i++) {
+			const auto& pass = mStats.mRenderPasses[i];
+			auto gpuTime = _getPassGPUTime(i);
+			out << pass.mName << ",";
+			if (gpuTime) {
+				out << *gpuTime;
+			}
+			out << "," << pass.mNumDraws << "," << pass.mNumPrimitives << "," << pass.mNumUniforms << "," << pass.mNumSamplers << "\n";
+		}
+		NEO_LOG_I("Exported render pass stats to %s", path.c_str());
+		return static_cast<bool>(out);
+	}
+
 
 }
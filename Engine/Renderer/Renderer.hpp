@@ -8,6 +8,8 @@
 
 #include "Util/Profiler.hpp"
 
+#include <optional>
+#include <string>
 #include <typeindex>
 #include <memory>
 #include <tuple>
@@ -47,10 +49,13 @@ namespace neo {
 
 		private:
 			void _imGuiEditor(WindowSurface& window, ECS& ecs, ResourceManagers& resourceManager);
+			std::optional<float> _getPassGPUTime(int passIndex) const;
+			bool _exportPassStats(const std::string& path) const;
 
 			RendererDetails mDetails = {};
 
 			TextureHandle mSceneColorTextureHandle;
+			TextureHandle mDisplayedSceneColorHandle; // What ImGui's draw data points at -- it's drawn a frame late
 			bool mShowBoundingBoxes = false;
 			bool mWireframe = false;
 
@@ -64,16 +64,16 @@ namespace neo {
 		}, debugName.value_or("Blit"));
 	}
 
-	inline void blitDepth(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, TextureHandle srcTexture, TextureHandle dstTexture, glm::uvec2 dimension) {
+	inline void blitDepth(RenderPasses& renderPasses, ResourceManagers& resourceManagers, TextureHandle srcTexture, TextureHandle dstTexture, glm::uvec2 dimension) {
 		TRACY_ZONE();
 
-		FramebufferHandle inputTarget = resourceManagers.mFramebufferManager.asyncLoad("Input Depth Blit",
+		FramebufferHandle inputTarget = resourceManagers.mFramebufferManager.acquireTransient("Input Depth Blit",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{srcTexture},
 			},
 			resourceManagers.mTextureManager
 		);
-		FramebufferHandle outputTarget = resourceManagers.mFramebufferManager.asyncLoad("Output Depth Blit",
+		FramebufferHandle outputTarget = resourceManagers.mFramebufferManager.acquireTransient("Output Depth Blit",
 			FramebufferExternalAttachments{
 				FramebufferAttachment{dstTexture},
 			},
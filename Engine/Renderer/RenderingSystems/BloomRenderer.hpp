@@ -23,7 +23,7 @@ namespace neo {
 		}
 	};
 
-	inline TextureHandle bloom(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const glm::uvec2 dimension, const TextureHandle inputTextureHandle, const BloomParameters& parameters) {
+	inline TextureHandle bloom(RenderPasses& renderPasses, ResourceManagers& resourceManagers, const glm::uvec2 dimension, const TextureHandle inputTextureHandle, const BloomParameters& parameters) {
 		TRACY_ZONE();
 
 		NEO_ASSERT(parameters.mDownSampleSteps > 0, "Gotta bloom with something");
@@ -36,24 +36,16 @@ namespace neo {
 		glm::uvec2 baseDimension = dimension / glm::uvec2(2);
 		std::vector<TextureHandle> bloomTextures;
 		std::vector<FramebufferHandle> bloomTargets;
-		std::string textureName = "BloomTextureN";
-		std::string targetName = "BloomTargetN";
 		for (int i = 0; i < parameters.mDownSampleSteps; i++) {
-			textureName.back() = static_cast<char>(static_cast<int>('0') + i);
-			targetName.back() = static_cast<char>(static_cast<int>('0') + i);
-
-			bloomTextures.push_back(resourceManagers.mTextureManager.asyncLoad(
-				HashedString(targetName.c_str()),
-				TextureBuilder{}
-				.setDimension(glm::u16vec3(baseDimension.x >> i, baseDimension.y >> i, 0))
-				.setFormat(TextureFormat{
+			bloomTextures.push_back(resourceManagers.mTextureManager.acquireTransient(
+				TextureFormat{
 					types::texture::Target::Texture2D,
 					types::texture::InternalFormats::RGB16_F
-					}
-				)
+				},
+				glm::u16vec3(baseDimension.x >> i, baseDimension.y >> i, 0)
 			));
-			bloomTargets.push_back(resourceManagers.mFramebufferManager.asyncLoad(
-				HashedString(targetName.c_str()),
+			bloomTargets.push_back(resourceManagers.mFramebufferManager.acquireTransient(
+				"BloomTarget",
 				FramebufferExternalAttachments{
 					FramebufferAttachment{bloomTextures[i]}
 				},
@@ -125,11 +117,15 @@ namespace neo {
 		}
 
 		// Create a new full-res render target
-		auto bloomOutputHandle = resourceManagers.mFramebufferManager.asyncLoad(
-			HashedString("BloomOutput"),
-			FramebufferBuilder{}
-			.setSize(dimension)
-			.attach({ types::texture::Target::Texture2D, types::texture::InternalFormats::RGB16_F }),
+		TextureHandle bloomOutputTexture = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGB16_F },
+			glm::u16vec3(dimension, 0)
+		);
+		auto bloomOutputHandle = resourceManagers.mFramebufferManager.acquireTransient(
+			"BloomOutput",
+			FramebufferExternalAttachments{
+				FramebufferAttachment{bloomOutputTexture}
+			},
 			resourceManagers.mTextureManager
 		);
 		// Mix results
@@ -153,10 +149,6 @@ namespace neo {
 			quadMesh.draw();
 		}, "Bloom mix");
 
-		if (resourceManagers.mFramebufferManager.isValid(bloomOutputHandle)) {
-			return resourceManagers.mFramebufferManager.resolve(bloomOutputHandle).mTextures[0];
-		}
-
-		return NEO_INVALID_HANDLE;
+		return bloomOutputTexture;
 	}
 }
@@ -4,6 +4,10 @@
 
 #include "ECS/Component/CameraComponent/CSMCameraComponent.hpp"
 #include "ECS/Component/CameraComponent/FrustumComponent.hpp"
+#include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
+#include "ECS/Component/RenderingComponent/ShadowCasterRenderComponent.hpp"
+#include "ECS/Component/RenderingComponent/ShadowMapComponents.hpp"
 
 #include "Renderer/GLObjects/SourceShader.hpp"
 #include "Renderer/GLObjects/ResolvedShaderInstance.hpp"
@@ -13,27 +17,147 @@
 
 #include "ResourceManager/ResourceManagers.hpp"
 
+#include "Util/FrameArena.hpp"
+
 namespace neo {
 
 	namespace {
-		// This can be remapped to drawing a single shadow map tbh
+		struct CSMCascade {
+			ECS::Entity mCameraEntity;
+			int mLod = 0;
+			glm::mat4 mP = glm::mat4(1.f);
+			glm::mat4 mV = glm::mat4(1.f);
+		};
+
+		struct CSMCaster {
+			MeshHandle mMeshHandle;
+			TextureHandle mAlphaMap; // Only set for alpha tested casters
+			glm::mat4 mModelMatrix;
+			bool mStatic = false;
+		};
+
+		enum class CSMBoundsTest {
+			Outside,
+			Intersecting,
+			Contained
+		};
+
+		// Cascades are orthographic, so NDC-space is just light-space scaled to the cascade's box
+		inline CSMBoundsTest _testLightSpaceBounds(const glm::mat4& PVM, const BoundingBoxComponent& box) {
+			glm::vec3 ndcMin(FLT_MAX);
+			glm::vec3 ndcMax(-FLT_MAX);
+			for (int i = 0; i < 8; i++) {
+				glm::vec4 corner = PVM * glm::vec4(
+					(i & 1) ? box.mMax.x : box.mMin.x,
+					(i & 2) ? box.mMax.y : box.mMin.y,
+					(i & 4) ? box.mMax.z : box.mMin.z,
+					1.f
+				);
+				corner /= corner.w;
+				ndcMin = glm::min(ndcMin, glm::vec3(corner));
+				ndcMax = glm::max(ndcMax, glm::vec3(corner));
+			}
+
+			if (glm::any(glm::lessThan(ndcMax, glm::vec3(-1.f))) || glm::any(glm::greaterThan(ndcMin, glm::vec3(1.f)))) {
+				return CSMBoundsTest::Outside;
+			}
+			if (glm::all(glm::greaterThanEqual(ndcMin, glm::vec3(-1.f))) && glm::all(glm::lessThanEqual(ndcMax, glm::vec3(1.f)))) {
+				return CSMBoundsTest::Contained;
+			}
+			return CSMBoundsTest::Intersecting;
+		}
+
+		inline std::vector<CSMCascade> _getCSMCascades(const ECS& ecs, uint8_t cascadeCount) {
+			std::vector<CSMCascade> cascades;
+			for (auto&& [cameraEntity, cameraSpatial, cameraCamera, csmCamera] : ecs.getView<const SpatialComponent, const CameraComponent, const CSMCameraComponent>().each()) {
+				if (csmCamera.getLod() < cascadeCount) {
+					cascades.emplace_back(CSMCascade{ cameraEntity, csmCamera.getLod(), cameraCamera.getProj(), cameraSpatial.getView() });
+				}
+			}
+			std::sort(cascades.begin(), cascades.end(), [](const CSMCascade& a, const CSMCascade& b) {
+				return a.mLod < b.mLod;
+			});
+			return cascades;
+		}
+
+		// Walks the casters once and bins them into every cascade they touch
+		// Cascades are sorted near to far -- once a caster is fully contained in a cascade, the farther ones can skip it
 		template<typename... CompTs>
-		void _drawSingleCSM(
-			RenderPasses& renderPasses,
-			const ResourceManagers& resourceManagers,
-			ECS::Entity cameraEntity,
-			const TextureHandle& shadowMap,
-			const ShaderHandle& shaderHandle,
-			const int slice,
-			const bool clear
-		) {
-			if (!resourceManagers.mTextureManager.isValid(shadowMap)) {
-				return;
+		util::FrameVector<util::FrameVector<CSMCaster>> _buildCSMCasterLists(const ResourceManagers& resourceManagers, const ECS& ecs, const std::vector<CSMCascade>& cascades) {
+			TRACY_ZONE();
+
+			bool containsAlphaTest = false;
+			if constexpr ((std::is_same_v<AlphaTestComponent, CompTs> || ...) || (std::is_same_v<TransparentComponent, CompTs> || ...)) {
+				containsAlphaTest = true;
+			}
+
+			util::FrameVector<glm::mat4> cascadePVs;
+			cascadePVs.reserve(cascades.size());
+			for (const auto& cascade : cascades) {
+				cascadePVs.push_back(cascade.mP * cascade.mV);
 			}
 
-			char targetName[32];
-			sprintf(targetName, "ShadowMap_%d_%d", static_cast<int>(cameraEntity), slice);
-			FramebufferHandle shadowMapHandle = resourceManagers.mFramebufferManager.asyncLoad(
+			util::FrameVector<util::FrameVector<CSMCaster>> casterLists(cascades.size());
+			const auto view = ecs.getView<const ShadowCasterRenderComponent, const MeshComponent, const SpatialComponent, CompTs...>();
+			for (auto entity : view) {
+				CSMCaster caster;
+				caster.mMeshHandle = view.get<const MeshComponent>(entity).mMeshHandle;
+				if (const auto* lod = ecs.cGetComponent<MeshLODComponent>(entity)) {
+					caster.mMeshHandle = lod->getShadowMesh();
+				}
+				// Still uploading
+				if (!resourceManagers.mMeshManager.isValid(caster.mMeshHandle)) {
+					continue;
+				}
+				caster.mModelMatrix = view.get<const SpatialComponent>(entity).getModelMatrix();
+				caster.mStatic = view.get<const ShadowCasterRenderComponent>(entity).mStatic;
+				if (containsAlphaTest) {
+					auto material = ecs.cGetComponent<const MaterialComponent>(entity);
+					if (material && resourceManagers.mTextureManager.isValid(material->mAlbedoMap)) {
+						caster.mAlphaMap = material->mAlbedoMap;
+					}
+				}
+
+				const auto* box = ecs.cGetComponent<BoundingBoxComponent>(entity);
+				for (int i = 0; i < cascades.size(); i++) {
+					if (box) {
+						const CSMBoundsTest result = _testLightSpaceBounds(cascadePVs[i] * caster.mModelMatrix, *box);
+						if (result == CSMBoundsTest::Outside) {
+							continue;
+						}
+						casterLists[i].push_back(caster);
+						if (result == CSMBoundsTest::Contained) {
+							break;
+						}
+					}
+					else {
+						casterLists[i].push_back(caster);
+					}
+				}
+			}
+
+			// Batch by shader variant, then material, then mesh
+			for (auto& casters : casterLists) {
+				std::sort(casters.begin(), casters.end(), [](const CSMCaster& a, const CSMCaster& b) {
+					const bool aAlpha = a.mAlphaMap != NEO_INVALID_HANDLE;
+					const bool bAlpha = b.mAlphaMap != NEO_INVALID_HANDLE;
+					if (aAlpha != bAlpha) {
+						return aAlpha < bAlpha;
+					}
+					if (a.mAlphaMap.mHandle != b.mAlphaMap.mHandle) {
+						return a.mAlphaMap.mHandle < b.mAlphaMap.mHandle;
+					}
+					return a.mMeshHandle.mHandle < b.mMeshHandle.mHandle;
+				});
+			}
+
+			return casterLists;
+		}
+
+		inline FramebufferHandle _getCSMTarget(const ResourceManagers& resourceManagers, const TextureHandle& shadowMap, const int slice) {
+			char targetName[48];
+			sprintf(targetName, "CSMShadowMap_%u_%d", shadowMap.mHandle, slice);
+			return resourceManagers.mFramebufferManager.asyncLoad(
 				HashedString(targetName),
 				FramebufferExternalAttachments{ {
 						shadowMap,
@@ -42,96 +166,169 @@ namespace neo {
 				} },
 				resourceManagers.mTextureManager
 			);
+		}
 
-			if (clear) {
-				renderPasses.clear(shadowMapHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear single CSM");
+		inline void _drawCSMCasters(
+			RenderPasses& renderPasses,
+			const ResourceManagers& resourceManagers,
+			const FramebufferHandle& target,
+			const CSMCascade& cascade,
+			util::FrameVector<CSMCaster>&& casters,
+			const TextureHandle& shadowMap,
+			const ShaderHandle& shaderHandle
+		) {
+			if (casters.empty()) {
+				return;
 			}
 
+			const int slice = cascade.mLod;
 			RenderState cullFront;
 			cullFront.mCullFace = CullFace::Front;
 			const Texture& shadowTexture = resourceManagers.mTextureManager.resolve(shadowMap);
-			renderPasses.renderPass(shadowMapHandle, glm::uvec2(shadowTexture.mWidth >> slice, shadowTexture.mHeight >> slice), cullFront, [cameraEntity, shaderHandle](const ResourceManagers& resourceManagers, const ECS& ecs) {
-				TRACY_GPUN("_drawSingleCSM");
-
-				NEO_ASSERT(ecs.has<SpatialComponent>(cameraEntity) && ecs.has<CameraComponent>(cameraEntity), "Light entity is just wrong");
-				const glm::mat4 P = ecs.cGetComponent<CameraComponent>(cameraEntity)->getProj();
-				const glm::mat4 V = ecs.cGetComponent<SpatialComponent>(cameraEntity)->getView();
-
-				ShaderDefines drawDefines;
-				const auto view = ecs.getView<const ShadowCasterRenderComponent, const MeshComponent, const SpatialComponent, CompTs...>();
-				for (auto entity : view) {
-					// VFC
-					if (auto* culled = ecs.cGetComponent<CameraCulledComponent>(entity)) {
-						if (!culled->isInView(ecs, entity, cameraEntity)) {
-							continue;
+			renderPasses.renderPass(target, glm::uvec2(shadowTexture.mWidth >> slice, shadowTexture.mHeight >> slice), cullFront, [P = cascade.mP, V = cascade.mV, shaderHandle, casters = std::move(casters)](const ResourceManagers& resourceManagers, const ECS& ecs) {
+				TRACY_GPUN("_drawCSMCasters");
+				NEO_UNUSED(ecs);
+
+				// Casters are sorted -- only rebind state when it actually changes
+				const ResolvedShaderInstance* resolvedShader = nullptr;
+				std::optional<TextureHandle> boundAlphaMap;
+				for (const auto& caster : casters) {
+					const bool doAlphaTest = caster.mAlphaMap != NEO_INVALID_HANDLE;
+					if (!resolvedShader || (doAlphaTest && !boundAlphaMap)) {
+						ShaderDefines drawDefines;
+						MakeDefine(ALPHA_TEST);
+						if (doAlphaTest) {
+							drawDefines.set(ALPHA_TEST);
 						}
+						resolvedShader = &resourceManagers.mShaderManager.resolveDefines(shaderHandle, drawDefines);
+						resolvedShader->bind();
+						resolvedShader->bindUniform("P", P);
+						resolvedShader->bindUniform("V", V);
 					}
-					drawDefines.reset();
-
-					auto material = ecs.cGetComponent<const MaterialComponent>(entity);
 
-					MakeDefine(ALPHA_TEST);
-					bool containsAlphaTest = false;
-					if constexpr ((std::is_same_v<AlphaTestComponent, CompTs> || ...) || (std::is_same_v<TransparentComponent, CompTs> || ...)) {
-						containsAlphaTest = true;
+					if (doAlphaTest && (!boundAlphaMap || boundAlphaMap->mHandle != caster.mAlphaMap.mHandle)) {
+						resolvedShader->bindTexture("alphaMap", resourceManagers.mTextureManager.resolve(caster.mAlphaMap));
+						boundAlphaMap = caster.mAlphaMap;
 					}
 
-					bool doAlphaTest = containsAlphaTest && material && resourceManagers.mTextureManager.isValid(material->mAlbedoMap);
-					if (doAlphaTest) {
-						drawDefines.set(ALPHA_TEST);
-					}
+					resolvedShader->bindUniform("M", caster.mModelMatrix);
+					resourceManagers.mMeshManager.resolve(caster.mMeshHandle).draw();
+				}
+			}, "Draw CSM casters");
+		}
 
-					auto& resolvedShader = resourceManagers.mShaderManager.resolveDefines(shaderHandle, drawDefines);
-					resolvedShader.bind();
+		inline void _drawSingleCSM(
+			RenderPasses& renderPasses,
+			const ResourceManagers& resourceManagers,
+			const CSMCascade& cascade,
+			util::FrameVector<CSMCaster>&& casters,
+			const TextureHandle& shadowMap,
+			const ShaderHandle& shaderHandle,
+			const bool clear
+		) {
+			if (!resourceManagers.mTextureManager.isValid(shadowMap)) {
+				return;
+			}
 
-					if (doAlphaTest) {
-						resolvedShader.bindTexture("alphaMap", resourceManagers.mTextureManager.resolve(material->mAlbedoMap));
-					}
+			FramebufferHandle shadowMapHandle = _getCSMTarget(resourceManagers, shadowMap, cascade.mLod);
+			if (clear) {
+				renderPasses.clear(shadowMapHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear single CSM");
+			}
+			_drawCSMCasters(renderPasses, resourceManagers, shadowMapHandle, cascade, std::move(casters), shadowMap, shaderHandle);
+		}
 
-					resolvedShader.bindUniform("P", P);
-					resolvedShader.bindUniform("V", V);
-					resolvedShader.bindUniform("M", view.get<const SpatialComponent>(entity).getModelMatrix());
-					resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+		// Static casters live in the cache and are only redrawn when the cascade is invalidated
+		// Otherwise the cache is copied over and just the dynamic casters are drawn on top
+		inline void _drawCachedCSM(
+			RenderPasses& renderPasses,
+			const ResourceManagers& resourceManagers,
+			const CSMCascade& cascade,
+			util::FrameVector<CSMCaster>&& casters,
+			const TextureHandle& shadowMap,
+			const ShadowCacheComponent& cache,
+			const ShaderHandle& shaderHandle,
+			const bool clear
+		) {
+			const int slice = cascade.mLod;
+			if (!cache.needsUpdate(slice)) {
+				return;
+			}
+
+			FramebufferHandle cacheTarget = _getCSMTarget(resourceManagers, cache.mStaticShadowMap, slice);
+			FramebufferHandle target = _getCSMTarget(resourceManagers, shadowMap, slice);
+			if (!resourceManagers.mFramebufferManager.isValid(cacheTarget) || !resourceManagers.mFramebufferManager.isValid(target)) {
+				return;
+			}
+
+			util::FrameVector<CSMCaster> staticCasters;
+			util::FrameVector<CSMCaster> dynamicCasters;
+			for (auto& caster : casters) {
+				(caster.mStatic ? staticCasters : dynamicCasters).emplace_back(std::move(caster));
+			}
+
+			if (cache.mStaticDirty[slice]) {
+				if (clear) {
+					renderPasses.clear(cacheTarget, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear cached CSM");
+				}
+				else {
+					// The final slice won't be restored from the cache this time around
+					_drawCSMCasters(renderPasses, resourceManagers, target, cascade, util::FrameVector<CSMCaster>(staticCasters), shadowMap, shaderHandle);
 				}
-			}, "Draw single CSM");
+				_drawCSMCasters(renderPasses, resourceManagers, cacheTarget, cascade, std::move(staticCasters), cache.mStaticShadowMap, shaderHandle);
+				cache.mStaticCached[slice] = true;
+			}
+			if (clear) {
+				renderPasses.copy(cache.mStaticShadowMap, shadowMap, static_cast<uint16_t>(slice), 0, "Restore cached CSM");
+			}
+			_drawCSMCasters(renderPasses, resourceManagers, target, cascade, std::move(dynamicCasters), shadowMap, shaderHandle);
 		}
 	}
 
 	struct CSMShadowInfo {
 		bool mValidCSMShadows = false;
-		std::array<glm::mat4, CSM_CAMERA_COUNT> mLightArrays = {};
+		uint8_t mCascadeCount = 0;
+		std::array<glm::mat4, CSM_MAX_CAMERA_COUNT> mLightArrays = {};
+
+		void bindUniforms(const ResolvedShaderInstance& resolvedShader) const {
+			static_assert(CSM_MAX_CAMERA_COUNT == 4, "Update the shaders too");
+			static const char* sLightArrayNames[CSM_MAX_CAMERA_COUNT] = { "L0", "L1", "L2", "L3" };
+			for (int i = 0; i < CSM_MAX_CAMERA_COUNT; i++) {
+				resolvedShader.bindUniform(sLightArrayNames[i], mLightArrays[i]);
+			}
+			resolvedShader.bindUniform("csmCascadeCount", static_cast<int>(mCascadeCount));
+		}
 	};
 	inline CSMShadowInfo extractCSMShadowInfo(const ECS& ecs, const ECS::Entity lightEntity, const TextureManager& textureManager) {
 		CSMShadowInfo ret;
 		ret.mValidCSMShadows = true
 			&& ecs.has<CameraComponent>(lightEntity)
-			&& ecs.has<CSMShadowMapComponent>(lightEntity) && textureManager.isValid(ecs.cGetComponent<CSMShadowMapComponent>(lightEntity)->mShadowMap)
-			&& ecs.has<CSMCamera0Component>()
-			&& ecs.has<CSMCamera1Component>()
-			&& ecs.has<CSMCamera2Component>();
-		if (ret.mValidCSMShadows) {
-			static glm::mat4 biasMatrix(
-				0.5f, 0.0f, 0.0f, 0.0f,
-				0.0f, 0.5f, 0.0f, 0.0f,
-				0.0f, 0.0f, 0.5f, 0.0f,
-				0.5f, 0.5f, 0.5f, 1.0f);
-			auto csmCamera0Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera0Component>();
-			auto csmCamera1Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera1Component>();
-			auto csmCamera2Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera2Component>();
-			NEO_ASSERT(csmCamera0Tuple && csmCamera1Tuple && csmCamera2Tuple, "CSM Camera's dont exist");
-			auto& [cameraEntity0, cameraSpatial0, csmCameraCamera0, csmCamera0] = *csmCamera0Tuple;
-			auto& [cameraEntity1, cameraSpatial1, csmCameraCamera1, csmCamera1] = *csmCamera1Tuple;
-			auto& [cameraEntity2, cameraSpatial2, csmCameraCamera2, csmCamera2] = *csmCamera2Tuple;
-
-			ret.mLightArrays[0] = biasMatrix * csmCameraCamera0.getProj() * cameraSpatial0.getView();
-			ret.mLightArrays[1] = biasMatrix * csmCameraCamera1.getProj() * cameraSpatial1.getView();
-			ret.mLightArrays[2] = biasMatrix * csmCameraCamera2.getProj() * cameraSpatial2.getView();
+			&& ecs.has<CSMShadowMapComponent>(lightEntity) && textureManager.isValid(ecs.cGetComponent<CSMShadowMapComponent>(lightEntity)->mShadowMap);
+		if (!ret.mValidCSMShadows) {
+			return ret;
 		}
 
+		static glm::mat4 biasMatrix(
+			0.5f, 0.0f, 0.0f, 0.0f,
+			0.0f, 0.5f, 0.0f, 0.0f,
+			0.0f, 0.0f, 0.5f, 0.0f,
+			0.5f, 0.5f, 0.5f, 1.0f);
+		const auto cascades = _getCSMCascades(ecs, ecs.cGetComponent<CSMShadowMapComponent>(lightEntity)->mCascadeCount);
+		for (int i = 0; i < cascades.size(); i++) {
+			// A missing cascade would shift every farther cascade onto the wrong mip
+			if (cascades[i].mLod != i) {
+				ret.mValidCSMShadows = false;
+				return ret;
+			}
+			ret.mLightArrays[i] = biasMatrix * cascades[i].mP * cascades[i].mV;
+		}
+		ret.mCascadeCount = static_cast<uint8_t>(cascades.size());
+		ret.mValidCSMShadows = ret.mCascadeCount > 0;
+
 		return ret;
 	}
 
-	inline std::vector<ECS::EntityBuilder> createCSMCameras() {
+	inline std::vector<ECS::EntityBuilder> createCSMCameras(uint8_t cascadeCount = CSM_DEFAULT_CAMERA_COUNT) {
+		NEO_ASSERT(cascadeCount > 0 && cascadeCount <= CSM_MAX_CAMERA_COUNT, "Invalid cascade count %d", cascadeCount);
 
 		std::vector<ECS::EntityBuilder> ret;
 		// CSM cameras
@@ -144,28 +341,18 @@ namespace neo {
 			.attachComponent<CameraComponent>(-2.f, 2.f, CameraComponent::Orthographic{ glm::vec2(-4.f, 2.f), glm::vec2(0.1f, 5.f) })
 			.attachComponent<FrustumComponent>()
 			;
-		ret.emplace_back(ECS::EntityBuilder(csmCameraProto)
-			.attachComponent<CSMCamera0Component>()
-		);
-		ret.emplace_back(ECS::EntityBuilder(csmCameraProto)
-			.attachComponent<CSMCamera1Component>()
-		);
-		ret.emplace_back(ECS::EntityBuilder(csmCameraProto)
-			.attachComponent<CSMCamera2Component>()
-		);
+		for (uint8_t i = 0; i < cascadeCount; i++) {
+			ret.emplace_back(ECS::EntityBuilder(csmCameraProto)
+				.attachComponent<CSMCameraComponent>(i)
+			);
+		}
 
 		return ret;
 	}
 
 	inline void removeCSMCameras(ECS& ecs) {
-		if (auto csm0 = ecs.getSingleView<SpatialComponent, CSMCamera0Component>()) {
-			ecs.removeEntity(std::get<0>(*csm0));
-		}
-		if (auto csm1 = ecs.getSingleView<SpatialComponent, CSMCamera1Component>()) {
-			ecs.removeEntity(std::get<0>(*csm1));
-		}
-		if (auto csm2 = ecs.getSingleView<SpatialComponent, CSMCamera2Component>()) {
-			ecs.removeEntity(std::get<0>(*csm2));
+		for (auto entity : ecs.getView<CSMCameraComponent>()) {
+			ecs.removeEntity(entity);
 		}
 	}
 
@@ -186,16 +373,19 @@ namespace neo {
 			return;
 		}
 
-		auto csmCamera0Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera0Component>();
-		auto csmCamera1Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera1Component>();
-		auto csmCamera2Tuple = ecs.getSingleView<SpatialComponent, CameraComponent, CSMCamera2Component>();
-		NEO_ASSERT(csmCamera0Tuple && csmCamera1Tuple && csmCamera2Tuple, "CSM Camera's dont exist");
-		auto& [cameraEntity0, cameraSpatial0, cameraCamera0, csmCamera0] = *csmCamera0Tuple;
-		auto& [cameraEntity1, cameraSpatial1, cameraCamera1, csmCamera1] = *csmCamera1Tuple;
-		auto& [cameraEntity2, cameraSpatial2, cameraCamera2, csmCamera2] = *csmCamera2Tuple;
-
-		_drawSingleCSM<CompTs...>(renderPasses, resourceManagers, cameraEntity0, shadowMap->mShadowMap, shaderHandle, 0, clear);
-		_drawSingleCSM<CompTs...>(renderPasses, resourceManagers, cameraEntity1, shadowMap->mShadowMap, shaderHandle, 1, clear);
-		_drawSingleCSM<CompTs...>(renderPasses, resourceManagers, cameraEntity2, shadowMap->mShadowMap, shaderHandle, 2, clear);
+		const auto cascades = _getCSMCascades(ecs, shadowMap->mCascadeCount);
+		NEO_ASSERT(cascades.size() == shadowMap->mCascadeCount, "CSM Camera's dont exist");
+
+		auto casterLists = _buildCSMCasterLists<CompTs...>(resourceManagers, ecs, cascades);
+		const auto* cache = ecs.cGetComponent<ShadowCacheComponent>(lightEntity);
+		const bool useCache = cache && resourceManagers.mTextureManager.isValid(cache->mStaticShadowMap);
+		for (int i = 0; i < cascades.size(); i++) {
+			if (useCache) {
+				_drawCachedCSM(renderPasses, resourceManagers, cascades[i], std::move(casterLists[i]), shadowMap->mShadowMap, *cache, shaderHandle, clear);
+			}
+			else {
+				_drawSingleCSM(renderPasses, resourceManagers, cascades[i], std::move(casterLists[i]), shadowMap->mShadowMap, shaderHandle, clear);
+			}
+		}
 	}
-}
+}
\ No newline at end of file
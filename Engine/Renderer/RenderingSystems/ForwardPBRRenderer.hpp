@@ -142,6 +142,11 @@ namespace neo {
 					}
 				}
 
+				// Still uploading
+				if (!resourceManagers.mMeshManager.isValid(view.get<const MeshComponent>(entity).mMeshHandle)) {
+					continue;
+				}
+
 				drawDefines.reset();
 				const auto& material = view.get<const MaterialComponent>(entity);
 				MakeDefine(ALBEDO_MAP);
@@ -217,9 +222,7 @@ namespace neo {
 						TextureHandle shadowMapHandle;
 						if (directionalLight) {
 							shadowMapHandle = ecs.cGetComponent<CSMShadowMapComponent>(lightEntity)->mShadowMap;
-							resolvedShader.bindUniform("L0", csmShadowInfo.mLightArrays[0]);
-							resolvedShader.bindUniform("L1", csmShadowInfo.mLightArrays[1]);
-							resolvedShader.bindUniform("L2", csmShadowInfo.mLightArrays[2]);
+							csmShadowInfo.bindUniforms(resolvedShader);
 						}
 						if (pointLight) {
 							shadowMapHandle = ecs.cGetComponent<PointLightShadowMapComponent>(lightEntity)->mShadowMap;
@@ -141,7 +141,9 @@ namespace neo {
 				resolvedShader.bindUniform("M", drawSpatial.getModelMatrix());
 				resolvedShader.bindUniform("N", drawSpatial.getNormalMatrix());
 
-				resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+				if (resourceManagers.mMeshManager.isValid(view.get<const MeshComponent>(entity).mMeshHandle)) {
+					resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+				}
 			}
 		}, "Draw Phong");
 	}
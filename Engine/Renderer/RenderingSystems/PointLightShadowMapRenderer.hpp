@@ -4,8 +4,10 @@
 
 #include "ECS/Component/CameraComponent/CameraComponent.hpp"
 #include "ECS/Component/CameraComponent/FrustumComponent.hpp"
+#include "ECS/Component/CollisionComponent/BoundingBoxComponent.hpp"
 #include "ECS/Component/RenderingComponent/ShadowMapComponents.hpp"
 #include "ECS/Component/RenderingComponent/ShadowCasterRenderComponent.hpp"
+#include "ECS/Component/RenderingComponent/MeshLODComponent.hpp"
 
 #include "Renderer/GLObjects/SourceShader.hpp"
 #include "Renderer/GLObjects/ResolvedShaderInstance.hpp"
@@ -13,113 +15,306 @@
 
 #include "ResourceManager/ResourceManagers.hpp"
 
+#include "Util/FrameArena.hpp"
+
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace neo {
 
 	struct PointLightShadowMapParameters {
 		float mNearPlane = 0.5f;
-		std::optional<float> mFarPlaneOverride;
+		bool mLayered = true; // Draw all faces in one pass with a geometry shader
 	};
 
-	template<typename... CompTs>
-	inline void drawPointLightShadows(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const ECS::Entity& lightEntity, const bool clear, PointLightShadowMapParameters params = {}) {
-		TRACY_ZONE();
+	namespace {
+		enum class ShadowCasterFilter {
+			All,
+			Static,
+			Dynamic
+		};
 
-		NEO_ASSERT(ecs.has<PointLightComponent>(lightEntity) && ecs.has<PointLightShadowMapComponent>(lightEntity), "Invalid light entity for point ligth shadows");
-		TextureHandle shadowCubeHandle = ecs.cGetComponent<PointLightShadowMapComponent>(lightEntity)->mShadowMap;
-		if (!resourceManagers.mTextureManager.isValid(shadowCubeHandle)) {
-			return;
+		struct PointLightCaster {
+			MeshHandle mMeshHandle;
+			TextureHandle mAlphaMap; // Only set for alpha tested casters
+			glm::mat4 mModelMatrix;
+			uint8_t mFaceMask = 0; // See PointLightShadowMapComponent::getFaceMask
+			bool mStatic = false;
+		};
+
+		struct PointLightFaces {
+			glm::mat4 mP;
+			std::array<glm::mat4, 6> mV;
+			glm::vec3 mLightPos;
+			float mLightRange;
+		};
+
+		inline PointLightFaces _getPointLightFaces(const SpatialComponent& lightSpatial, float farPlane, const PointLightShadowMapParameters& params) {
+			static std::vector<std::vector<glm::vec3>> lookDirs = {
+				{ glm::vec3( 1, 0, 0), glm::vec3( 0, -1, 0) },
+				{ glm::vec3(-1, 0, 0), glm::vec3( 0, -1, 0) },
+				{ glm::vec3( 0, 1, 0), glm::vec3( 0,  0, 1) },
+				{ glm::vec3( 0,-1, 0), glm::vec3( 0,  0,-1) },
+				{ glm::vec3( 0, 0, 1), glm::vec3( 0, -1, 0) },
+				{ glm::vec3( 0, 0,-1), glm::vec3( 0, -1, 0) }
+			};
+
+			PointLightFaces faces;
+			CameraComponent camera(
+				params.mNearPlane, 
+				farPlane, 
+				CameraComponent::Perspective{90.f, 1.f}
+			);
+			faces.mP = camera.getProj();
+			SpatialComponent cameraSpatial = lightSpatial; // Copy
+			for (int i = 0; i < 6; i++) {
+				cameraSpatial.setLookDir(lookDirs[i][0], lookDirs[i][1]);
+				faces.mV[i] = cameraSpatial.getView();
+			}
+			faces.mLightPos = lightSpatial.getPosition();
+			faces.mLightRange = (lightSpatial.getScale().x - 0.5f) / 2.f;
+			return faces;
 		}
 
-		NEO_ASSERT(ecs.has<SpatialComponent>(lightEntity), "Point light shadows need a spatial");
+		// Walks the casters once, rejecting anything out of range and tagging which faces each one lands on
+		template<typename... CompTs>
+		util::FrameVector<PointLightCaster> _buildPointLightCasters(const ResourceManagers& resourceManagers, const ECS& ecs, const glm::vec3& lightPos, const float range) {
+			TRACY_ZONE();
 
-		char targetName[128];
-		for (int i = 0; i < 6; i++) {
-			sprintf(targetName, "%s_%d_%d", "PointLightShadowMap", lightEntity, i);
+			bool containsAlphaTest = false;
+			if constexpr ((std::is_same_v<AlphaTestComponent, CompTs> || ...) || (std::is_same_v<TransparentComponent, CompTs> || ...)) {
+				containsAlphaTest = true;
+			}
 
-			FramebufferHandle shadowTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+			const auto view = ecs.getView<const ShadowCasterRenderComponent, const MeshComponent, const SpatialComponent, CompTs...>();
+			util::FrameVector<PointLightCaster> casters;
+			casters.reserve(view.size_hint());
+			for (auto entity : view) {
+				PointLightCaster caster;
+				caster.mModelMatrix = view.get<const SpatialComponent>(entity).getModelMatrix();
+				caster.mFaceMask = 0x3F;
+				if (const auto* box = ecs.cGetComponent<BoundingBoxComponent>(entity)) {
+					BoundingBoxComponent worldBox;
+					for (int i = 0; i < 8; i++) {
+						worldBox.addPoint(glm::vec3(caster.mModelMatrix * glm::vec4(
+							(i & 1) ? box->mMax.x : box->mMin.x,
+							(i & 2) ? box->mMax.y : box->mMin.y,
+							(i & 4) ? box->mMax.z : box->mMin.z,
+							1.f
+						)));
+					}
+					caster.mFaceMask = PointLightShadowMapComponent::getFaceMask(lightPos, range, worldBox.mMin, worldBox.mMax);
+				}
+				if (!caster.mFaceMask) {
+					continue;
+				}
+
+				caster.mMeshHandle = view.get<const MeshComponent>(entity).mMeshHandle;
+				if (const auto* lod = ecs.cGetComponent<MeshLODComponent>(entity)) {
+					caster.mMeshHandle = lod->getShadowMesh();
+				}
+				// Still uploading
+				if (!resourceManagers.mMeshManager.isValid(caster.mMeshHandle)) {
+					continue;
+				}
+				caster.mStatic = view.get<const ShadowCasterRenderComponent>(entity).mStatic;
+				if (containsAlphaTest) {
+					auto material = ecs.cGetComponent<const MaterialComponent>(entity);
+					if (material && resourceManagers.mTextureManager.isValid(material->mAlbedoMap)) {
+						caster.mAlphaMap = material->mAlbedoMap;
+					}
+				}
+				casters.push_back(caster);
+			}
+
+			// Batch by shader variant, then material, then mesh
+			std::sort(casters.begin(), casters.end(), [](const PointLightCaster& a, const PointLightCaster& b) {
+				const bool aAlpha = a.mAlphaMap != NEO_INVALID_HANDLE;
+				const bool bAlpha = b.mAlphaMap != NEO_INVALID_HANDLE;
+				if (aAlpha != bAlpha) {
+					return aAlpha < bAlpha;
+				}
+				if (a.mAlphaMap.mHandle != b.mAlphaMap.mHandle) {
+					return a.mAlphaMap.mHandle < b.mAlphaMap.mHandle;
+				}
+				return a.mMeshHandle.mHandle < b.mMeshHandle.mHandle;
+			});
+			return casters;
+		}
+
+		inline util::FrameVector<PointLightCaster> _filterPointLightCasters(const util::FrameVector<PointLightCaster>& casters, const int face, const ShadowCasterFilter filter) {
+			util::FrameVector<PointLightCaster> ret;
+			ret.reserve(casters.size());
+			for (const auto& caster : casters) {
+				if (!(caster.mFaceMask & (1 << face))) {
+					continue;
+				}
+				if (filter != ShadowCasterFilter::All && caster.mStatic != (filter == ShadowCasterFilter::Static)) {
+					continue;
+				}
+				ret.push_back(caster);
+			}
+			return ret;
+		}
+
+		inline FramebufferHandle _getPointLightShadowTarget(const ResourceManagers& resourceManagers, const TextureHandle& shadowCube, const int face) {
+			char targetName[128];
+			sprintf(targetName, "%s_%u_%d", "PointLightShadowMap", shadowCube.mHandle, face);
+			return resourceManagers.mFramebufferManager.asyncLoad(
 				HashedString(targetName),
 				FramebufferExternalAttachments { 
 					FramebufferAttachment {
-						shadowCubeHandle,
-						static_cast<types::framebuffer::AttachmentTarget>(static_cast<uint8_t>(types::framebuffer::AttachmentTarget::TargetCubeX_Positive) + i),
+						shadowCube,
+						face < 0 
+							? types::framebuffer::AttachmentTarget::TargetLayered
+							: static_cast<types::framebuffer::AttachmentTarget>(static_cast<uint8_t>(types::framebuffer::AttachmentTarget::TargetCubeX_Positive) + face),
 						0
 					}
 				},
 				resourceManagers.mTextureManager
 			);
-			if (clear) {
-				renderPasses.clear(shadowTargetHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear point light shadow face");
+		}
+
+		// face < 0 draws every face in one pass through the layered shader
+		inline void _drawPointLightCasters(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const FramebufferHandle& target, const TextureHandle& shadowCubeHandle, const ShaderHandle& shaderHandle, const PointLightFaces& faces, const int face, util::FrameVector<PointLightCaster>&& casters) {
+			if (casters.empty()) {
+				return;
 			}
 
 			const Texture& shadowCube = resourceManagers.mTextureManager.resolve(shadowCubeHandle);
-			renderPasses.renderPass(shadowTargetHandle, glm::uvec2(shadowCube.mWidth, shadowCube.mHeight), RenderState{}, [i, lightEntity, params](const ResourceManagers& resourceManagers, const ECS& ecs) {
+			renderPasses.renderPass(target, glm::uvec2(shadowCube.mWidth, shadowCube.mHeight), RenderState{}, [face, faces, shaderHandle, casters = std::move(casters)](const ResourceManagers& resourceManagers, const ECS& ecs) {
 				TRACY_GPUN("Draw Face");
-				auto shaderHandle = resourceManagers.mShaderManager.asyncLoad("PointLightShadowMap Shader", SourceShader::ConstructionArgs{
-					{ types::shader::Stage::Vertex, "model.vert"},
-					{ types::shader::Stage::Fragment, "pointlightdepth.frag" }
-				});
-				if (!resourceManagers.mShaderManager.isValid(shaderHandle)) {
-					return;
-				}
-	
-				static std::vector<std::vector<glm::vec3>> lookDirs = {
-					{ glm::vec3( 1, 0, 0), glm::vec3( 0, -1, 0) },
-					{ glm::vec3(-1, 0, 0), glm::vec3( 0, -1, 0) },
-					{ glm::vec3( 0, 1, 0), glm::vec3( 0,  0, 1) },
-					{ glm::vec3( 0,-1, 0), glm::vec3( 0,  0,-1) },
-					{ glm::vec3( 0, 0, 1), glm::vec3( 0, -1, 0) },
-					{ glm::vec3( 0, 0,-1), glm::vec3( 0, -1, 0) }
-				};
-				SpatialComponent cameraSpatial = *ecs.cGetComponent<SpatialComponent>(lightEntity); // Copy
-				cameraSpatial.setLookDir(lookDirs[i][0], lookDirs[i][1]);
-				FrustumComponent frustum;
-				CameraComponent camera(
-					params.mNearPlane, 
-					params.mFarPlaneOverride.value_or(cameraSpatial.getScale().x / 2.f), 
-					CameraComponent::Perspective{90.f, 1.f}
-				);
-				frustum.calculateFrustum(camera, cameraSpatial);
-	
-				ShaderDefines drawDefines;
-				const auto& view = ecs.getView<const ShadowCasterRenderComponent, const MeshComponent, const SpatialComponent, CompTs...>();
-				for (auto entity : view) {
-					const SpatialComponent& drawSpatial = view.get<const SpatialComponent>(entity);
-					// VFC
-					if (ecs.has<BoundingBoxComponent>(entity) && !frustum.isInFrustum(drawSpatial, *ecs.cGetComponent<BoundingBoxComponent>(entity))) {
-						continue;
-					}
-					drawDefines.reset();
-	
-					auto material = ecs.cGetComponent<const MaterialComponent>(entity);
-	
-					MakeDefine(ALPHA_TEST);
-					bool containsAlphaTest = false;
-					if constexpr ((std::is_same_v<AlphaTestComponent, CompTs> || ...) || (std::is_same_v<TransparentComponent, CompTs> || ...)) {
-						containsAlphaTest = true;
+				NEO_UNUSED(ecs);
+
+				static const char* sFaceNames[6] = { "PV0", "PV1", "PV2", "PV3", "PV4", "PV5" };
+
+				// Casters are sorted -- only rebind state when it actually changes
+				const ResolvedShaderInstance* resolvedShader = nullptr;
+				std::optional<TextureHandle> boundAlphaMap;
+				for (const auto& caster : casters) {
+					const bool doAlphaTest = caster.mAlphaMap != NEO_INVALID_HANDLE;
+					if (!resolvedShader || (doAlphaTest && !boundAlphaMap)) {
+						ShaderDefines drawDefines;
+						MakeDefine(ALPHA_TEST);
+						MakeDefine(LAYERED);
+						if (doAlphaTest) {
+							drawDefines.set(ALPHA_TEST);
+						}
+						if (face < 0) {
+							drawDefines.set(LAYERED);
+						}
+						resolvedShader = &resourceManagers.mShaderManager.resolveDefines(shaderHandle, drawDefines);
+						resolvedShader->bind();
+
+						if (face < 0) {
+							for (int i = 0; i < 6; i++) {
+								resolvedShader->bindUniform(sFaceNames[i], faces.mP * faces.mV[i]);
+							}
+						}
+						else {
+							resolvedShader->bindUniform("P", faces.mP);
+							resolvedShader->bindUniform("V", faces.mV[face]);
+						}
+						resolvedShader->bindUniform("lightPos", faces.mLightPos);
+						resolvedShader->bindUniform("lightRange", faces.mLightRange);
 					}
-					bool doAlphaTest = containsAlphaTest && material && resourceManagers.mTextureManager.isValid(material->mAlbedoMap);
-					if (doAlphaTest) {
-						drawDefines.set(ALPHA_TEST);
+
+					if (doAlphaTest && (!boundAlphaMap || boundAlphaMap->mHandle != caster.mAlphaMap.mHandle)) {
+						resolvedShader->bindTexture("alphaMap", resourceManagers.mTextureManager.resolve(caster.mAlphaMap));
+						boundAlphaMap = caster.mAlphaMap;
 					}
-	
-					auto& resolvedShader = resourceManagers.mShaderManager.resolveDefines(shaderHandle, drawDefines);
-					resolvedShader.bind();
-	
-					if (doAlphaTest) {
-						resolvedShader.bindTexture("alphaMap", resourceManagers.mTextureManager.resolve(material->mAlbedoMap));
+
+					if (face < 0) {
+						resolvedShader->bindUniform("faceMask", static_cast<int>(caster.mFaceMask));
 					}
-	
-					resolvedShader.bindUniform("P", camera.getProj());
-					resolvedShader.bindUniform("V", cameraSpatial.getView());
-					resolvedShader.bindUniform("lightPos", cameraSpatial.getPosition());
-					resolvedShader.bindUniform("lightRange", (cameraSpatial.getScale().x - 0.5) / 2.f);
-	
-					resolvedShader.bindUniform("M", drawSpatial.getModelMatrix());
-					resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+					resolvedShader->bindUniform("M", caster.mModelMatrix);
+					resourceManagers.mMeshManager.resolve(caster.mMeshHandle).draw();
 				}
-			}, "Draw pointlight shadow face");
+			}, face < 0 ? "Draw layered pointlight shadow" : "Draw pointlight shadow face");
+		}
+	}
+
+	template<typename... CompTs>
+	inline void drawPointLightShadows(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, const ECS& ecs, const ECS::Entity& lightEntity, const bool clear, PointLightShadowMapParameters params = {}) {
+		TRACY_ZONE();
+
+		NEO_ASSERT(ecs.has<PointLightComponent>(lightEntity) && ecs.has<PointLightShadowMapComponent>(lightEntity), "Invalid light entity for point ligth shadows");
+		const PointLightShadowMapComponent& shadowMap = *ecs.cGetComponent<PointLightShadowMapComponent>(lightEntity);
+		TextureHandle shadowCubeHandle = shadowMap.mShadowMap;
+		if (!resourceManagers.mTextureManager.isValid(shadowCubeHandle)) {
+			return;
+		}
+
+		NEO_ASSERT(ecs.has<SpatialComponent>(lightEntity), "Point light shadows need a spatial");
+
+		const SpatialComponent& lightSpatial = *ecs.cGetComponent<SpatialComponent>(lightEntity);
+		const float range = shadowMap.getFarPlane(lightSpatial);
+		const PointLightFaces faces = _getPointLightFaces(lightSpatial, range, params);
+		util::FrameVector<PointLightCaster> casters = _buildPointLightCasters<CompTs...>(resourceManagers, ecs, faces.mLightPos, range);
+
+		const auto* cache = ecs.cGetComponent<ShadowCacheComponent>(lightEntity);
+		const bool useCache = cache && resourceManagers.mTextureManager.isValid(cache->mStaticShadowMap);
+
+		if (!useCache && params.mLayered) {
+			auto layeredShaderHandle = resourceManagers.mShaderManager.asyncLoad("PointLightShadowMap Layered Shader", SourceShader::ConstructionArgs{
+				{ types::shader::Stage::Vertex, "model.vert"},
+				{ types::shader::Stage::Geometry, "pointlightdepth.geom"},
+				{ types::shader::Stage::Fragment, "pointlightdepth.frag" }
+			});
+			if (!resourceManagers.mShaderManager.isValid(layeredShaderHandle)) {
+				return;
+			}
+
+			FramebufferHandle shadowTargetHandle = _getPointLightShadowTarget(resourceManagers, shadowCubeHandle, -1);
+			if (clear) {
+				renderPasses.clear(shadowTargetHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear point light shadow");
+			}
+			_drawPointLightCasters(renderPasses, resourceManagers, shadowTargetHandle, shadowCubeHandle, layeredShaderHandle, faces, -1, std::move(casters));
+			return;
+		}
+
+		auto shaderHandle = resourceManagers.mShaderManager.asyncLoad("PointLightShadowMap Shader", SourceShader::ConstructionArgs{
+			{ types::shader::Stage::Vertex, "model.vert"},
+			{ types::shader::Stage::Fragment, "pointlightdepth.frag" }
+		});
+		if (!resourceManagers.mShaderManager.isValid(shaderHandle)) {
+			return;
+		}
+
+		for (int i = 0; i < 6; i++) {
+			FramebufferHandle shadowTargetHandle = _getPointLightShadowTarget(resourceManagers, shadowCubeHandle, i);
+
+			if (!useCache) {
+				if (clear) {
+					renderPasses.clear(shadowTargetHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear point light shadow face");
+				}
+				_drawPointLightCasters(renderPasses, resourceManagers, shadowTargetHandle, shadowCubeHandle, shaderHandle, faces, i, _filterPointLightCasters(casters, i, ShadowCasterFilter::All));
+				continue;
+			}
+
+			// Static casters live in the cache and are only redrawn when something invalidates the face
+			// Otherwise the cache is copied over and just the dynamic casters are drawn on top
+			if (!cache->needsUpdate(i)) {
+				continue;
+			}
+			FramebufferHandle cacheTargetHandle = _getPointLightShadowTarget(resourceManagers, cache->mStaticShadowMap, i);
+			if (!resourceManagers.mFramebufferManager.isValid(cacheTargetHandle) || !resourceManagers.mFramebufferManager.isValid(shadowTargetHandle)) {
+				continue;
+			}
+			if (cache->mStaticDirty[i]) {
+				if (clear) {
+					renderPasses.clear(cacheTargetHandle, types::framebuffer::AttachmentBit::Depth, glm::uvec4(0), "Clear cached point light shadow face");
+				}
+				else {
+					// The final face won't be restored from the cache this time around
+					_drawPointLightCasters(renderPasses, resourceManagers, shadowTargetHandle, shadowCubeHandle, shaderHandle, faces, i, _filterPointLightCasters(casters, i, ShadowCasterFilter::Static));
+				}
+				_drawPointLightCasters(renderPasses, resourceManagers, cacheTargetHandle, cache->mStaticShadowMap, shaderHandle, faces, i, _filterPointLightCasters(casters, i, ShadowCasterFilter::Static));
+				cache->mStaticCached[i] = true;
+			}
+			if (clear) {
+				renderPasses.copy(cache->mStaticShadowMap, shadowCubeHandle, 0, static_cast<uint16_t>(i), "Restore cached point light shadow face");
+			}
+			_drawPointLightCasters(renderPasses, resourceManagers, shadowTargetHandle, shadowCubeHandle, shaderHandle, faces, i, _filterPointLightCasters(casters, i, ShadowCasterFilter::Dynamic));
 		}
 	}
 }
@@ -3,6 +3,8 @@
 #include "Renderer/FrameStats.hpp"
 #include "Renderer/GLObjects/RenderStateGL.hpp"
 
+#include "Util/GPUTimers.hpp"
+
 #include "RenderPass.hpp"
 
 namespace neo {
@@ -33,44 +35,81 @@ namespace neo {
 		});
 	}
 
+	void RenderPasses::copy(TextureHandle source, TextureHandle destination, uint16_t mip, uint16_t layer, std::optional<std::string> debugName) {
+		mPasses.emplace_back(CopyPass{
+			source,
+			destination,
+			mip,
+			layer,
+			debugName
+		});
+	}
+
 	void RenderPasses::_execute(FrameStats& renderStats, const ResourceManagers& resourceManagers, const ECS& ecs, bool wireframe) {
 		renderStats.mRenderPasses.clear();
 
+		// Indexed on the variant
+		static const char* sNamelessPasses[] = { "Nameless compute pass", "Nameless render pass", "Nameless clear pass", "Nameless copy pass" };
+
 		TRACY_GPU();
-		for (const auto& pass : mPasses) {
-			util::visit(pass,
-				[&](const ComputePass& computePass) {
-					renderStats.mRenderPasses.emplace_back(computePass.mDebugName.value_or("Nameless compute pass"));
-
-					computePass.mDrawFunction(resourceManagers, ecs);
-				},
-				[&](const RenderPass& renderPass) {
-					renderStats.mRenderPasses.emplace_back(renderPass.mDebugName.value_or("Nameless compute pass"));
-
-					if (!resourceManagers.mFramebufferManager.isValid(renderPass.mTarget)) {
-						NEO_LOG_W("Unable to resolve target, skipping pass %s", renderPass.mDebugName.value_or("").c_str());
-						return;
-					}
-					resourceManagers.mFramebufferManager.resolve(renderPass.mTarget).bind();
-
-					applyRenderState(renderPass.mRenderState, renderPass.mViewport, wireframe && renderPass.mRenderState.mWireframeable);
-
-					renderPass.mDrawFunction(resourceManagers, ecs);
-				},
-				[&](const ClearPass& clearPass) {
-					renderStats.mRenderPasses.emplace_back(clearPass.mDebugName.value_or("Nameless render pass"));
-
-					TRACY_GPUN("Clear");
-					if (!resourceManagers.mFramebufferManager.isValid(clearPass.mTarget)) {
-						NEO_LOG_W("Unable to resolve target, skipping clear %s", clearPass.mDebugName.value_or("").c_str());
-						return;
-					}
-					resourceManagers.mFramebufferManager.resolve(clearPass.mTarget).bind();
-					resourceManagers.mFramebufferManager.resolve(clearPass.mTarget).clear(clearPass.mClearColor, clearPass.mClearFlags);
-
-				},
-				[&](auto) { static_assert(always_false_v<T>, "non-exhaustive visitor!"); }
-			);
+		for (size_t i = 0; i < mPasses.size(); i++) {
+			const auto& pass = mPasses[i];
+			const std::optional<std::string>& debugName = std::visit([](const auto& p) -> const std::optional<std::string>& { return p.mDebugName; }, pass);
+			FrameStats::PassStats passStats;
+			passStats.mName = debugName.value_or(sNamelessPasses[pass.index()]);
+
+			// Counters are bumped on the shared frame stats as draws go out -- the difference is this pass's share
+			const uint32_t draws = renderStats.mNumDraws;
+			const uint32_t primitives = renderStats.mNumPrimitives;
+			const uint32_t uniforms = renderStats.mNumUniforms;
+			const uint32_t samplers = renderStats.mNumSamplers;
+			{
+				util::GPUTimers::Scope gpuTimer(passStats.mName.c_str(), static_cast<int>(i));
+				_executePass(pass, resourceManagers, ecs, wireframe);
+			}
+			passStats.mNumDraws = renderStats.mNumDraws - draws;
+			passStats.mNumPrimitives = renderStats.mNumPrimitives - primitives;
+			passStats.mNumUniforms = renderStats.mNumUniforms - uniforms;
+			passStats.mNumSamplers = renderStats.mNumSamplers - samplers;
+			renderStats.mRenderPasses.emplace_back(std::move(passStats));
 		}
 	}
+
+	void RenderPasses::_executePass(const Pass& pass, const ResourceManagers& resourceManagers, const ECS& ecs, bool wireframe) {
+		util::visit(pass,
+			[&](const ComputePass& computePass) {
+				computePass.mDrawFunction(resourceManagers, ecs);
+			},
+			[&](const RenderPass& renderPass) {
+				if (!resourceManagers.mFramebufferManager.isValid(renderPass.mTarget)) {
+					NEO_LOG_W("Unable to resolve target, skipping pass %s", renderPass.mDebugName.value_or("").c_str());
+					return;
+				}
+				resourceManagers.mFramebufferManager.resolve(renderPass.mTarget).bind();
+
+				applyRenderState(renderPass.mRenderState, renderPass.mViewport, wireframe && renderPass.mRenderState.mWireframeable);
+
+				renderPass.mDrawFunction(resourceManagers, ecs);
+			},
+			[&](const ClearPass& clearPass) {
+				TRACY_GPUN("Clear");
+				if (!resourceManagers.mFramebufferManager.isValid(clearPass.mTarget)) {
+					NEO_LOG_W("Unable to resolve target, skipping clear %s", clearPass.mDebugName.value_or("").c_str());
+					return;
+				}
+				resourceManagers.mFramebufferManager.resolve(clearPass.mTarget).bind();
+				resourceManagers.mFramebufferManager.resolve(clearPass.mTarget).clear(clearPass.mClearColor, clearPass.mClearFlags);
+
+			},
+			[&](const CopyPass& copyPass) {
+				TRACY_GPUN("Copy");
+				if (!resourceManagers.mTextureManager.isValid(copyPass.mSource) || !resourceManagers.mTextureManager.isValid(copyPass.mDestination)) {
+					NEO_LOG_W("Unable to resolve textures, skipping copy %s", copyPass.mDebugName.value_or("").c_str());
+					return;
+				}
+				resourceManagers.mTextureManager.resolve(copyPass.mSource).copyTo(resourceManagers.mTextureManager.resolve(copyPass.mDestination), copyPass.mMip, copyPass.mLayer);
+			},
+			[&](auto) { static_assert(always_false_v<T>, "non-exhaustive visitor!"); }
+		);
+	}
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "ResourceManager/ResourceManagers.hpp"
 #include "Renderer/RenderingSystems/RenderState.hpp"
 
+#include "Util/FrameArena.hpp"
+
 namespace neo {
 	class ECS;
 
@@ -16,6 +18,8 @@ namespace neo {
 
 		void computePass(DrawFunction draw, std::optional<std::string> debugName = std::nullopt);
 
+		void copy(TextureHandle source, TextureHandle destination, uint16_t mip = 0, uint16_t layer = 0, std::optional<std::string> debugName = std::nullopt);
+
 	private:
 		void _execute(FrameStats& stats, const ResourceManagers& resourceManagers, const ECS& ecs, bool wireframe);
 		bool mWireframeOverride = false;
@@ -37,6 +41,16 @@ namespace neo {
 			glm::vec4 mClearColor;
 			std::optional<std::string> mDebugName;
 		};
-		std::vector<std::variant<ComputePass, RenderPass, ClearPass>> mPasses;
+		struct CopyPass {
+			TextureHandle mSource;
+			TextureHandle mDestination;
+			uint16_t mMip;
+			uint16_t mLayer;
+			std::optional<std::string> mDebugName;
+		};
+		using Pass = std::variant<ComputePass, RenderPass, ClearPass, CopyPass>;
+		// Rebuilt every frame
+		util::FrameVector<Pass> mPasses;
+		void _executePass(const Pass& pass, const ResourceManagers& resourceManagers, const ECS& ecs, bool wireframe);
 	};
 }
\ No newline at end of file
@@ -7,18 +7,22 @@
 
 namespace neo {
 
-	inline TextureHandle tonemap(RenderPasses& renderPasses, const ResourceManagers& resourceManagers, glm::uvec2 dimension, TextureHandle inputTextureHandle, TextureHandle averageLuminance = NEO_INVALID_HANDLE) {
+	inline TextureHandle tonemap(RenderPasses& renderPasses, ResourceManagers& resourceManagers, glm::uvec2 dimension, TextureHandle inputTextureHandle, TextureHandle averageLuminance = NEO_INVALID_HANDLE) {
 		TRACY_ZONE();
 
 		if (!resourceManagers.mTextureManager.isValid(inputTextureHandle)) {
 			return NEO_INVALID_HANDLE;
 		}
 
-		auto tonemapTargetHandle = resourceManagers.mFramebufferManager.asyncLoad(
+		TextureHandle tonemapTexture = resourceManagers.mTextureManager.acquireTransient(
+			TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGB8_UNORM },
+			glm::u16vec3(dimension, 0)
+		);
+		auto tonemapTargetHandle = resourceManagers.mFramebufferManager.acquireTransient(
 			"Tonemapped",
-			FramebufferBuilder{}
-				.setSize(dimension)
-				.attach(TextureFormat{ types::texture::Target::Texture2D, types::texture::InternalFormats::RGB8_UNORM }),
+			FramebufferExternalAttachments{
+				FramebufferAttachment{tonemapTexture}
+			},
 			resourceManagers.mTextureManager
 		);
 		renderPasses.clear(tonemapTargetHandle, types::framebuffer::AttachmentBit::Color, glm::vec4(0.f, 0.f, 0.f, 1.f), "Clear tonemap target");
@@ -51,10 +55,6 @@ namespace neo {
 			resourceManagers.mMeshManager.resolve("quad").draw();
 		}, "Tonemap");
 
-		if (resourceManagers.mFramebufferManager.isValid(tonemapTargetHandle)) {
-			return resourceManagers.mFramebufferManager.resolve(tonemapTargetHandle).mTextures[0];
-		}
-
-		return NEO_INVALID_HANDLE;
+		return tonemapTexture;
 	}
 }
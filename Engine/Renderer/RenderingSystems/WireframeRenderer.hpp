@@ -43,7 +43,9 @@ namespace neo {
 			resolvedShader.bindUniform("M", view.get<const SpatialComponent>(entity).getModelMatrix());
 			resolvedShader.bindUniform("color", view.get<const WireframeRenderComponent>(entity).mColor);
 
-			resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+			if (resourceManagers.mMeshManager.isValid(view.get<const MeshComponent>(entity).mMeshHandle)) {
+				resourceManagers.mMeshManager.resolve(view.get<const MeshComponent>(entity).mMeshHandle).draw();
+			}
 		}
 
 		glEnable(GL_CULL_FACE);
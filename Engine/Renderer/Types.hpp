@@ -13,7 +13,9 @@ namespace neo {
 			UnsignedInt,
 			UnsignedInt24_8,
 			Double,
-			Float
+			Float,
+			HalfFloat,
+			Int2_10_10_10_Rev, // Packed xyz + 2 bit w, for quantized normals and tangents
 		};
 
 		namespace shader {
@@ -50,6 +52,7 @@ namespace neo {
 				TargetCubeY_Negative,
 				TargetCubeZ_Positive,
 				TargetCubeZ_Negative,
+				TargetLayered, // Every layer/face at once -- for gl_Layer rendering
 			};
 
 			enum class AttachmentBit : uint8_t {
@@ -46,6 +46,21 @@ namespace neo {
 			return FramebufferHandle(seed);
 		}
 
+		bool validAttachments(const FramebufferQueueItem& item, const TextureManager& textureManager) {
+			for (auto& attachment : item.mAttachments) {
+				if (!textureManager.isValid(attachment.mHandle)) {
+					NEO_LOG_W("Trying to create a framebuffer %s with invalid texture attachments -- skipping", item.mDebugName.value_or("").c_str());
+					return false;
+				}
+				auto& texture = textureManager.resolve(attachment.mHandle);
+				if (texture.mFormat.mTarget == types::texture::Target::Texture2D && attachment.mTarget != types::framebuffer::AttachmentTarget::Target2D) {
+					NEO_LOG_E("Trying to bind non-2D target to a 2D texture");
+					return false;
+				}
+			}
+			return true;
+		}
+
 		struct FramebufferLoader final : entt::resource_loader<FramebufferLoader, BackedResource<PooledFramebuffer>> {
 
 			std::shared_ptr<BackedResource<PooledFramebuffer>> load(const FramebufferQueueItem& details, const TextureManager& textureManager) const {
@@ -117,6 +132,21 @@ namespace neo {
 		return dstId;
 	}
 
+	[[nodiscard]] FramebufferHandle FramebufferManager::acquireTransient(HashedString id, FramebufferExternalAttachments attachments, const TextureManager& textureManager) {
+		FramebufferLoadDetails details = attachments;
+		FramebufferHandle dstId = swizzleSrcId(id, details, textureManager);
+		if (isValid(dstId)) {
+			return dstId;
+		}
+
+		FramebufferQueueItem item{ dstId, attachments, true, std::string(id) };
+		if (!validAttachments(item, textureManager)) {
+			return NEO_INVALID_HANDLE;
+		}
+		mCache.load<FramebufferLoader>(dstId.mHandle, item, textureManager);
+		return dstId;
+	}
+
 	Framebuffer& FramebufferManager::_resolveFinal(FramebufferHandle id) const {
 		auto handle = mCache.handle(id.mHandle);
 		if (handle) {
@@ -141,24 +171,10 @@ namespace neo {
 		std::swap(mQueue, swapQueue);
 		mQueue.clear();
 		for (auto& item : swapQueue) {
-			bool validTextures = true;
-			for (auto& attachment : item.mAttachments) {
-				if (!textureManager.isValid(attachment.mHandle)) {
-					NEO_LOG_W("Trying to create a framebuffer %s with invalid texture attachments -- skipping", item.mDebugName.value_or("").c_str());
-					validTextures = false;
-					break;
-				}
-				else {
-					auto& texture = textureManager.resolve(attachment.mHandle);
-					if (texture.mFormat.mTarget == types::texture::Target::Texture2D && attachment.mTarget != types::framebuffer::AttachmentTarget::Target2D) {
-						NEO_LOG_E("Trying to bind non-2D target to a 2D texture");
-						validTextures = false;
-						break;
-					}
-				}
-			}
-			if (validTextures) {
+			if (validAttachments(item, textureManager)) {
+				const uint64_t loadStart = getCurrentTimestamp();
 				mCache.load<FramebufferLoader>(item.mHandle.mHandle, item, textureManager);
+				mStats.recordLoad(item.mHandle.mHandle, item.mDebugName, item.mQueuedTime, loadStart, getCurrentTimestamp(), 0, false);
 			}
 		}
 
@@ -186,6 +202,10 @@ namespace neo {
 		for (auto& discardId : discardQueue) {
 			mCache.discard(discardId.mHandle);
 		}
+
+		mStats.endTick();
+		mStats.setDepths(static_cast<uint32_t>(mQueue.size()), 0, 0, 0);
+		mStats.setResidency(static_cast<uint32_t>(mCache.size()), 0);
 	}
 
 	void FramebufferManager::imguiEditor(std::function<void(const TextureHandle&)> textureFunc, TextureManager& textureManager) {
@@ -202,13 +222,12 @@ namespace neo {
 				else {
 					ImGui::Text(pfb.mResource.mExternallyOwned ? "%d" : "*%d", id);
 				}
-				if (textureManager.isValid(pfb.mResource.mFramebuffer.mTextures[0])) {
-					auto& firstTex = textureManager.resolve(pfb.mResource.mFramebuffer.mTextures[0]);
-					ImGui::Text("[%d, %d]", firstTex.mWidth, firstTex.mHeight);
+				if (const Texture* firstTex = textureManager.peek(pfb.mResource.mFramebuffer.mTextures[0])) {
+					ImGui::Text("[%d, %d]", firstTex->mWidth, firstTex->mHeight);
 				}
 				ImGui::TableSetColumnIndex(1);
 				for (auto texId = pfb.mResource.mFramebuffer.mTextures.begin(); texId < pfb.mResource.mFramebuffer.mTextures.end(); texId++) {
-					if (textureManager.isValid(*texId)) {
+					if (textureManager.peek(*texId)) {
 						textureFunc(*texId);
 						if (texId != std::prev(pfb.mResource.mFramebuffer.mTextures.end())) {
 							ImGui::SameLine();
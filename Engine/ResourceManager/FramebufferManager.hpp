@@ -3,6 +3,7 @@
 #include "Util/Util.hpp"
 
 #include "ResourceManager/TextureManager.hpp"
+#include "ResourceManager/ResourceManagerStats.hpp"
 #include "Renderer/GLObjects/Framebuffer.hpp"
 
 #include <entt/resource/cache.hpp>
@@ -68,6 +69,7 @@ namespace neo {
 		std::vector<FramebufferAttachment> mAttachments;
 		bool mExternallyOwned = false;
 		std::optional<std::string> mDebugName;
+		uint64_t mQueuedTime = getCurrentTimestamp();
 	};
 
 	class FramebufferManager {
@@ -115,6 +117,17 @@ namespace neo {
 
 		[[nodiscard]] FramebufferHandle asyncLoad(HashedString id, FramebufferLoadDetails details, const TextureManager& textureManager) const;
 
+		// Safe to call from any thread. Attachments are counted by the texture manager, so there are no GPU bytes here
+		ResourceManagerStats getStats() const {
+			return mStats.snapshot();
+		}
+		std::vector<LoadTimeline> getLoadTimelines() const {
+			return mStats.timelines();
+		}
+		// Created immediately instead of on the next tick -- for wrapping TextureManager::acquireTransient textures.
+		// Pooled on the attachments, so it ages out on its own once they stop being handed out. Render thread only
+		[[nodiscard]] FramebufferHandle acquireTransient(HashedString id, FramebufferExternalAttachments attachments, const TextureManager& textureManager);
+
 	protected:
 
 		void clear(const TextureManager& textureManager);
@@ -127,6 +140,7 @@ namespace neo {
 		mutable std::vector<FramebufferQueueItem> mQueue;
 		entt::resource_cache<BackedResource<PooledFramebuffer>> mCache;
 		std::shared_ptr<Framebuffer> mFallback;
+		ResourceStatsRecorder mStats;
 
 	private:
 		Framebuffer& _resolveFinal(FramebufferHandle id) const;
@@ -10,10 +10,14 @@ namespace neo {
 
 	struct MeshLoader final : entt::resource_loader<MeshLoader, BackedResource<Mesh>> {
 
-		std::shared_ptr<BackedResource<Mesh>> load(MeshLoadDetails meshDetails, const std::optional<std::string>& debugName) const {
+		// Buffers that live in staging get allocated empty and filled with a GPU copy
+		std::shared_ptr<BackedResource<Mesh>> load(const MeshLoadDetails& meshDetails, const std::optional<std::string>& debugName, const UploadBuffer* staging = nullptr) const {
 			if (debugName.has_value()) {
 				NEO_LOG_V("Uploading mesh %s", debugName.value().c_str());
 			}
+			auto isStaged = [staging](const uint8_t* data) {
+				return staging && data && staging->contains(data);
+			};
 			std::shared_ptr<BackedResource<Mesh>> meshResource = std::make_shared<BackedResource<Mesh>>(meshDetails.mPrimtive);
 			meshResource->mResource.init(debugName);
 			for (auto&& [type, buffer] : meshDetails.mVertexBuffers) {
@@ -26,36 +30,128 @@ namespace neo {
 					buffer.mCount,
 					buffer.mOffset,
 					buffer.mByteSize,
-					buffer.mData
+					isStaged(buffer.mData) ? nullptr : buffer.mData
 				);
+				if (isStaged(buffer.mData)) {
+					meshResource->mResource.copyVertexBuffer(type, staging->mBufferID, staging->getOffset(buffer.mData), buffer.mByteSize);
+				}
+			}
+			if (meshDetails.mInterleavedBuffer) {
+				meshResource->mResource.addInterleavedBuffer(
+					meshDetails.mInterleavedBuffer->mStride,
+					meshDetails.mInterleavedBuffer->mCount,
+					meshDetails.mInterleavedBuffer->mByteSize,
+					isStaged(meshDetails.mInterleavedBuffer->mData) ? nullptr : meshDetails.mInterleavedBuffer->mData
+				);
+				if (isStaged(meshDetails.mInterleavedBuffer->mData)) {
+					meshResource->mResource.copyInterleavedBuffer(staging->mBufferID, staging->getOffset(meshDetails.mInterleavedBuffer->mData), meshDetails.mInterleavedBuffer->mByteSize);
+				}
+				for (auto&& [type, attribute] : meshDetails.mInterleavedBuffer->mAttributes) {
+					meshResource->mResource.addInterleavedAttribute(
+						type,
+						attribute.mComponents,
+						attribute.mFormat,
+						attribute.mNormalized,
+						attribute.mOffset
+					);
+				}
 			}
+			meshResource->mResource.mPositionScale = meshDetails.mPositionScale;
+			meshResource->mResource.mPositionBias = meshDetails.mPositionBias;
 			if (meshDetails.mElementBuffer) {
 				meshResource->mResource.addElementBuffer(
 					meshDetails.mElementBuffer->mCount,
 					meshDetails.mElementBuffer->mFormat,
 					meshDetails.mElementBuffer->mByteSize,
-					meshDetails.mElementBuffer->mData
+					isStaged(meshDetails.mElementBuffer->mData) ? nullptr : meshDetails.mElementBuffer->mData
 				);
+				if (isStaged(meshDetails.mElementBuffer->mData)) {
+					meshResource->mResource.copyElementBuffer(staging->mBufferID, staging->getOffset(meshDetails.mElementBuffer->mData), meshDetails.mElementBuffer->mByteSize);
+				}
 			}
 			meshResource->mDebugName = debugName;
 			return meshResource;
 		}
 	};
 
+	namespace {
+		const uint32_t sStagingSize = 64u << 20;
+
+		template<typename Func>
+		void _eachBuffer(const MeshLoadDetails& details, Func func) {
+			for (auto&& [type, buffer] : details.mVertexBuffers) {
+				func(buffer.mData, buffer.mByteSize);
+			}
+			if (details.mInterleavedBuffer.has_value()) {
+				func(details.mInterleavedBuffer->mData, details.mInterleavedBuffer->mByteSize);
+			}
+			if (details.mElementBuffer.has_value()) {
+				func(details.mElementBuffer->mData, details.mElementBuffer->mByteSize);
+			}
+		}
+
+		uint64_t _contentBytes(const MeshLoadDetails& details) {
+			uint64_t byteSize = 0;
+			_eachBuffer(details, [&](const uint8_t*, uint32_t size) { byteSize += size; });
+			return byteSize;
+		}
+
+		// Layout and bytes of every buffer. Returns 0 for meshes that can't be shared
+		uint64_t _contentHash(const MeshLoadDetails& details, uint64_t seed = 0) {
+			bool complete = true;
+			_eachBuffer(details, [&](const uint8_t* data, uint32_t) { complete &= data != nullptr; });
+			if (!details.mDeduplicate || !complete) {
+				return 0;
+			}
+
+			uint64_t hash = util::hashCombine(seed, static_cast<uint32_t>(details.mPrimtive));
+			for (int i = 0; i < 3; i++) {
+				hash = util::hashCombine(hash, details.mPositionScale[i]);
+				hash = util::hashCombine(hash, details.mPositionBias[i]);
+			}
+			// Summed so the map's iteration order doesn't matter
+			for (auto&& [type, buffer] : details.mVertexBuffers) {
+				uint64_t bufferSeed = util::hashCombine(seed, static_cast<uint32_t>(type));
+				bufferSeed = util::hashCombine(bufferSeed, buffer.mComponents);
+				bufferSeed = util::hashCombine(bufferSeed, buffer.mStride);
+				bufferSeed = util::hashCombine(bufferSeed, static_cast<uint32_t>(buffer.mFormat));
+				bufferSeed = util::hashCombine(bufferSeed, buffer.mNormalized);
+				bufferSeed = util::hashCombine(bufferSeed, buffer.mCount);
+				bufferSeed = util::hashCombine(bufferSeed, buffer.mOffset);
+				hash += util::hashBytes(buffer.mData, buffer.mByteSize, bufferSeed);
+			}
+			if (details.mInterleavedBuffer) {
+				uint64_t bufferSeed = util::hashCombine(seed, details.mInterleavedBuffer->mStride);
+				bufferSeed = util::hashCombine(bufferSeed, details.mInterleavedBuffer->mCount);
+				for (auto&& [type, attribute] : details.mInterleavedBuffer->mAttributes) {
+					uint64_t attributeSeed = util::hashCombine(0, static_cast<uint32_t>(type));
+					attributeSeed = util::hashCombine(attributeSeed, attribute.mComponents);
+					attributeSeed = util::hashCombine(attributeSeed, static_cast<uint32_t>(attribute.mFormat));
+					attributeSeed = util::hashCombine(attributeSeed, attribute.mNormalized);
+					attributeSeed = util::hashCombine(attributeSeed, attribute.mOffset);
+					bufferSeed += attributeSeed;
+				}
+				hash += util::hashBytes(details.mInterleavedBuffer->mData, details.mInterleavedBuffer->mByteSize, bufferSeed);
+			}
+			if (details.mElementBuffer) {
+				uint64_t bufferSeed = util::hashCombine(seed, details.mElementBuffer->mCount);
+				bufferSeed = util::hashCombine(bufferSeed, static_cast<uint32_t>(details.mElementBuffer->mFormat));
+				hash += util::hashBytes(details.mElementBuffer->mData, details.mElementBuffer->mByteSize, bufferSeed);
+			}
+			return hash ? hash : 1; // 0 means not shared
+		}
+	}
+
 	MeshManager::MeshManager() {
+		mStaging.init(sStagingSize);
 		auto cubeDetails = prefabs::generateCube();
 		mFallback = MeshLoader{}.load(*cubeDetails, "Fallback Cube");
-		for (auto&& [type, buffer] : cubeDetails->mVertexBuffers) {
-			delete[] buffer.mData;
-		}
-		if (cubeDetails->mElementBuffer) {
-			delete[] cubeDetails->mElementBuffer->mData;
-		}
 	}
 
 	MeshManager::~MeshManager() {
 		mFallback->mResource.destroy();
 		mFallback.reset();
+		mStaging.destroy();
 	}
 
 	[[nodiscard]] MeshHandle MeshManager::_asyncLoadImpl(MeshHandle id, MeshLoadDetails meshDetails, const std::optional<std::string>& debugName) const {
@@ -63,22 +159,44 @@ namespace neo {
 			NEO_LOG_V("Loading mesh %s", debugName->c_str());
 		}
 
-		// Copy data so this can be ticked next frame
-		MeshLoadDetails copy = meshDetails;
-		for (auto&& [type, buffer] : meshDetails.mVertexBuffers) {
-			if (buffer.mData) {
-				copy.mVertexBuffers[type].mData = new uint8_t[buffer.mByteSize];
-				memcpy(const_cast<uint8_t*>(copy.mVertexBuffers[type].mData), buffer.mData, buffer.mByteSize);
+		// Kit pieces that show up in several imports just alias the mesh that's already there
+		uint64_t contentHash = _contentHash(meshDetails);
+		if (contentHash && _shareContent(id, contentHash, _contentBytes(meshDetails), _contentHash(meshDetails, sContentCheckSeed))) {
+			return id;
+		}
+
+		// Data needs to outlive the caller so this can be ticked next frame
+		// Straight into the staging buffer if there's room, then the render thread only has to kick off a GPU copy
+		// Otherwise hold on to the caller's buffer, and only copy what the caller didn't hand over
+		auto takeData = [this](const uint8_t*& data, std::shared_ptr<const void>& owner, uint32_t byteSize) {
+			if (!data) {
+				return;
+			}
+			if (uint8_t* staged = mStaging.allocate(byteSize)) {
+				memcpy(staged, data, byteSize);
+				data = staged;
+				owner.reset();
+			}
+			else if (!owner) {
+				uint8_t* copied = new uint8_t[byteSize];
+				memcpy(copied, data, byteSize);
+				data = copied;
+				owner = util::adoptBytes(copied);
 			}
+		};
+		for (auto&& [type, buffer] : meshDetails.mVertexBuffers) {
+			takeData(buffer.mData, buffer.mOwner, buffer.mByteSize);
+		}
+		if (meshDetails.mInterleavedBuffer.has_value()) {
+			takeData(meshDetails.mInterleavedBuffer->mData, meshDetails.mInterleavedBuffer->mOwner, meshDetails.mInterleavedBuffer->mByteSize);
 		}
-		if (meshDetails.mElementBuffer.has_value() && meshDetails.mElementBuffer->mData) {
-			copy.mElementBuffer->mData = new uint8_t[meshDetails.mElementBuffer->mByteSize];
-			memcpy(const_cast<uint8_t*>(copy.mElementBuffer->mData), meshDetails.mElementBuffer->mData, meshDetails.mElementBuffer->mByteSize);
+		if (meshDetails.mElementBuffer.has_value()) {
+			takeData(meshDetails.mElementBuffer->mData, meshDetails.mElementBuffer->mOwner, meshDetails.mElementBuffer->mByteSize);
 		}
 
 		{
 			std::lock_guard<std::mutex> lock(mLoadQueueMutex);
-			mLoadQueue.emplace_back(ResourceLoadDetails_Internal{ id,  copy, debugName });
+			mLoadQueue.emplace_back(ResourceLoadDetails_Internal{ id, std::move(meshDetails), debugName, contentHash });
 		}
 
 		return id;
@@ -87,6 +205,9 @@ namespace neo {
 	void MeshManager::_tickImpl() {
 		TRACY_ZONE();
 
+		_tickPending();
+		_tickContent();
+
 		{
 			std::vector<ResourceLoadDetails_Internal> swapQueue = {};
 			{
@@ -95,15 +216,38 @@ namespace neo {
 				mLoadQueue.clear();
 			}
 			TRACY_GPUN("Load");
-			for (auto& details : swapQueue) {
+			uint32_t uploadedBytes = 0;
+			size_t loaded = 0;
+			for (; loaded < swapQueue.size(); loaded++) {
+				auto& details = swapQueue[loaded];
+				uint32_t byteSize = 0;
+				_eachBuffer(details.mLoadDetails, [&](const uint8_t*, uint32_t size) { byteSize += size; });
+				if (uploadedBytes > 0 && uploadedBytes + byteSize > mUploadBudget) {
+					break;
+				}
+				uploadedBytes += byteSize;
+
 				TRACY_GPUN("Create Single");
-				mCache.load<MeshLoader>(details.mHandle.mHandle, details.mLoadDetails, details.mDebugName);
-				for (auto&& [type, buffer] : details.mLoadDetails.mVertexBuffers) {
-					delete[] buffer.mData;
+				const uint64_t loadStart = getCurrentTimestamp();
+				std::vector<const void*> stagedData;
+				_eachBuffer(details.mLoadDetails, [&](const uint8_t* data, uint32_t) {
+					if (data && mStaging.contains(data)) {
+						stagedData.push_back(data);
+					}
+				});
+				if (stagedData.empty()) {
+					_storeResource(details.mHandle, MeshLoader{}.load(details.mLoadDetails, details.mDebugName), details.mContentHash);
 				}
-				if (details.mLoadDetails.mElementBuffer.has_value()) {
-					delete[] details.mLoadDetails.mElementBuffer->mData;
+				else if (auto mesh = MeshLoader{}.load(details.mLoadDetails, details.mDebugName, &mStaging)) {
+					_addPending(details.mHandle, mesh, stagedData, details.mContentHash);
 				}
+				_recordLoad(details, loadStart, byteSize);
+			}
+
+			// Whatever didn't fit in the budget goes back to the front of the line
+			if (loaded < swapQueue.size()) {
+				std::lock_guard<std::mutex> lock(mLoadQueueMutex);
+				mLoadQueue.insert(mLoadQueue.begin(), std::make_move_iterator(swapQueue.begin() + loaded), std::make_move_iterator(swapQueue.end()));
 			}
 		}
 
@@ -119,8 +263,16 @@ namespace neo {
 				TRACY_GPUN("Transact");
 				for (auto&& [handle, func] : swapQueue) {
 					TRACY_GPUN("Transact Single");
-					if (isValid(handle)) {
-						func(mCache.handle(handle.mHandle).get().mResource);
+					if (_isSharedContent(handle)) {
+						NEO_LOG_E("Attempting to transact on a deduplicated mesh");
+					}
+					else if (isValid(handle)) {
+						func(_cacheHandle(handle.mHandle).get().mResource);
+					}
+					else if (isQueued(handle)) {
+						// Still uploading
+						std::lock_guard<std::mutex> lock(mTransactionQueueMutex);
+						mTransactionQueue.emplace_back(handle, func);
 					}
 					else {
 						NEO_LOG_E("Attempting to transact on an invalid mesh");
@@ -141,9 +293,27 @@ namespace neo {
 				TRACY_GPUN("Destroy");
 				for (auto& id : swapQueue) {
 					TRACY_GPUN("Destroy Single");
+					if (_releaseContent(id)) {
+						continue;
+					}
 					if (isValid(id)) {
-						_destroyImpl(mCache.handle(id.mHandle).get());
-						mCache.discard(id.mHandle);
+						_destroyImpl(_cacheHandle(id.mHandle).get());
+						_cacheDiscard(id.mHandle);
+					}
+					else if (!_discardPending(id)) {
+						// Still waiting on the upload budget
+						std::lock_guard<std::mutex> lock(mLoadQueueMutex);
+						for (int i = 0; i < mLoadQueue.size(); i++) {
+							if (id == mLoadQueue[i].mHandle) {
+								_eachBuffer(mLoadQueue[i].mLoadDetails, [this](const uint8_t* data, uint32_t) {
+									if (data && mStaging.contains(data)) {
+										mStaging.release(data);
+									}
+								});
+								mLoadQueue.erase(mLoadQueue.begin() + i);
+								break;
+							}
+						}
 					}
 				}
 			}
@@ -155,7 +325,7 @@ namespace neo {
 	}
 
 	void MeshManager::imguiEditor() {
-		mCache.each([](const MeshHandle id, const BackedResource<Mesh>& mesh) {
+		_cacheEach([](const MeshHandle id, const BackedResource<Mesh>& mesh) {
 			NEO_UNUSED(mesh);
 			if (mesh.mDebugName.has_value()) {
 				ImGui::Text(mesh.mDebugName->c_str());
@@ -6,6 +6,7 @@
 namespace neo {
 	class ResourceManagers;
 
+	// Buffer data is copied on asyncLoad unless mOwner is set -- then the manager holds a reference until it's uploaded
 	struct MeshLoadDetails {
 		types::mesh::Primitive mPrimtive;
 
@@ -18,15 +19,40 @@ namespace neo {
 			uint32_t mOffset; 
 			uint32_t mByteSize; 
 			const uint8_t* mData = nullptr;
+			std::shared_ptr<const void> mOwner;
 		};
 		struct ElementBuffer {
 			uint32_t mCount;
 			types::ByteFormats mFormat;
 			uint32_t mByteSize;
 			const uint8_t* mData = nullptr;
+			std::shared_ptr<const void> mOwner;
+		};
+		// All attributes packed into one buffer
+		struct InterleavedBuffer {
+			struct Attribute {
+				uint32_t mComponents;
+				types::ByteFormats mFormat;
+				bool mNormalized;
+				uint32_t mOffset;
+			};
+			uint32_t mStride;
+			uint32_t mCount;
+			uint32_t mByteSize;
+			const uint8_t* mData = nullptr;
+			std::shared_ptr<const void> mOwner;
+			std::unordered_map<types::mesh::VertexType, Attribute> mAttributes;
 		};
 		std::unordered_map<types::mesh::VertexType, VertexBuffer> mVertexBuffers;
+		std::optional<InterleavedBuffer> mInterleavedBuffer;
 		std::optional<ElementBuffer> mElementBuffer;
+
+		// Quantized positions are stored as unorm and unpacked with pos * scale + bias
+		glm::vec3 mPositionScale = glm::vec3(1.f);
+		glm::vec3 mPositionBias = glm::vec3(0.f);
+
+		// Share GPU buffers with any other mesh that has identical contents. Don't transact on these
+		bool mDeduplicate = false;
 	};
 	using MeshHandle = ResourceHandle<Mesh>;
 
@@ -43,6 +69,7 @@ namespace neo {
 		[[nodiscard]] MeshHandle _asyncLoadImpl(MeshHandle id, MeshLoadDetails meshDetails, const std::optional<std::string>& debugName) const;
 		void _destroyImpl(BackedResource<Mesh>& mesh);
 		void _tickImpl();
+		static uint64_t _gpuBytes(const Mesh& mesh) { return mesh.getByteSize(); }
 
 	};
 }
\ No newline at end of file
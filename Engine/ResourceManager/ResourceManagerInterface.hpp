@@ -2,12 +2,22 @@
 
 #include "Util/Util.hpp"
 
+#include "ResourceManager/ResourceManagerStats.hpp"
+#include "Renderer/GLObjects/UploadBuffer.hpp"
+
 #include <entt/resource/cache.hpp>
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <optional>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
 #include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace neo {
 	namespace {
@@ -60,13 +70,22 @@ namespace neo {
 		const uint64_t mCreationTimeStamp;
 	};
 
+	// Hands back a resource that was already built -- for staged uploads that have finished
+	template<typename ResourceType>
+	struct ResourceReadyLoader final : entt::resource_loader<ResourceReadyLoader<ResourceType>, BackedResource<ResourceType>> {
+		std::shared_ptr<BackedResource<ResourceType>> load(std::shared_ptr<BackedResource<ResourceType>> resource) const {
+			return resource;
+		}
+	};
+
 	template<typename DerivedManager, typename ResourceType, typename ResourceLoadDetails>
 	class ResourceManagerInterface {
 		friend ResourceManagers;
 	public:
 
 		bool isValid(const ResourceHandle<ResourceType>& id) const {
-			return id != NEO_INVALID_HANDLE && mCache.contains(id.mHandle);
+			mark(id);
+			return id != NEO_INVALID_HANDLE && _cacheContains(id.mHandle);
 		}
 
 		bool isQueued(const ResourceHandle<ResourceType>& id) const {
@@ -83,6 +102,25 @@ namespace neo {
 					}
 				}
 			}
+			{
+				std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+				for (auto& pending : mPendingQueue) {
+					if (id == pending.mHandle && !pending.mDiscarded) {
+						return true;
+					}
+				}
+			}
+			{
+				// Aliases of shared contents that haven't been hooked up yet
+				std::lock_guard<std::mutex> lock(mContentMutex);
+				auto hash = mContentHashes.find(id.mHandle);
+				if (hash != mContentHashes.end()) {
+					const auto& waiting = mSharedContent.at(hash->second).mWaiting;
+					if (std::find(waiting.begin(), waiting.end(), id) != waiting.end()) {
+						return true;
+					}
+				}
+			}
 			return false;
 		}
 
@@ -119,6 +157,16 @@ namespace neo {
 			return _resolveFinal(id).mResource;
 		}
 
+		// For tools that only want to look -- doesn't mark it, finish its upload, or fail. Null until it's loaded
+		// Same lifetime as resolve
+		const ResourceType* peek(const ResourceHandle<ResourceType>& id) const {
+			if (id == NEO_INVALID_HANDLE) {
+				return nullptr;
+			}
+			auto handle = _cacheHandle(id.mHandle);
+			return handle ? &handle.get().mResource : nullptr;
+		}
+
 		uint64_t getTimeStamp(const HashedString& id) const {
 			return getTimeStamp(ResourceHandle<ResourceType>(id));
 		}
@@ -128,14 +176,15 @@ namespace neo {
 		}
 
 		[[nodiscard]] ResourceHandle<ResourceType> asyncLoad(HashedString id, ResourceLoadDetails details) const {
-			return asyncLoad(ResourceHandle<ResourceType>(id.value()), details, std::string(id.data()));
+			return asyncLoad(ResourceHandle<ResourceType>(id.value()), std::move(details), std::string(id.data()));
 		}
 
 		[[nodiscard]] ResourceHandle<ResourceType> asyncLoad(ResourceHandle<ResourceType> id, ResourceLoadDetails details, std::optional<std::string> debugName = std::nullopt) const {
+			mark(id);
 			if (!isDiscardQueued(id) && (isValid(id) || isQueued(id))) {
 				return id;
 			}
-			return static_cast<const DerivedManager*>(this)->_asyncLoadImpl(id, details, debugName);
+			return static_cast<const DerivedManager*>(this)->_asyncLoadImpl(id, std::move(details), debugName);
 		}
 
 		void transact(ResourceHandle<ResourceType> handle, std::function<void(ResourceType&)> transaction) const {
@@ -150,11 +199,38 @@ namespace neo {
 			}
 		}
 
+		// Warm demo swaps discard whatever wasn't marked between _beginMark and _sweep.
+		// Loading, resolving, or checking a resource's validity marks it too
+		void mark(const ResourceHandle<ResourceType>& id) const {
+			if (mMarking.load(std::memory_order_relaxed) && id != NEO_INVALID_HANDLE) {
+				std::lock_guard<std::mutex> lock(mMarkMutex);
+				mMarked.insert(id.mHandle);
+			}
+		}
+
+		// Survives every sweep
+		void retain(const ResourceHandle<ResourceType>& id) const {
+			std::lock_guard<std::mutex> lock(mMarkMutex);
+			mRetained.insert(id.mHandle);
+		}
+
+		uint32_t mUploadBudget = 32u << 20; // Bytes uploaded per tick -- whatever doesn't fit waits for the next one
+
+		// Safe to call from any thread
+		ResourceManagerStats getStats() const {
+			return mStats.snapshot();
+		}
+		std::vector<LoadTimeline> getLoadTimelines() const {
+			return mStats.timelines();
+		}
+
 	protected:
 		struct ResourceLoadDetails_Internal {
 			ResourceHandle<ResourceType> mHandle;
 			ResourceLoadDetails mLoadDetails;
 			std::optional<std::string> mDebugName;
+			uint64_t mContentHash = 0; // Non-zero if other handles may share what this loads
+			uint64_t mQueuedTime = getCurrentTimestamp();
 		};
 
 		void clear() {
@@ -170,14 +246,303 @@ namespace neo {
 				std::lock_guard<std::mutex> lock(mTransactionQueueMutex);
 				mTransactionQueue.clear();
 			}
-			mCache.each([this](BackedResource<ResourceType>& resource) {
-				static_cast<DerivedManager*>(this)->_destroyImpl(resource);
+			{
+				std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+				for (auto& pending : mPendingQueue) {
+					UploadBuffer::deleteFence(pending.mFence);
+					static_cast<DerivedManager*>(this)->_destroyImpl(*pending.mResource);
+				}
+				mPendingQueue.clear();
+			}
+			if (mStaging.mBufferID) {
+				mStaging.reset();
+			}
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			_cacheEach([this](const auto id, BackedResource<ResourceType>& resource) {
+				// Shared contents are destroyed once below, not once per alias
+				if (mContentHashes.find(id) == mContentHashes.end()) {
+					static_cast<DerivedManager*>(this)->_destroyImpl(resource);
+				}
 			});
-			mCache.clear();
+			for (auto&& [hash, content] : mSharedContent) {
+				if (content.mResource) {
+					static_cast<DerivedManager*>(this)->_destroyImpl(*content.mResource);
+				}
+			}
+			mSharedContent.clear();
+			mContentHashes.clear();
+			mReadyContent.clear();
+			mRequeued.clear();
+			_cacheClear();
+
+			std::lock_guard<std::mutex> markLock(mMarkMutex);
+			mMarking = false;
+			mMarked.clear();
+			mRetained.clear();
+		}
+
+		void _beginMark() {
+			std::lock_guard<std::mutex> lock(mMarkMutex);
+			mMarked.clear();
+			mMarking = true;
+		}
+
+		// Discards everything that's loaded but wasn't marked since _beginMark. Returns how many were discarded
+		uint32_t _sweep() {
+			std::vector<ResourceHandle<ResourceType>> unmarked;
+			{
+				std::lock_guard<std::mutex> lock(mMarkMutex);
+				mMarking = false;
+				_cacheEach([&](const auto id, const BackedResource<ResourceType>&) {
+					if (mMarked.find(id) == mMarked.end() && mRetained.find(id) == mRetained.end()) {
+						unmarked.emplace_back(id);
+					}
+				});
+				mMarked.clear();
+			}
+			for (auto& id : unmarked) {
+				discard(id);
+			}
+			return static_cast<uint32_t>(unmarked.size());
+		}
+
+		// Second hash for _shareContent, seeded differently so a collision on one is vanishingly unlikely to collide on both
+		static constexpr uint64_t sContentCheckSeed = 0x2545f4914f6cdd1dull;
+
+		// Returns true if something with the same contents was already loaded or queued. The handle then aliases
+		// that resource instead of loading its own copy -- it gets hooked up on the next tick
+		// Matching hashes also have to agree on size and a second hash. If they don't, contentHash is zeroed and the caller loads an unshared copy
+		bool _shareContent(const ResourceHandle<ResourceType>& handle, uint64_t& contentHash, uint64_t byteSize, uint64_t checkHash) const {
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			auto existing = mSharedContent.find(contentHash);
+			if (existing != mSharedContent.end() && (existing->second.mByteSize != byteSize || existing->second.mCheckHash != checkHash)) {
+				NEO_LOG_W("Content hash collision on %u -- loading its own copy", handle.mHandle);
+				contentHash = 0;
+			}
+
+			// Loaded again while its discard is still queued. The discard only lets go of what it had before
+			auto mapped = mContentHashes.find(handle.mHandle);
+			if (mapped != mContentHashes.end()) {
+				mRequeued[handle.mHandle] = mapped->second;
+				if (mapped->second == contentHash) {
+					return true;
+				}
+				mContentHashes.erase(mapped);
+			}
+			if (!contentHash) {
+				return false;
+			}
+
+			auto& content = mSharedContent[contentHash];
+			mContentHashes[handle.mHandle] = contentHash;
+			if (content.mRefs++ == 0) {
+				content.mByteSize = byteSize;
+				content.mCheckHash = checkHash;
+				return false;
+			}
+			content.mWaiting.push_back(handle);
+			if (content.mResource) {
+				mReadyContent.push_back(contentHash);
+			}
+			return true;
+		}
+
+		// Drops a handle's reference to shared contents. Returns false if there's still an in-flight load for the caller to cancel
+		bool _releaseContent(const ResourceHandle<ResourceType>& handle) {
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			auto hash = mContentHashes.find(handle.mHandle);
+			auto requeued = mRequeued.find(handle.mHandle);
+			if (requeued != mRequeued.end()) {
+				// Loaded again after this discard was queued -- keep the new request and only drop the old contents
+				const uint64_t previous = requeued->second;
+				mRequeued.erase(requeued);
+				if (hash != mContentHashes.end() && hash->second == previous) {
+					return true;
+				}
+				_cacheDiscard(handle.mHandle);
+				// Anything the old contents still had in flight gets destroyed when it lands
+				_unrefContent(mSharedContent.find(previous), handle);
+				if (hash != mContentHashes.end()) {
+					auto& content = mSharedContent.at(hash->second);
+					if (content.mResource) {
+						_storeWaiting(content);
+					}
+				}
+				return true;
+			}
+			if (hash == mContentHashes.end()) {
+				return false;
+			}
+			auto content = mSharedContent.find(hash->second);
+			mContentHashes.erase(hash);
+			_cacheDiscard(handle.mHandle);
+			return _unrefContent(content, handle);
+		}
+
+		bool _isSharedContent(const ResourceHandle<ResourceType>& handle) const {
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			return mContentHashes.find(handle.mHandle) != mContentHashes.end();
+		}
+
+		// Puts a freshly built resource in the cache, along with every alias that's waiting on its contents
+		void _storeResource(const ResourceHandle<ResourceType>& handle, std::shared_ptr<BackedResource<ResourceType>> resource, uint64_t contentHash) {
+			if (!resource) {
+				return;
+			}
+			if (!contentHash) {
+				_cacheStore(handle.mHandle, resource);
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			auto content = mSharedContent.find(contentHash);
+			if (content == mSharedContent.end()) {
+				// Everything that wanted it got discarded while it was loading
+				static_cast<DerivedManager*>(this)->_destroyImpl(*resource);
+				return;
+			}
+			content->second.mResource = resource;
+			auto hash = mContentHashes.find(handle.mHandle);
+			if (hash != mContentHashes.end() && hash->second == contentHash) {
+				_cacheStore(handle.mHandle, resource);
+			}
+			_storeWaiting(content->second);
+		}
+
+		// Hooks up aliases of contents that had already finished loading
+		void _tickContent() {
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			for (uint64_t contentHash : mReadyContent) {
+				auto content = mSharedContent.find(contentHash);
+				if (content != mSharedContent.end()) {
+					_storeWaiting(content->second);
+				}
+			}
+			mReadyContent.clear();
+		}
+
+		// Resources that were built out of the staging buffer only become valid once the GPU has finished copying
+		void _addPending(ResourceHandle<ResourceType> handle, std::shared_ptr<BackedResource<ResourceType>> resource, std::vector<const void*> stagedData, uint64_t contentHash = 0) {
+			std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+			mPendingQueue.emplace_back(PendingResource{ handle, resource, stagedData, UploadBuffer::insertFence(), false, contentHash, getCurrentTimestamp() });
+		}
+
+		void _tickPending() {
+			std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+			for (auto it = mPendingQueue.begin(); it != mPendingQueue.end();) {
+				if (UploadBuffer::pollFence(it->mFence)) {
+					it = _completePending(it);
+				}
+				else {
+					it++;
+				}
+			}
+		}
+
+		// Something resolved an upload that's still in flight -- stall on it instead of failing
+		// Stalling is a GL call, so without wait this only hooks up aliases of contents that already landed
+		bool _finishPending(const ResourceHandle<ResourceType>& id, bool wait) {
+			uint64_t contentHash = 0;
+			{
+				std::lock_guard<std::mutex> lock(mContentMutex);
+				auto hash = mContentHashes.find(id.mHandle);
+				if (hash != mContentHashes.end()) {
+					contentHash = hash->second;
+					// Aliasing something that's already loaded
+					auto& content = mSharedContent.at(contentHash);
+					if (content.mResource) {
+						_storeWaiting(content);
+						return _cacheContains(id.mHandle);
+					}
+				}
+			}
+			std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+			for (auto it = mPendingQueue.begin(); it != mPendingQueue.end(); it++) {
+				if ((id == it->mHandle || (contentHash && contentHash == it->mContentHash)) && !it->mDiscarded) {
+					if (!wait) {
+						return false;
+					}
+					UploadBuffer::waitFence(it->mFence);
+					_completePending(it);
+					return _cacheContains(id.mHandle);
+				}
+			}
+			return false;
+		}
+
+		// Returns false if the resource wasn't waiting on an upload
+		bool _discardPending(const ResourceHandle<ResourceType>& id) {
+			std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+			for (auto& pending : mPendingQueue) {
+				if (id == pending.mHandle && !pending.mDiscarded) {
+					// The copy might still be in flight -- destroy it once the fence is done
+					pending.mDiscarded = true;
+					return true;
+				}
+			}
+			return false;
 		}
 
 		void tick() {
 			static_cast<DerivedManager*>(this)->_tickImpl();
+			mStats.endTick();
+			_updateStats();
+		}
+
+		void _recordLoad(const ResourceLoadDetails_Internal& details, uint64_t loadStart, uint64_t byteSize) {
+			bool staged = false;
+			{
+				std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+				for (const auto& pending : mPendingQueue) {
+					staged |= pending.mHandle == details.mHandle && !pending.mDiscarded;
+				}
+			}
+			mStats.recordLoad(details.mHandle.mHandle, details.mDebugName, details.mQueuedTime, loadStart, getCurrentTimestamp(), byteSize, staged);
+		}
+
+		void _updateStats() {
+			uint32_t loadQueueDepth, pendingCount, transactionQueueDepth, discardQueueDepth;
+			{
+				std::lock_guard<std::mutex> lock(mLoadQueueMutex);
+				loadQueueDepth = static_cast<uint32_t>(mLoadQueue.size());
+			}
+			{
+				std::lock_guard<std::mutex> lock(mPendingQueueMutex);
+				pendingCount = static_cast<uint32_t>(mPendingQueue.size());
+			}
+			{
+				std::lock_guard<std::mutex> lock(mTransactionQueueMutex);
+				transactionQueueDepth = static_cast<uint32_t>(mTransactionQueue.size());
+			}
+			{
+				std::lock_guard<std::mutex> lock(mDiscardQueueMutex);
+				discardQueueDepth = static_cast<uint32_t>(mDiscardQueue.size());
+			}
+			mStats.setDepths(loadQueueDepth, pendingCount, transactionQueueDepth, discardQueueDepth);
+
+			// Walking the cache is only worth it when something came or went. Streamed textures report their own changes
+			const uint64_t loadCount = mStats.loadCount();
+			const size_t cacheSize = _cacheSize();
+			if (!mStatsDirty && loadCount == mStatsLoadCount && cacheSize == mStatsCacheSize) {
+				return;
+			}
+			mStatsDirty = false;
+			mStatsLoadCount = loadCount;
+			mStatsCacheSize = cacheSize;
+
+			uint64_t gpuBytes = 0;
+			std::lock_guard<std::mutex> lock(mContentMutex);
+			_cacheEach([&](const auto id, const BackedResource<ResourceType>& resource) {
+				if (mContentHashes.find(id) == mContentHashes.end()) {
+					gpuBytes += DerivedManager::_gpuBytes(resource.mResource);
+				}
+			});
+			for (auto&& [hash, content] : mSharedContent) {
+				if (content.mResource) {
+					gpuBytes += DerivedManager::_gpuBytes(content.mResource->mResource);
+				}
+			}
+			mStats.setResidency(static_cast<uint32_t>(cacheSize), gpuBytes);
 		}
 		mutable std::mutex mLoadQueueMutex;
 		mutable std::vector<ResourceLoadDetails_Internal> mLoadQueue;
@@ -188,15 +553,167 @@ namespace neo {
 		mutable std::mutex mTransactionQueueMutex;
 		mutable std::vector<std::pair<ResourceHandle<ResourceType>, std::function<void(ResourceType&)>>> mTransactionQueue;
 
+		struct PendingResource {
+			ResourceHandle<ResourceType> mHandle;
+			std::shared_ptr<BackedResource<ResourceType>> mResource;
+			std::vector<const void*> mStagedData;
+			void* mFence = nullptr; // GLsync
+			bool mDiscarded = false;
+			uint64_t mContentHash = 0;
+			uint64_t mIssuedTime = 0;
+		};
+		mutable std::mutex mPendingQueueMutex;
+		std::vector<PendingResource> mPendingQueue;
+
+		// Expects mPendingQueueMutex to be held
+		typename std::vector<PendingResource>::iterator _completePending(typename std::vector<PendingResource>::iterator it) {
+			if (it->mDiscarded) {
+				static_cast<DerivedManager*>(this)->_destroyImpl(*it->mResource);
+			}
+			else {
+				mStats.recordUpload(it->mHandle.mHandle, it->mIssuedTime, getCurrentTimestamp());
+				_storeResource(it->mHandle, it->mResource, it->mContentHash);
+			}
+			for (const void* data : it->mStagedData) {
+				mStaging.release(data);
+			}
+			return mPendingQueue.erase(it);
+		}
+
+		// Only initialized by managers that upload through it
+		mutable UploadBuffer mStaging;
+
+		struct SharedContent {
+			std::shared_ptr<BackedResource<ResourceType>> mResource; // Null until the first load finishes
+			uint32_t mRefs = 0; // Every handle with these contents holds one
+			uint64_t mByteSize = 0; // Checked along with mCheckHash before anything aliases these contents
+			uint64_t mCheckHash = 0;
+			std::vector<ResourceHandle<ResourceType>> mWaiting;
+		};
+		// Lock after mPendingQueueMutex if both are needed
+		mutable std::mutex mContentMutex;
+		mutable std::unordered_map<uint64_t, SharedContent> mSharedContent;
+		mutable std::unordered_map<entt::id_type, uint64_t> mContentHashes;
+		mutable std::vector<uint64_t> mReadyContent;
+		mutable std::unordered_map<entt::id_type, uint64_t> mRequeued; // Loaded again with a discard queued, and the contents that discard should drop
+
+		// Expects mContentMutex to be held. Returns false if the contents were still loading when the last reference went
+		bool _unrefContent(typename std::unordered_map<uint64_t, SharedContent>::iterator content, const ResourceHandle<ResourceType>& handle) {
+			auto& waiting = content->second.mWaiting;
+			waiting.erase(std::remove(waiting.begin(), waiting.end(), handle), waiting.end());
+			if (--content->second.mRefs > 0) {
+				return true;
+			}
+
+			const bool loaded = content->second.mResource != nullptr;
+			if (loaded) {
+				static_cast<DerivedManager*>(this)->_destroyImpl(*content->second.mResource);
+			}
+			mSharedContent.erase(content);
+			return loaded;
+		}
+
+		// Expects mContentMutex to be held
+		void _storeWaiting(SharedContent& content) {
+			for (auto& waiting : content.mWaiting) {
+				_cacheStore(waiting.mHandle, content.mResource);
+			}
+			content.mWaiting.clear();
+		}
+
+		// Everything goes through the _cache* functions below. The render thread finishes uploads and creates transients
+		// while a pipelined simulation resolves resources, so the cache has its own lock.
+		// It's always the innermost lock and is never held while calling out, so it can be taken under any of the others
+		// Entries are only ever discarded by a tick or a clear, and those never overlap a pipelined simulation --
+		// that's what keeps resolved references good for the rest of the frame, not the lock
+		using CachedHandle = entt::resource_handle<BackedResource<ResourceType>>;
+		mutable std::shared_mutex mCacheMutex;
 		entt::resource_cache<BackedResource<ResourceType>> mCache;
 		std::shared_ptr<BackedResource<ResourceType>> mFallback;
 
+		bool _cacheContains(entt::id_type id) const {
+			std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+			return mCache.contains(id);
+		}
+
+		// Handles keep the resource alive, so they're safe to use after the lock is dropped
+		// References out of them only last as long as the entry does
+		CachedHandle _cacheHandle(entt::id_type id) const {
+			std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+			return mCache.handle(id);
+		}
+
+		size_t _cacheSize() const {
+			std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+			return mCache.size();
+		}
+
+		// Resources are built before they get here so the exclusive lock only covers the insert
+		void _cacheStore(entt::id_type id, std::shared_ptr<BackedResource<ResourceType>> resource) {
+			std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+			mCache.template load<ResourceReadyLoader<ResourceType>>(id, std::move(resource));
+		}
+
+		void _cacheDiscard(entt::id_type id) {
+			std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+			if (mCache.contains(id)) {
+				mCache.discard(id);
+			}
+		}
+
+		void _cacheClear() {
+			std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+			mCache.clear();
+		}
+
+		// Walks a copy of the cache so func is free to resolve or load
+		template<typename Func>
+		void _cacheEach(Func func) const {
+			std::vector<std::pair<entt::id_type, CachedHandle>> handles;
+			{
+				std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+				handles.reserve(mCache.size());
+				mCache.each([&](const entt::id_type id, CachedHandle handle) {
+					handles.emplace_back(id, handle);
+				});
+			}
+			for (auto& [id, handle] : handles) {
+				func(id, handle.get());
+			}
+		}
+
+		// Managers are built on the thread that owns the GL context
+		const std::thread::id mRenderThread = std::this_thread::get_id();
+		bool _isRenderThread() const {
+			return std::this_thread::get_id() == mRenderThread;
+		}
+
+		mutable std::mutex mMarkMutex;
+		mutable std::atomic<bool> mMarking{ false };
+		mutable std::unordered_set<entt::id_type> mMarked;
+		mutable std::unordered_set<entt::id_type> mRetained;
+
+		mutable ResourceStatsRecorder mStats;
+		bool mStatsDirty = false; // For residency changes that don't add or remove resources
+		uint64_t mStatsLoadCount = 0;
+		size_t mStatsCacheSize = 0;
+
 	private:
+		// The reference is owned by the cache entry, so it's good until the next tick -- don't hold on to it past the frame
 		BackedResource<ResourceType>& _resolveFinal(const ResourceHandle<ResourceType>& id) const {
-			auto handle = mCache.handle(id.mHandle);
+			mark(id);
+			auto handle = _cacheHandle(id.mHandle);
 			if (handle) {
 				return const_cast<BackedResource<ResourceType>&>(handle.get());
 			}
+			const bool renderThread = _isRenderThread();
+			if (const_cast<ResourceManagerInterface*>(this)->_finishPending(id, renderThread)) {
+				return const_cast<BackedResource<ResourceType>&>(_cacheHandle(id.mHandle).get());
+			}
+			// A pipelined simulation can't stall on the upload -- it gets the fallback until the render thread finishes it
+			if (!renderThread && isQueued(id)) {
+				return *mFallback;
+			}
 			NEO_FAIL("Invalid resource requested! Did you check for validity?");
 			return *mFallback;
 		}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace neo {
+
+	// Microseconds
+	struct LoadStageTiming {
+		uint64_t mTotal = 0;
+		uint64_t mMax = 0;
+
+		double average(uint64_t count) const {
+			return count ? mTotal / static_cast<double>(count) : 0.0;
+		}
+	};
+
+	// One handle's trip through the load pipeline. Microsecond timestamps, 0 if it hasn't gotten there yet
+	struct LoadTimeline {
+		uint32_t mHandle = 0;
+		std::string mName;
+		uint64_t mQueued = 0; // asyncLoad
+		uint64_t mDecoded = 0; // Loaded and the GL object created
+		uint64_t mUploaded = 0; // Usable. Same as decoded unless it went through staging
+		uint64_t mBytes = 0;
+	};
+
+	// Snapshot of a resource manager's load pipeline
+	struct ResourceManagerStats {
+		uint32_t mResourceCount = 0;
+		uint32_t mLoadQueueDepth = 0;
+		uint32_t mPendingUploadCount = 0; // Waiting on a GPU copy out of staging
+		uint32_t mTransactionQueueDepth = 0;
+		uint32_t mDiscardQueueDepth = 0;
+
+		uint64_t mGPUBytes = 0; // Estimated. Shared contents only count once
+		uint64_t mUploadedBytesLastTick = 0;
+		uint64_t mUploadedBytesTotal = 0;
+
+		uint64_t mLoadCount = 0;
+		uint64_t mUploadCount = 0;
+		LoadStageTiming mQueued; // asyncLoad until a tick picks it up
+		LoadStageTiming mLoad; // Decoding and creating the GL object on the render thread
+		LoadStageTiming mUpload; // Staged uploads only -- waiting on the GPU copy's fence
+	};
+
+	// Written from the render thread, readable from anywhere without locking.
+	// Fields are individually atomic, so a snapshot taken mid-tick can mix values from two ticks
+	class ResourceStatsRecorder {
+	public:
+		ResourceManagerStats snapshot() const {
+			ResourceManagerStats stats;
+			stats.mResourceCount = mResourceCount.load(std::memory_order_relaxed);
+			stats.mLoadQueueDepth = mLoadQueueDepth.load(std::memory_order_relaxed);
+			stats.mPendingUploadCount = mPendingUploadCount.load(std::memory_order_relaxed);
+			stats.mTransactionQueueDepth = mTransactionQueueDepth.load(std::memory_order_relaxed);
+			stats.mDiscardQueueDepth = mDiscardQueueDepth.load(std::memory_order_relaxed);
+			stats.mGPUBytes = mGPUBytes.load(std::memory_order_relaxed);
+			stats.mUploadedBytesLastTick = mUploadedBytesLastTick.load(std::memory_order_relaxed);
+			stats.mUploadedBytesTotal = mUploadedBytesTotal.load(std::memory_order_relaxed);
+			stats.mLoadCount = mLoadCount.load(std::memory_order_relaxed);
+			stats.mUploadCount = mUploadCount.load(std::memory_order_relaxed);
+			stats.mQueued = mQueued.snapshot();
+			stats.mLoad = mLoad.snapshot();
+			stats.mUpload = mUpload.snapshot();
+			return stats;
+		}
+
+		uint64_t loadCount() const {
+			return mLoadCount.load(std::memory_order_relaxed);
+		}
+
+		void endTick() {
+			mUploadedBytesLastTick.store(mUploadedBytesThisTick, std::memory_order_relaxed);
+			mUploadedBytesThisTick = 0;
+		}
+
+		// Staged loads aren't usable until their upload is recorded
+		void recordLoad(uint32_t handle, const std::optional<std::string>& name, uint64_t queued, uint64_t loadStart, uint64_t loadEnd, uint64_t byteSize, bool staged) {
+			mQueued.record(loadStart - queued);
+			mLoad.record(loadEnd - loadStart);
+			mLoadCount.fetch_add(1, std::memory_order_relaxed);
+			mUploadedBytesThisTick += byteSize;
+			mUploadedBytesTotal.fetch_add(byteSize, std::memory_order_relaxed);
+
+			// Oldest entry gets overwritten
+			const uint64_t index = mTimelineCount.load(std::memory_order_relaxed);
+			TimelineSlot& slot = mTimelines[index % sTimelineCount];
+			const uint32_t sequence = slot.mSequence.load(std::memory_order_relaxed);
+			slot.mSequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			slot.mHandle = handle;
+			const size_t nameLength = name ? std::min(name->size(), sizeof(slot.mName) - 1) : 0;
+			if (nameLength) {
+				memcpy(slot.mName, name->data(), nameLength);
+			}
+			slot.mName[nameLength] = '\0';
+			slot.mQueued = queued;
+			slot.mDecoded = loadEnd;
+			slot.mUploaded.store(staged ? 0 : loadEnd, std::memory_order_relaxed);
+			slot.mBytes = byteSize;
+			slot.mSequence.store(sequence + 2, std::memory_order_release);
+			mTimelineCount.store(index + 1, std::memory_order_release);
+		}
+
+		void recordUpload(uint32_t handle, uint64_t issued, uint64_t uploaded) {
+			mUpload.record(uploaded - issued);
+			mUploadCount.fetch_add(1, std::memory_order_relaxed);
+
+			// Newest first. Only the render thread writes slots, so nothing can be replacing this one underneath us
+			const uint64_t count = mTimelineCount.load(std::memory_order_relaxed);
+			for (uint64_t i = count; i > count - std::min<uint64_t>(count, sTimelineCount); i--) {
+				TimelineSlot& slot = mTimelines[(i - 1) % sTimelineCount];
+				if (slot.mHandle == handle && !slot.mUploaded.load(std::memory_order_relaxed)) {
+					slot.mUploaded.store(uploaded, std::memory_order_relaxed);
+					break;
+				}
+			}
+		}
+
+		// Most recent loads, oldest first. Anything being overwritten while it's read is skipped
+		std::vector<LoadTimeline> timelines() const {
+			const uint64_t count = mTimelineCount.load(std::memory_order_acquire);
+			std::vector<LoadTimeline> out;
+			out.reserve(static_cast<size_t>(std::min<uint64_t>(count, sTimelineCount)));
+			for (uint64_t i = count - std::min<uint64_t>(count, sTimelineCount); i < count; i++) {
+				const TimelineSlot& slot = mTimelines[i % sTimelineCount];
+				const uint32_t sequence = slot.mSequence.load(std::memory_order_acquire);
+				if (sequence & 1) {
+					continue;
+				}
+				LoadTimeline timeline{ slot.mHandle, slot.mName, slot.mQueued, slot.mDecoded, slot.mUploaded.load(std::memory_order_relaxed), slot.mBytes };
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.mSequence.load(std::memory_order_relaxed) == sequence) {
+					out.push_back(std::move(timeline));
+				}
+			}
+			return out;
+		}
+
+		void setDepths(uint32_t loadQueue, uint32_t pending, uint32_t transactions, uint32_t discards) {
+			mLoadQueueDepth.store(loadQueue, std::memory_order_relaxed);
+			mPendingUploadCount.store(pending, std::memory_order_relaxed);
+			mTransactionQueueDepth.store(transactions, std::memory_order_relaxed);
+			mDiscardQueueDepth.store(discards, std::memory_order_relaxed);
+		}
+
+		void setResidency(uint32_t resourceCount, uint64_t gpuBytes) {
+			mResourceCount.store(resourceCount, std::memory_order_relaxed);
+			mGPUBytes.store(gpuBytes, std::memory_order_relaxed);
+		}
+
+	private:
+		struct AtomicTiming {
+			std::atomic<uint64_t> mTotal{ 0 };
+			std::atomic<uint64_t> mMax{ 0 };
+
+			// Only the render thread records, so max doesn't need a CAS loop
+			void record(uint64_t time) {
+				mTotal.fetch_add(time, std::memory_order_relaxed);
+				mMax.store(std::max(mMax.load(std::memory_order_relaxed), time), std::memory_order_relaxed);
+			}
+
+			LoadStageTiming snapshot() const {
+				return { mTotal.load(std::memory_order_relaxed), mMax.load(std::memory_order_relaxed) };
+			}
+		};
+
+		std::atomic<uint32_t> mResourceCount{ 0 };
+		std::atomic<uint32_t> mLoadQueueDepth{ 0 };
+		std::atomic<uint32_t> mPendingUploadCount{ 0 };
+		std::atomic<uint32_t> mTransactionQueueDepth{ 0 };
+		std::atomic<uint32_t> mDiscardQueueDepth{ 0 };
+		std::atomic<uint64_t> mGPUBytes{ 0 };
+		std::atomic<uint64_t> mUploadedBytesLastTick{ 0 };
+		std::atomic<uint64_t> mUploadedBytesTotal{ 0 };
+		std::atomic<uint64_t> mLoadCount{ 0 };
+		std::atomic<uint64_t> mUploadCount{ 0 };
+		AtomicTiming mQueued;
+		AtomicTiming mLoad;
+		AtomicTiming mUpload;
+
+		uint64_t mUploadedBytesThisTick = 0; // Render thread only
+
+		// Fixed ring so recording never locks or allocates. The sequence is odd while a slot's being rewritten
+		struct TimelineSlot {
+			std::atomic<uint32_t> mSequence{ 0 };
+			uint32_t mHandle = 0;
+			char mName[64] = {};
+			uint64_t mQueued = 0;
+			uint64_t mDecoded = 0;
+			std::atomic<uint64_t> mUploaded{ 0 }; // Filled in later without rewriting the slot
+			uint64_t mBytes = 0;
+		};
+		static constexpr size_t sTimelineCount = 256;
+		std::array<TimelineSlot, sTimelineCount> mTimelines;
+		std::atomic<uint64_t> mTimelineCount{ 0 }; // Total ever recorded -- the newest is at (count - 1) % sTimelineCount
+	};
+}
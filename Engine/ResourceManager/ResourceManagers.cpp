@@ -1,15 +1,94 @@
 #include "ResourceManager/ResourceManagers.hpp"
 
+#include "Util/MemoryTracker.hpp"
+
 #include <ext/imgui_incl.hpp>
 
 namespace neo {
+	namespace {
+		void _statsRow(const char* name, const ResourceManagerStats& stats) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::Text("%s", name);
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%d", stats.mResourceCount);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%d / %d / %d", stats.mLoadQueueDepth, stats.mPendingUploadCount, stats.mTransactionQueueDepth);
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.2f", stats.mGPUBytes / 1048576.f);
+			ImGui::TableSetColumnIndex(4);
+			ImGui::Text("%.1f", stats.mUploadedBytesLastTick / 1024.f);
+			ImGui::TableSetColumnIndex(5);
+			ImGui::Text("%.2f / %.2f", stats.mQueued.average(stats.mLoadCount) / 1000.0, stats.mQueued.mMax / 1000.0);
+			ImGui::TableSetColumnIndex(6);
+			ImGui::Text("%.2f / %.2f", stats.mLoad.average(stats.mLoadCount) / 1000.0, stats.mLoad.mMax / 1000.0);
+			ImGui::TableSetColumnIndex(7);
+			ImGui::Text("%.2f / %.2f", stats.mUpload.average(stats.mUploadCount) / 1000.0, stats.mUpload.mMax / 1000.0);
+		}
+
+		void _timelineRows(const char* type, const std::vector<LoadTimeline>& timelines) {
+			// Newest first
+			for (auto it = timelines.rbegin(); it != timelines.rend(); it++) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", type);
+				ImGui::TableSetColumnIndex(1);
+				if (it->mName.empty()) {
+					ImGui::Text("%u", it->mHandle);
+				}
+				else {
+					ImGui::Text("%s", it->mName.c_str());
+				}
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%.2f", (it->mDecoded - it->mQueued) / 1000.0);
+				ImGui::TableSetColumnIndex(3);
+				if (it->mUploaded) {
+					ImGui::Text("%.2f", (it->mUploaded - it->mDecoded) / 1000.0);
+					ImGui::TableSetColumnIndex(4);
+					ImGui::Text("%.2f", (it->mUploaded - it->mQueued) / 1000.0);
+				}
+				else {
+					ImGui::Text("...");
+				}
+				ImGui::TableSetColumnIndex(5);
+				ImGui::Text("%.1f", it->mBytes / 1024.f);
+			}
+		}
+	}
 
 	void ResourceManagers::_tick() {
 		TRACY_GPU();
+		NEO_MEMORY_TAG(ResourceManagers);
 		mMeshManager.tick();
 		mShaderManager.tick();
 		mTextureManager.tick();
 		mFramebufferManager.tick(mTextureManager); // Do this after textures
+
+#ifdef TRACY_ENABLE
+		// The plots are all that reads these every tick -- don't bother snapshotting when they compile away
+		const ResourceManagerStats meshStats = mMeshManager.getStats();
+		const ResourceManagerStats textureStats = mTextureManager.getStats();
+		TracyPlot("Mesh queue depth", static_cast<int64_t>(meshStats.mLoadQueueDepth + meshStats.mPendingUploadCount));
+		TracyPlot("Mesh uploaded bytes", static_cast<int64_t>(meshStats.mUploadedBytesLastTick));
+		TracyPlot("Mesh MB", meshStats.mGPUBytes / 1048576.f);
+		TracyPlot("Texture queue depth", static_cast<int64_t>(textureStats.mLoadQueueDepth + textureStats.mPendingUploadCount));
+		TracyPlot("Texture uploaded bytes", static_cast<int64_t>(textureStats.mUploadedBytesLastTick));
+		TracyPlot("Texture MB", textureStats.mGPUBytes / 1048576.f);
+#endif
+	}
+
+	void ResourceManagers::_beginSwap() {
+		// Framebuffers are sized and pooled for the old demo's passes -- rebuild those regardless
+		mFramebufferManager.clear(mTextureManager);
+		mMeshManager._beginMark();
+		mTextureManager._beginMark();
+	}
+
+	void ResourceManagers::_sweep() {
+		TRACY_ZONE();
+		const uint32_t meshes = mMeshManager._sweep();
+		const uint32_t textures = mTextureManager._sweep();
+		NEO_LOG_I("Demo swap discarded %d unused meshes and %d unused textures", meshes, textures);
 	}
 
 	void ResourceManagers::_clear() {
@@ -21,35 +100,68 @@ namespace neo {
 
 	void ResourceManagers::_imguiEditor() {
 		TRACY_ZONE();
+		// Peeks rather than resolves -- just looking at a texture in the editor shouldn't keep it alive across a demo swap
 		auto textureFunc = [&](const TextureHandle& textureHandle) {
-			if (!mTextureManager.isValid(textureHandle)) {
+			const Texture* texture = mTextureManager.peek(textureHandle);
+			if (!texture) {
 				ImGui::Text("Invalid texture");
 			}
+			else if (texture->mFormat.mTarget != types::texture::Target::Texture2D) {
+				ImGui::Text("Non-2D texture");
+			}
 			else {
-				Texture& texture = mTextureManager.resolve(textureHandle);
-				if (texture.mFormat.mTarget != types::texture::Target::Texture2D) {
-					ImGui::Text("Non-2D texture");
-				}
-				else {
-					float scale = 175.f / (texture.mWidth > texture.mHeight ? texture.mWidth : texture.mHeight);
-					ImGui::Image(textureHandle.mHandle, ImVec2(scale * texture.mWidth, scale * texture.mHeight), ImVec2(0, 1), ImVec2(1, 0));
-				}
+				float scale = 175.f / (texture->mWidth > texture->mHeight ? texture->mWidth : texture->mHeight);
+				ImGui::Image(textureHandle.mHandle, ImVec2(scale * texture->mWidth, scale * texture->mHeight), ImVec2(0, 1), ImVec2(1, 0));
 			}
 		};
 		ImGui::Begin("Resources");
+		if (ImGui::BeginTable("##Stats", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+			ImGui::TableSetupColumn("");
+			ImGui::TableSetupColumn("Count");
+			ImGui::TableSetupColumn("Queued/Pending/Tx");
+			ImGui::TableSetupColumn("MB");
+			ImGui::TableSetupColumn("Uploaded KB");
+			ImGui::TableSetupColumn("Queue ms (avg/max)");
+			ImGui::TableSetupColumn("Load ms (avg/max)");
+			ImGui::TableSetupColumn("Upload ms (avg/max)");
+			ImGui::TableHeadersRow();
+			_statsRow("Meshes", mMeshManager.getStats());
+			_statsRow("Textures", mTextureManager.getStats());
+			_statsRow("Shaders", mShaderManager.getStats());
+			_statsRow("Framebuffers", mFramebufferManager.getStats());
+			ImGui::EndTable();
+		}
+		if (ImGui::TreeNodeEx("Recent loads", ImGuiTreeNodeFlags_None)) {
+			if (ImGui::BeginTable("##Timelines", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY, ImVec2(0.f, 300.f))) {
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("");
+				ImGui::TableSetupColumn("Name");
+				ImGui::TableSetupColumn("Queued -> Decoded ms");
+				ImGui::TableSetupColumn("Decoded -> Uploaded ms");
+				ImGui::TableSetupColumn("Total ms");
+				ImGui::TableSetupColumn("KB");
+				ImGui::TableHeadersRow();
+				_timelineRows("Mesh", mMeshManager.getLoadTimelines());
+				_timelineRows("Texture", mTextureManager.getLoadTimelines());
+				_timelineRows("Shader", mShaderManager.getLoadTimelines());
+				_timelineRows("Framebuffer", mFramebufferManager.getLoadTimelines());
+				ImGui::EndTable();
+			}
+			ImGui::TreePop();
+		}
 		if (ImGui::TreeNodeEx(&mFramebufferManager, ImGuiTreeNodeFlags_DefaultOpen, "Framebuffers (%d)", mFramebufferManager.mCache.size())) {
 			mFramebufferManager.imguiEditor(textureFunc, mTextureManager);
 			ImGui::TreePop();
 		}
-		if (ImGui::TreeNodeEx(&mShaderManager, ImGuiTreeNodeFlags_DefaultOpen, "Shaders (%d)", mShaderManager.mCache.size())) {
+		if (ImGui::TreeNodeEx(&mShaderManager, ImGuiTreeNodeFlags_DefaultOpen, "Shaders (%d)", mShaderManager._cacheSize())) {
 			mShaderManager.imguiEditor();
 			ImGui::TreePop();
 		}
-		if (ImGui::TreeNodeEx(&mTextureManager, ImGuiTreeNodeFlags_None, "Texture (%d)", mTextureManager.mCache.size())) {
+		if (ImGui::TreeNodeEx(&mTextureManager, ImGuiTreeNodeFlags_None, "Texture (%d)", mTextureManager._cacheSize())) {
 			mTextureManager.imguiEditor(textureFunc);
 			ImGui::TreePop();
 		}
-		if (ImGui::TreeNodeEx(&mMeshManager, ImGuiTreeNodeFlags_None, "Meshes (%d)", mMeshManager.mCache.size())) {
+		if (ImGui::TreeNodeEx(&mMeshManager, ImGuiTreeNodeFlags_None, "Meshes (%d)", mMeshManager._cacheSize())) {
 			mMeshManager.imguiEditor();
 			ImGui::TreePop();
 		}
@@ -23,5 +23,9 @@ namespace neo {
 		void _imguiEditor();
 		void _clear();
 		void _tick();
+
+		// Warm demo swaps. Shaders are always kept
+		void _beginSwap();
+		void _sweep();
 	};
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "ShaderManager.hpp"
 
 #include "Loader/Loader.hpp"
+#include "Loader/FileWatcher.hpp"
+#include "Loader/ShaderPreprocessor.hpp"
 
 #include "Renderer/GLObjects/ResolvedShaderInstance.hpp"
 
@@ -92,6 +94,31 @@ namespace neo {
 	void ShaderManager::_tickImpl() {
 		TRACY_ZONE();
 
+		{
+			std::unordered_map<entt::id_type, bool> reloads;
+			{
+				std::lock_guard<std::mutex> lock(mHotReloadMutex);
+				std::swap(reloads, mReloadQueue);
+			}
+			for (auto&& [id, sourceChanged] : reloads) {
+				ShaderHandle handle(id);
+				if (!isValid(handle)) {
+					continue;
+				}
+				auto& shader = _cacheHandle(id).get().mResource;
+				if (sourceChanged) {
+					// Reloaded from disk the next time someone asks for it
+					NEO_LOG_I("Hot reloading %s", shader.mName.c_str());
+					discard(handle);
+				}
+				else {
+					// Same source, only an include changed -- just recompile the variants
+					NEO_LOG_I("Recompiling %d variants of %s", static_cast<int>(shader.mResolvedShaders.size()), shader.mName.c_str());
+					shader.destroyVariants();
+				}
+			}
+		}
+
 		{
 			std::vector<ResourceLoadDetails_Internal> swapQueue = {};
 			{
@@ -101,7 +128,13 @@ namespace neo {
 			}
 
 			for (auto& loadDetails : swapQueue) {
-				mCache.load<ShaderLoader>(loadDetails.mHandle.mHandle, loadDetails.mLoadDetails, loadDetails.mDebugName);
+				const uint64_t loadStart = getCurrentTimestamp();
+				auto shader = ShaderLoader{}.load(loadDetails.mLoadDetails, loadDetails.mDebugName);
+				if (shader) {
+					_cacheStore(loadDetails.mHandle.mHandle, shader);
+					_registerDependencies(loadDetails.mHandle.mHandle, shader->mResource);
+				}
+				_recordLoad(loadDetails, loadStart, 0);
 			}
 		}
 
@@ -114,8 +147,8 @@ namespace neo {
 			}
 			for (auto& id : swapQueue) {
 				if (isValid(id)) {
-					_destroyImpl(mCache.handle(id.mHandle).get());
-					mCache.discard(id.mHandle);
+					_destroyImpl(_cacheHandle(id.mHandle).get());
+					_cacheDiscard(id.mHandle);
 				}
 			}
 		}
@@ -133,7 +166,7 @@ namespace neo {
 	}
 
 	void ShaderManager::imguiEditor() {
-		mCache.each([&](entt::id_type, BackedResource<SourceShader>& resource) {
+		_cacheEach([&](entt::id_type, BackedResource<SourceShader>& resource) {
 			auto& shader = resource.mResource;
 			if (ImGui::TreeNode(shader.mName.c_str())) {
 				if (shader.mResolvedShaders.size()) {
@@ -159,38 +192,69 @@ namespace neo {
 		});
 	}
 
+	void ShaderManager::_registerDependencies(entt::id_type id, const SourceShader& shader) {
+		TRACY_ZONE();
+		if (!shader.mConstructionArgs) {
+			return;
+		}
+
+		std::unordered_set<std::string> includes;
+		for (auto&& [stage, source] : shader.mShaderSources) {
+			if (source) {
+				ShaderPreprocessor::collectDependencies(source, includes);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mHotReloadMutex);
+		auto track = [this](const std::string& fileName) -> ShaderDependents& {
+			auto [dependents, inserted] = mDependents.try_emplace(fileName);
+			if (inserted) {
+				mUnwatchedFiles.push_back(fileName);
+			}
+			return dependents->second;
+		};
+		for (auto&& [stage, fileName] : *shader.mConstructionArgs) {
+			track(fileName).mSources.insert(id);
+		}
+		for (const std::string& include : includes) {
+			track(include).mIncluders.insert(id);
+		}
+	}
+
 	void ShaderManager::_hotReloadFunc() {
 		tracy::SetThreadName("Shader Hot Reloader");
-		// Doesn't handle #includes
 		// Might break during swap demo
+		FileWatcher watcher;
 		while (mKillSwitch.load() == false) {
 			{
-				TRACY_ZONEN("Sleep");
-				std::this_thread::sleep_for(std::chrono::milliseconds(HOT_RELOAD_MILLSECONDS));
+				std::lock_guard<std::mutex> lock(mHotReloadMutex);
+				for (const std::string& fileName : mUnwatchedFiles) {
+					watcher.watch(fileName);
+				}
+				mUnwatchedFiles.clear();
 			}
 
-			TRACY_ZONEN("Hot reload");
+			// Sleeps until something's written to, or the timeout so the kill switch still gets checked
+			std::vector<std::string> changed = watcher.poll(std::chrono::milliseconds(HOT_RELOAD_MILLSECONDS));
+			if (changed.empty()) {
+				continue;
+			}
 
-			// Entt Cache doesn't support iterators :/ 
-			std::vector<entt::id_type> list;
-			list.reserve(mCache.size());
-			mCache.each([&list](const entt::id_type enttId) {
-				list.emplace_back(enttId);
-			});
-
-			for (auto id = list.begin(); id < list.end(); id++) {
-				if (auto resource = mCache.handle(*id); resource && resource->mResource.mConstructionArgs) {
-					time_t lastModTime = resource->mResource.mModifiedTime;
-					for (auto&& [stage, fileName] : *resource->mResource.mConstructionArgs) {
-						lastModTime = std::max(lastModTime, Loader::getFileModTime(fileName));
-					}
-					if (lastModTime > resource->mResource.mModifiedTime) {
-						NEO_LOG_I("Hot reloading %s", resource->mResource.mName.c_str());
-						ShaderHandle handle(*id);
+			TRACY_ZONEN("Hot reload");
+			// Cached expansions of anything that includes a changed file are stale now too
+			std::unordered_set<std::string> affected = ShaderPreprocessor::invalidate(changed);
 
-						// This should really have a mutex on it, but how are you gunna be editing >1 file at a time come on now
-						discard(handle);
-					}
+			std::lock_guard<std::mutex> lock(mHotReloadMutex);
+			for (const std::string& fileName : affected) {
+				auto dependents = mDependents.find(fileName);
+				if (dependents == mDependents.end()) {
+					continue;
+				}
+				for (entt::id_type id : dependents->second.mSources) {
+					mReloadQueue[id] = true;
+				}
+				for (entt::id_type id : dependents->second.mIncluders) {
+					mReloadQueue.try_emplace(id, false);
 				}
 			}
 		}
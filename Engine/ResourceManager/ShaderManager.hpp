@@ -6,7 +6,10 @@
 
 #include "Util/Util.hpp"
 
+#include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 namespace neo {
@@ -29,9 +32,21 @@ namespace neo {
 		[[nodiscard]] ShaderHandle _asyncLoadImpl(ShaderHandle id, ShaderLoadDetails shaderDetails, const std::optional<std::string>& debugName) const;
 		void _destroyImpl(BackedResource<SourceShader>& sourceShader);
 		void _tickImpl();
+		static uint64_t _gpuBytes(const SourceShader&) { return 0; }
 	private:
 		std::thread* mHotReloader;
 		std::atomic<bool> mKillSwitch = false;
 		void _hotReloadFunc();
+
+		// Files each shader was built from, so an edit only touches the shaders that actually use it
+		struct ShaderDependents {
+			std::unordered_set<entt::id_type> mSources; // Shaders built straight from this file
+			std::unordered_set<entt::id_type> mIncluders; // Shaders that #include it somewhere
+		};
+		std::mutex mHotReloadMutex;
+		std::unordered_map<std::string, ShaderDependents> mDependents;
+		std::vector<std::string> mUnwatchedFiles;
+		std::unordered_map<entt::id_type, bool> mReloadQueue; // True if the shader's own source changed
+		void _registerDependencies(entt::id_type id, const SourceShader& shader);
 	};
 }
\ No newline at end of file
@@ -7,8 +7,18 @@
 
 #include <ext/imgui_incl.hpp>
 
+#include <algorithm>
+
 namespace neo {
 	namespace {
+		// Streamed textures always keep their mips at or below this size resident
+		constexpr uint16_t sStreamedBaseSize = 64;
+		// How long a texture keeps its finer mips once nothing is asking for them
+		constexpr uint32_t sStreamOutFrames = 60;
+		const uint32_t sStagingSize = 128u << 20;
+		// Transient textures that nobody has acquired for this long get destroyed -- long enough to ride out a resize drag
+		constexpr uint32_t sTransientEvictFrames = 8;
+
 		uint16_t _bytesPerPixel(types::ByteFormats format) {
 			switch (format) {
 			case types::ByteFormats::UnsignedByte:
@@ -48,6 +58,84 @@ namespace neo {
 			}
 		}
 
+		uint32_t _byteSize(const TextureBuilder& builder) {
+			// Base dimension
+			uint32_t byteSize = glm::max<glm::u16>(builder.mDimensions.x, 1u) * glm::max<glm::u16>(builder.mDimensions.y, 1u) * glm::max<glm::u16>(builder.mDimensions.z, 1u);
+			// Components per pixel
+			byteSize *= _channelsPerPixel(TextureFormat::deriveBaseFormat(builder.mFormat.mInternalFormat));
+			// Pixel format
+			byteSize *= _bytesPerPixel(builder.mFormat.mType);
+			return byteSize;
+		}
+
+		// Matches the clamping in Texture's constructor
+		uint16_t _maxMipCount(glm::u16vec3 dimensions) {
+			uint16_t maxDim = std::max(dimensions.x, std::max(dimensions.y, dimensions.z));
+			uint16_t mips = 0;
+			while (maxDim > (1u << mips)) {
+				mips++;
+			}
+			return std::max(mips, static_cast<uint16_t>(1u));
+		}
+
+		// Covers everything that ends up in the GPU texture, so matching hashes can share one
+		uint64_t _contentHash(const TextureBuilder& builder, uint32_t byteSize, uint64_t seed = 0) {
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mTarget));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mInternalFormat));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mType));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mFilter.mMin));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mFilter.mMag));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mFilter.mMip));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mWrap.mS));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mWrap.mT));
+			seed = util::hashCombine(seed, static_cast<uint32_t>(builder.mFormat.mWrap.mR));
+			seed = util::hashCombine(seed, builder.mFormat.mMipCount);
+			seed = util::hashCombine(seed, builder.mDimensions.x);
+			seed = util::hashCombine(seed, builder.mDimensions.y);
+			seed = util::hashCombine(seed, builder.mDimensions.z);
+			seed = util::hashCombine(seed, builder.mStreamed);
+			const uint64_t hash = util::hashBytes(builder.mData, byteSize, seed);
+			return hash ? hash : 1; // 0 means not shared
+		}
+
+		bool _isStreamable(const TextureBuilder& builder) {
+			return builder.mData != nullptr
+				&& builder.mFormat.mTarget == types::texture::Target::Texture2D
+				&& builder.mFormat.mType == types::ByteFormats::UnsignedByte
+				&& std::min(builder.mFormat.mMipCount, _maxMipCount(builder.mDimensions)) > 1;
+		}
+
+		// Byte offset of each mip in a tightly packed chain, with the total size at the end
+		std::vector<size_t> _mipOffsets(const TextureBuilder& builder) {
+			const uint16_t channels = _channelsPerPixel(TextureFormat::deriveBaseFormat(builder.mFormat.mInternalFormat));
+			std::vector<size_t> offsets = { 0 };
+			for (uint16_t mip = 0; mip < builder.mFormat.mMipCount; mip++) {
+				offsets.push_back(offsets.back() + static_cast<size_t>(std::max(1, builder.mDimensions.x >> mip)) * std::max(1, builder.mDimensions.y >> mip) * channels);
+			}
+			return offsets;
+		}
+
+		// 2x2 box filter -- odd edges get clamped
+		void _downsample(const uint8_t* src, int srcWidth, int srcHeight, uint16_t channels, uint8_t* dst) {
+			const int dstWidth = std::max(1, srcWidth / 2);
+			const int dstHeight = std::max(1, srcHeight / 2);
+			for (int y = 0; y < dstHeight; y++) {
+				const int y0 = std::min(y * 2, srcHeight - 1);
+				const int y1 = std::min(y * 2 + 1, srcHeight - 1);
+				for (int x = 0; x < dstWidth; x++) {
+					const int x0 = std::min(x * 2, srcWidth - 1);
+					const int x1 = std::min(x * 2 + 1, srcWidth - 1);
+					for (uint16_t c = 0; c < channels; c++) {
+						uint32_t sum = src[(y0 * srcWidth + x0) * channels + c]
+							+ src[(y0 * srcWidth + x1) * channels + c]
+							+ src[(y1 * srcWidth + x0) * channels + c]
+							+ src[(y1 * srcWidth + x1) * channels + c];
+						dst[(y * dstWidth + x) * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+					}
+				}
+			}
+		}
+
 		struct TextureLoader final : entt::resource_loader<TextureLoader, BackedResource<Texture>> {
 
 			std::shared_ptr<BackedResource<Texture>> load(TextureFiles& fileDetails, const std::optional<std::string>& debugName) const {
@@ -62,17 +150,14 @@ namespace neo {
 				std::vector<std::unique_ptr<STBImageData>> images;
 
 				for (auto& filePath : fileDetails.mFilePaths) {
-					std::string _fileName = Loader::APP_RES_DIR + filePath;
-					if (!util::fileExists(_fileName.c_str())) {
-						_fileName = Loader::ENGINE_RES_DIR + filePath;
-						if (!util::fileExists(_fileName.c_str())) {
-							NEO_LOG_E("Unable to find file %s", filePath.c_str());
-							return nullptr; // This works because STBIImageData does RAII dealloc
-						}
+					FileView file = Loader::openFile(filePath);
+					if (!file) {
+						NEO_LOG_E("Unable to find file %s", filePath.c_str());
+						return nullptr; // This works because STBIImageData does RAII dealloc
 					}
 
 					bool flip = fileDetails.mFormat.mTarget != types::texture::Target::TextureCube; // This might be really dumb
-					images.push_back(std::make_unique<STBImageData>(_fileName.c_str(), TextureFormat::deriveBaseFormat(fileDetails.mFormat.mInternalFormat), fileDetails.mFormat.mType, flip));
+					images.push_back(std::make_unique<STBImageData>(filePath.c_str(), file.data(), file.size(), TextureFormat::deriveBaseFormat(fileDetails.mFormat.mInternalFormat), fileDetails.mFormat.mType, flip));
 				}
 
 				std::vector<uint8_t*> data;
@@ -84,7 +169,7 @@ namespace neo {
 						dimensions.x = glm::min(dimensions.x, static_cast<uint16_t>(image->mWidth));
 						dimensions.y = glm::min(dimensions.y, static_cast<uint16_t>(image->mHeight));
 
-						// TODO - need to memcpy the data over lmao
+						// Images outlive the load below, so they can be uploaded in place
 						data.push_back(image->mData);
 					}
 					else {
@@ -116,13 +201,20 @@ namespace neo {
 				return nullptr;
 			}
 
-			std::shared_ptr<BackedResource<Texture>> load(TextureBuilder textureDetails, const std::optional<std::string>& debugName) const {
+			// Data that lives in staging gets uploaded from it as a pixel buffer
+			std::shared_ptr<BackedResource<Texture>> load(const TextureBuilder& textureDetails, const std::optional<std::string>& debugName, const UploadBuffer* staging = nullptr) const {
 				if (debugName.has_value()) {
 					NEO_LOG_V("Uploading raw texture %s", debugName.value().c_str());
 				}
-				std::shared_ptr<BackedResource<Texture>> textureResource = std::make_shared<BackedResource<Texture>>(textureDetails.mFormat, textureDetails.mDimensions, debugName, textureDetails.mData);
+				const bool staged = staging && textureDetails.mData && staging->contains(textureDetails.mData);
+				// Streamed mips get uploaded by the manager as they're needed
+				const void* data = (textureDetails.mStreamed || staged) ? nullptr : textureDetails.mData;
+				std::shared_ptr<BackedResource<Texture>> textureResource = std::make_shared<BackedResource<Texture>>(textureDetails.mFormat, textureDetails.mDimensions, debugName, data);
 				textureResource->mDebugName = debugName;
-				if (textureDetails.mFormat.mMipCount > 1) {
+				if (staged) {
+					textureResource->mResource.uploadFromBuffer(staging->mBufferID, staging->getOffset(textureDetails.mData));
+				}
+				if (textureDetails.mFormat.mMipCount > 1 && !textureDetails.mStreamed) {
 					textureResource->mResource.genMips();
 				}
 
@@ -141,33 +233,67 @@ namespace neo {
 			glm::u16vec3(2, 2, 0),
 			data
 		}, "Fallback Texture");
+		mStaging.init(sStagingSize);
 	}
 
 	TextureManager::~TextureManager() {
 		mFallback->mResource.destroy();
 		mFallback.reset();
+		mStaging.destroy();
 	}
 
 	[[nodiscard]] TextureHandle TextureManager::_asyncLoadImpl(TextureHandle id, TextureLoadDetails textureDetails, const std::optional<std::string>& debugName) const {
 		NEO_UNUSED(debugName);
 		util::visit(textureDetails,
 			[&](TextureBuilder& builder) {
-				TextureBuilder copy = builder;
-				if (builder.mData != nullptr) {
-					// Base dimension
-					uint32_t byteSize = glm::max<glm::u16>(builder.mDimensions.x, 1u) * glm::max<glm::u16>(builder.mDimensions.y, 1u) * glm::max<glm::u16>(builder.mDimensions.z, 1u);
-					// Components per pixel
-					byteSize *= _channelsPerPixel(TextureFormat::deriveBaseFormat(builder.mFormat.mInternalFormat));
-					// Pixel format
-					byteSize *= _bytesPerPixel(builder.mFormat.mType);
-
-					uint8_t* copiedData = new uint8_t[byteSize];
-					memcpy(copiedData, builder.mData, byteSize);
-					copy.mData = copiedData;
+				// Identical pixels from another import or path just alias the texture that's already there
+				uint64_t contentHash = 0;
+				if (builder.mData != nullptr && builder.mFormat.mTarget != types::texture::Target::TextureCube) {
+					const uint32_t byteSize = _byteSize(builder);
+					contentHash = _contentHash(builder, byteSize);
+					if (_shareContent(id, contentHash, byteSize, _contentHash(builder, byteSize, sContentCheckSeed))) {
+						return;
+					}
+				}
+
+				TextureBuilder copy = std::move(builder);
+				if (copy.mStreamed && !_isStreamable(copy)) {
+					NEO_LOG_W("Texture %s can't be streamed -- loading it normally", debugName.has_value() ? debugName->c_str() : "");
+					copy.mStreamed = false;
+				}
+				if (copy.mStreamed) {
+					// Build the whole chain here so the render thread only ever has to upload
+					copy.mFormat.mMipCount = std::min(copy.mFormat.mMipCount, _maxMipCount(copy.mDimensions));
+					std::vector<size_t> offsets = _mipOffsets(copy);
+					const uint16_t channels = _channelsPerPixel(TextureFormat::deriveBaseFormat(copy.mFormat.mInternalFormat));
+					uint8_t* chain = new uint8_t[offsets.back()];
+					memcpy(chain, copy.mData, offsets[1]);
+					for (uint16_t mip = 1; mip < copy.mFormat.mMipCount; mip++) {
+						_downsample(chain + offsets[mip - 1], std::max(1, copy.mDimensions.x >> (mip - 1)), std::max(1, copy.mDimensions.y >> (mip - 1)), channels, chain + offsets[mip]);
+					}
+					// The chain gets handed to streaming as is
+					copy.mData = chain;
+					copy.mOwner = util::adoptBytes(chain);
+				}
+				else if (copy.mData != nullptr) {
+					const uint32_t byteSize = _byteSize(copy);
+					// Straight into the staging buffer if there's room, then the render thread only has to kick off a PBO upload
+					// Otherwise hold on to the caller's buffer, and only copy what the caller didn't hand over
+					if (uint8_t* staged = copy.mFormat.mTarget != types::texture::Target::TextureCube ? mStaging.allocate(byteSize) : nullptr) {
+						memcpy(staged, copy.mData, byteSize);
+						copy.mData = staged;
+						copy.mOwner.reset();
+					}
+					else if (!copy.mOwner) {
+						uint8_t* copiedData = new uint8_t[byteSize];
+						memcpy(copiedData, copy.mData, byteSize);
+						copy.mData = copiedData;
+						copy.mOwner = util::adoptBytes(copiedData);
+					}
 				}
 				{
 					std::lock_guard<std::mutex> lock(mLoadQueueMutex);
-					mLoadQueue.emplace_back(ResourceLoadDetails_Internal{ id, copy, debugName });
+					mLoadQueue.emplace_back(ResourceLoadDetails_Internal{ id, std::move(copy), debugName, contentHash });
 				}
 			},
 			[&](TextureFiles& loadDetails) {
@@ -189,6 +315,9 @@ namespace neo {
 	void TextureManager::_tickImpl() {
 		TRACY_ZONE();
 
+		_tickPending();
+		_tickContent();
+
 		{
 			std::vector<TextureHandle> swapQueue;
 			{
@@ -199,14 +328,22 @@ namespace neo {
 
 			for (auto& id : swapQueue) {
 				TRACY_ZONEN("Destroy Single");
+				if (_releaseContent(id)) {
+					continue;
+				}
 				if (isValid(id)) {
-					_destroyImpl(mCache.handle(id.mHandle).get());
-					mCache.discard(id.mHandle);
+					_destroyImpl(_cacheHandle(id.mHandle).get());
+					_cacheDiscard(id.mHandle);
 				}
-				else {
+				else if (!_discardPending(id)) {
 					std::lock_guard<std::mutex> lock(mLoadQueueMutex);
 					for (int i = 0; i < mLoadQueue.size(); i++) {
 						if (id == mLoadQueue[i].mHandle) {
+							if (auto* builder = std::get_if<TextureBuilder>(&mLoadQueue[i].mLoadDetails)) {
+								if (mStaging.contains(builder->mData)) {
+									mStaging.release(builder->mData);
+								}
+							}
 							mLoadQueue.erase(mLoadQueue.begin() + i);
 							break;
 						}
@@ -223,33 +360,272 @@ namespace neo {
 				mLoadQueue.clear();
 			}
 
-			for (auto& loadDetails : swapQueue) {
+			uint32_t uploadedBytes = 0;
+			size_t loaded = 0;
+			for (; loaded < swapQueue.size(); loaded++) {
+				auto& loadDetails = swapQueue[loaded];
+				// Files are decoded in here, so their size isn't known up front
+				const TextureBuilder* builder = std::get_if<TextureBuilder>(&loadDetails.mLoadDetails);
+				const uint32_t byteSize = builder ? _byteSize(*builder) : 0;
+				if (uploadedBytes > 0 && uploadedBytes + byteSize > mUploadBudget) {
+					break;
+				}
+				uploadedBytes += byteSize;
+
 				TRACY_ZONEN("Create Single");
+				const uint64_t loadStart = getCurrentTimestamp();
 				std::visit([&](auto&& arg) {
 					using T = std::decay_t<decltype(arg)>;
 					if constexpr (std::is_same_v<T, TextureBuilder>) {
-						mCache.load<TextureLoader>(loadDetails.mHandle.mHandle, arg, loadDetails.mDebugName);
-						delete[] arg.mData;
+						if (arg.mData && mStaging.contains(arg.mData)) {
+							if (auto texture = TextureLoader{}.load(arg, loadDetails.mDebugName, &mStaging)) {
+								_addPending(loadDetails.mHandle, texture, { arg.mData }, loadDetails.mContentHash);
+							}
+							else {
+								mStaging.release(arg.mData);
+							}
+						}
+						else {
+							auto texture = TextureLoader{}.load(arg, loadDetails.mDebugName);
+							if (texture && arg.mStreamed) {
+								_registerStreamed(texture->mResource, arg);
+							}
+							_storeResource(loadDetails.mHandle, texture, loadDetails.mContentHash);
+						}
 					}
 					else if constexpr (std::is_same_v<T, TextureFiles>) {
-						mCache.load<TextureLoader>(loadDetails.mHandle.mHandle, arg, loadDetails.mDebugName);
+						_storeResource(loadDetails.mHandle, TextureLoader{}.load(arg, loadDetails.mDebugName), 0);
 					}
 					else {
 						static_assert(always_false_v<T>, "non-exhaustive visitor!");
 					}
 					}, loadDetails.mLoadDetails);
+				_recordLoad(loadDetails, loadStart, byteSize);
+			}
+
+			// Whatever didn't fit in the budget goes back to the front of the line
+			if (loaded < swapQueue.size()) {
+				std::lock_guard<std::mutex> lock(mLoadQueueMutex);
+				mLoadQueue.insert(mLoadQueue.begin(), std::make_move_iterator(swapQueue.begin() + loaded), std::make_move_iterator(swapQueue.end()));
 			}
 		}
 
+		_tickStreaming();
+		_tickTransient();
+
 		NEO_ASSERT(mTransactionQueue.empty(), "Texture transactions unsupported");
 	}
 
+	void TextureManager::requestMip(const TextureHandle& handle, uint16_t mip) const {
+		std::lock_guard<std::mutex> lock(mMipRequestMutex);
+		auto request = mMipRequests.find(handle.mHandle);
+		if (request == mMipRequests.end()) {
+			mMipRequests.emplace(handle.mHandle, mip);
+		}
+		else {
+			request->second = std::min(request->second, mip);
+		}
+	}
+
+	void TextureManager::_registerStreamed(Texture& texture, const TextureBuilder& builder) {
+		TRACY_ZONE();
+		NEO_ASSERT(texture.mFormat.mMipCount == builder.mFormat.mMipCount, "Streamed mip chain doesn't match the texture");
+
+		StreamedTexture streamed;
+		streamed.mMipOffsets = _mipOffsets(builder);
+		// Keeps the chain that was built on asyncLoad rather than copying it
+		streamed.mOwner = builder.mOwner;
+		streamed.mChain = builder.mData;
+
+		auto existing = mStreamedTextures.find(&texture);
+		if (existing != mStreamedTextures.end()) {
+			mStreamedResidentBytes -= existing->second.mResidentBytes;
+			mStreamedCPUBytes -= existing->second.chainBytes();
+			mStreamedTextures.erase(existing);
+		}
+
+		// Out of room to keep the chain around -- upload all of it and let the chain go with the builder
+		if (mStreamedCPUBytes + streamed.chainBytes() > mStreamingCPUBudget) {
+			NEO_LOG_W("Streaming CPU budget is full -- uploading the whole mip chain instead");
+			texture.setResidentMip(0);
+			for (uint16_t mip = 0; mip < texture.mFormat.mMipCount; mip++) {
+				texture.uploadMip(mip, streamed.mChain + streamed.mMipOffsets[mip]);
+			}
+			return;
+		}
+
+		// Start with only the small mips resident -- the rest come in once something on screen asks for them
+		uint16_t coarsest = 0;
+		while (coarsest + 1 < texture.mFormat.mMipCount && std::max(texture.mWidth, texture.mHeight) >> coarsest > sStreamedBaseSize) {
+			coarsest++;
+		}
+		texture.setResidentMip(coarsest);
+		for (uint16_t mip = coarsest; mip < texture.mFormat.mMipCount; mip++) {
+			texture.uploadMip(mip, streamed.mChain + streamed.mMipOffsets[mip]);
+		}
+		streamed.mCoarsestMip = coarsest;
+		streamed.mRequestedMip = coarsest;
+		streamed.mLastRequestFrame = mStreamingFrame;
+		streamed.mResidentBytes = streamed.bytesFrom(coarsest);
+
+		mStreamedResidentBytes += streamed.mResidentBytes;
+		mStreamedCPUBytes += streamed.chainBytes();
+		mStreamedTextures[&texture] = std::move(streamed);
+	}
+
+	void TextureManager::_tickStreaming() {
+		TRACY_ZONE();
+		mStreamingFrame++;
+
+		std::unordered_map<entt::id_type, uint16_t> handleRequests;
+		{
+			std::lock_guard<std::mutex> lock(mMipRequestMutex);
+			std::swap(handleRequests, mMipRequests);
+		}
+		// Handles that share contents also share a texture
+		std::unordered_map<Texture*, uint16_t> requests;
+		for (auto&& [handle, mip] : handleRequests) {
+			if (isValid(handle)) {
+				auto request = requests.emplace(&resolve(TextureHandle(handle)), mip);
+				request.first->second = std::min(request.first->second, mip);
+			}
+		}
+
+		struct StreamIn {
+			Texture* mTexture;
+			uint16_t mDeficit;
+		};
+		std::vector<StreamIn> streamIns;
+		for (auto it = mStreamedTextures.begin(); it != mStreamedTextures.end(); it++) {
+			StreamedTexture& streamed = it->second;
+			Texture& texture = *it->first;
+
+			auto request = requests.find(it->first);
+			const uint16_t wanted = request != requests.end() ? std::min(request->second, streamed.mCoarsestMip) : streamed.mCoarsestMip;
+			// Finer requests apply right away, coarser ones wait a bit so textures don't thrash as the camera moves
+			if (wanted <= streamed.mRequestedMip || mStreamingFrame - streamed.mLastRequestFrame > sStreamOutFrames) {
+				streamed.mRequestedMip = wanted;
+				streamed.mLastRequestFrame = mStreamingFrame;
+			}
+
+			// Dropping mips is just a copy, so it doesn't count against the upload budget
+			if (texture.mResidentMip < streamed.mRequestedMip) {
+				texture.setResidentMip(streamed.mRequestedMip);
+				mStreamedResidentBytes -= streamed.mResidentBytes;
+				streamed.mResidentBytes = streamed.bytesFrom(texture.mResidentMip);
+				mStreamedResidentBytes += streamed.mResidentBytes;
+				mStatsDirty = true;
+			}
+			else if (texture.mResidentMip > streamed.mRequestedMip) {
+				streamIns.push_back({ it->first, static_cast<uint16_t>(texture.mResidentMip - streamed.mRequestedMip) });
+			}
+		}
+
+		// Blurriest first, one mip per texture per frame
+		std::sort(streamIns.begin(), streamIns.end(), [](const StreamIn& a, const StreamIn& b) {
+			return a.mDeficit > b.mDeficit;
+		});
+		uint64_t uploadedBytes = 0;
+		for (const StreamIn& streamIn : streamIns) {
+			StreamedTexture& streamed = mStreamedTextures.at(streamIn.mTexture);
+			Texture& texture = *streamIn.mTexture;
+
+			const uint16_t mip = static_cast<uint16_t>(texture.mResidentMip - 1);
+			const size_t mipBytes = streamed.mMipOffsets[mip + 1] - streamed.mMipOffsets[mip];
+			if (mStreamedResidentBytes + mipBytes > mStreamingBudget) {
+				continue;
+			}
+			if (uploadedBytes > 0 && uploadedBytes + mipBytes > mStreamingUploadBudget) {
+				break;
+			}
+
+			texture.setResidentMip(mip);
+			texture.uploadMip(mip, streamed.mChain + streamed.mMipOffsets[mip]);
+			uploadedBytes += mipBytes;
+			mStreamedResidentBytes += mipBytes;
+			mStatsDirty = true;
+			streamed.mResidentBytes += mipBytes;
+		}
+	}
+
+	[[nodiscard]] TextureHandle TextureManager::acquireTransient(const TextureFormat& format, glm::u16vec3 dimensions) {
+		TRACY_ZONE();
+		for (auto& transient : mTransientPool) {
+			if (!transient.mInUse && transient.mFormat == format && transient.mDimensions == dimensions && isValid(transient.mHandle)) {
+				transient.mInUse = true;
+				transient.mLastUsedFrame = mTransientFrame;
+				return transient.mHandle;
+			}
+		}
+
+		// Nothing free -- make one right now so the frame that asked for it doesn't get dropped
+		std::string debugName = "Transient " + std::to_string(mTransientCount++);
+		TextureHandle handle(HashedString(debugName.c_str()).value());
+		_cacheStore(handle.mHandle, TextureLoader{}.load(TextureBuilder{ format, dimensions }, debugName));
+		mTransientPool.emplace_back(TransientTexture{ format, dimensions, handle, true, mTransientFrame });
+		return handle;
+	}
+
+	void TextureManager::holdTransient(const TextureHandle& handle) {
+		for (auto& transient : mTransientPool) {
+			if (transient.mHandle == handle) {
+				transient.mInUse = true;
+				transient.mLastUsedFrame = mTransientFrame;
+				return;
+			}
+		}
+	}
+
+	void TextureManager::_tickTransient() {
+		TRACY_ZONE();
+		mTransientFrame++;
+
+		for (auto it = mTransientPool.begin(); it != mTransientPool.end();) {
+			// Discarded or cleared out from under the pool
+			if (!isValid(it->mHandle)) {
+				it = mTransientPool.erase(it);
+				continue;
+			}
+			if (mTransientFrame - it->mLastUsedFrame > sTransientEvictFrames) {
+				_destroyImpl(_cacheHandle(it->mHandle.mHandle).get());
+				_cacheDiscard(it->mHandle.mHandle);
+				it = mTransientPool.erase(it);
+				continue;
+			}
+			it->mInUse = false;
+			it++;
+		}
+	}
+
+	uint64_t TextureManager::_gpuBytes(const Texture& texture) {
+		const uint64_t pixelBytes = _channelsPerPixel(TextureFormat::deriveBaseFormat(texture.mFormat.mInternalFormat)) * _bytesPerPixel(texture.mFormat.mType);
+		const uint64_t layers = texture.mFormat.mTarget == types::texture::Target::TextureCube ? 6 : 1;
+		uint64_t bytes = 0;
+		for (uint16_t mip = texture.mResidentMip; mip < texture.mFormat.mMipCount; mip++) {
+			bytes += static_cast<uint64_t>(std::max(1, texture.mWidth >> mip)) * std::max(1, texture.mHeight >> mip) * std::max(1, texture.mDepth >> mip) * pixelBytes * layers;
+		}
+		return bytes;
+	}
+
 	void TextureManager::_destroyImpl(BackedResource<Texture>& texture) {
+		auto streamed = mStreamedTextures.find(&texture.mResource);
+		if (streamed != mStreamedTextures.end()) {
+			mStreamedResidentBytes -= streamed->second.mResidentBytes;
+			mStreamedCPUBytes -= streamed->second.chainBytes();
+			mStreamedTextures.erase(streamed);
+		}
 		texture.mResource.destroy();
 	}
 
 	void TextureManager::imguiEditor(std::function<void(const TextureHandle&)> textureFunc) {
-		mCache.each([&](auto handle, BackedResource<Texture>& textureResource) {
+		if (!mStreamedTextures.empty()) {
+			ImGui::Text("Streamed: %d textures, %.2f / %.2f MB", static_cast<int>(mStreamedTextures.size()), mStreamedResidentBytes / 1048576.f, mStreamingBudget / 1048576.f);
+			ImGui::Text("Streamed CPU chains: %.2f / %.2f MB", mStreamedCPUBytes / 1048576.f, mStreamingCPUBudget / 1048576.f);
+		}
+		if (!mTransientPool.empty()) {
+			ImGui::Text("Transient pool: %d textures", static_cast<int>(mTransientPool.size()));
+		}
+		_cacheEach([&](auto handle, BackedResource<Texture>& textureResource) {
 			ImGui::PushID(static_cast<int>(handle));
 			bool node = false;
 			if (textureResource.mDebugName.has_value()) {
@@ -260,6 +636,10 @@ namespace neo {
 			}
 			if (node) {
 				ImGui::Text("[%d, %d]", textureResource.mResource.mWidth, textureResource.mResource.mHeight);
+				auto streamed = mStreamedTextures.find(&textureResource.mResource);
+				if (streamed != mStreamedTextures.end()) {
+					ImGui::Text("Resident mip: %d (requested %d)", textureResource.mResource.mResidentMip, streamed->second.mRequestedMip);
+				}
 				textureFunc(handle);
 				ImGui::TreePop();
 			}
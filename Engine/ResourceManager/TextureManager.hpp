@@ -5,8 +5,11 @@
 
 #include "Util/Util.hpp"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace neo {
 	class ResourceManagers;
@@ -15,6 +18,11 @@ namespace neo {
 		TextureFormat mFormat;
 		glm::u16vec3 mDimensions = glm::u16vec3(0);
 		uint8_t* mData = nullptr;
+		// Keeps mData alive. If set the manager holds a reference instead of copying on asyncLoad
+		std::shared_ptr<const void> mOwner;
+		// Keep the full mip chain on the CPU and only page in the mips that are asked for. 2D UnsignedByte textures only
+		// The chain stays in system memory for as long as the texture lives (~1.33x the base image), capped by TextureManager::mStreamingCPUBudget
+		bool mStreamed = false;
 
 		TextureBuilder& setFormat(TextureFormat format) {
 			mFormat = format;
@@ -24,8 +32,13 @@ namespace neo {
 			mDimensions = dim;
 			return *this;
 		}
-		TextureBuilder& setData(uint8_t* data) {
+		TextureBuilder& setData(uint8_t* data, std::shared_ptr<const void> owner = nullptr) {
 			mData = data;
+			mOwner = std::move(owner);
+			return *this;
+		}
+		TextureBuilder& setStreamed(bool streamed) {
+			mStreamed = streamed;
 			return *this;
 		}
 	};
@@ -45,9 +58,62 @@ namespace neo {
 		~TextureManager();
 		void imguiEditor(std::function<void(const TextureHandle&)> textureFunc);
 
+		// Streamed textures get the finest mip that was requested since the last tick. Safe to call from any thread
+		void requestMip(const TextureHandle& handle, uint16_t mip) const;
+
+		uint64_t mStreamingBudget = 512ull << 20; // Resident bytes across all streamed textures
+		uint64_t mStreamingUploadBudget = 8ull << 20; // Bytes uploaded per frame
+		uint64_t mStreamingCPUBudget = 1024ull << 20; // Mip chains kept in system memory. Past this, streamed textures are uploaded whole instead
+
+		// Per-frame render targets. Recycled from a pool keyed on format and size, and created on the spot if nothing matches.
+		// Everything acquired goes back to the pool on the next tick, so don't hold on to these across frames. Render thread only
+		[[nodiscard]] TextureHandle acquireTransient(const TextureFormat& format, glm::u16vec3 dimensions);
+		// Keeps a transient from last frame out of the pool for this one -- for things that are still read a frame late, like ImGui
+		void holdTransient(const TextureHandle& handle);
+
 	protected:
 		[[nodiscard]] TextureHandle _asyncLoadImpl(TextureHandle id, TextureLoadDetails textureDetails, const std::optional<std::string>& debugName) const;
 		void _destroyImpl(BackedResource<Texture>& texture);
 		void _tickImpl();
+		static uint64_t _gpuBytes(const Texture& texture);
+
+	private:
+		struct StreamedTexture {
+			std::shared_ptr<const void> mOwner;
+			const uint8_t* mChain = nullptr; // Full mip chain, finest first
+			std::vector<size_t> mMipOffsets;
+			uint16_t mCoarsestMip = 0; // Always resident
+			uint16_t mRequestedMip = 0;
+			uint32_t mLastRequestFrame = 0;
+			size_t mResidentBytes = 0;
+
+			// Size of mips [mip, coarsest]
+			size_t bytesFrom(uint16_t mip) const { return mMipOffsets.back() - mMipOffsets[mip]; }
+			size_t chainBytes() const { return mMipOffsets.back(); }
+		};
+		// Keyed on the texture itself since handles that share contents share it too
+		std::unordered_map<Texture*, StreamedTexture> mStreamedTextures;
+		uint64_t mStreamedResidentBytes = 0;
+		uint64_t mStreamedCPUBytes = 0;
+		uint32_t mStreamingFrame = 0;
+
+		mutable std::mutex mMipRequestMutex;
+		mutable std::unordered_map<entt::id_type, uint16_t> mMipRequests;
+
+		void _registerStreamed(Texture& texture, const TextureBuilder& builder);
+		void _tickStreaming();
+
+		struct TransientTexture {
+			TextureFormat mFormat;
+			glm::u16vec3 mDimensions;
+			TextureHandle mHandle;
+			bool mInUse = false;
+			uint32_t mLastUsedFrame = 0;
+		};
+		std::vector<TransientTexture> mTransientPool;
+		uint32_t mTransientCount = 0;
+		uint32_t mTransientFrame = 0;
+
+		void _tickTransient();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "Loader/MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace neo;
+
+// Keeps going after a failure so one run reports everything
+#define CHECK(_COND, ...) \
+	do { \
+		if (!(_COND)) { \
+			printf("%s:%d: check failed: %s -- ", __FILE__, __LINE__, #_COND); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			sFailures++; \
+		} \
+	} while (0)
+
+namespace {
+	int sFailures = 0;
+
+	using Triangle = std::array<float, 9>;
+
+	constexpr uint32_t sGridSize = 16;
+	constexpr uint32_t sGridVertexCount = (sGridSize + 1) * (sGridSize + 1);
+	constexpr uint32_t sGridIndexCount = sGridSize * sGridSize * 6;
+
+	// NxN quad grid, shared vertices. Flat unless it's given some height to roll over
+	MeshPacker::MeshVertexData _makeGrid(uint32_t size = sGridSize, float height = 0.f) {
+		MeshPacker::MeshVertexData data;
+		for (uint32_t z = 0; z <= size; z++) {
+			for (uint32_t x = 0; x <= size; x++) {
+				const float y = height * std::sin(static_cast<float>(x) * 0.4f) * std::cos(static_cast<float>(z) * 0.3f);
+				data.mPositions.push_back(glm::vec3(static_cast<float>(x), y, static_cast<float>(z)));
+				data.mNormals.push_back(glm::vec3(0.f, 1.f, 0.f));
+				data.mUVs.push_back(glm::vec2(static_cast<float>(x), static_cast<float>(z)) / static_cast<float>(size));
+			}
+		}
+		for (uint32_t z = 0; z < size; z++) {
+			for (uint32_t x = 0; x < size; x++) {
+				const uint32_t i = z * (size + 1) + x;
+				data.mIndices.insert(data.mIndices.end(), { i, i + size + 1, i + 1 });
+				data.mIndices.insert(data.mIndices.end(), { i + 1, i + size + 1, i + size + 2 });
+			}
+		}
+		return data;
+	}
+
+	// Same triangles, but every corner gets its own vertex -- what an unindexed importer hands over
+	MeshPacker::MeshVertexData _unweld(const MeshPacker::MeshVertexData& data) {
+		MeshPacker::MeshVertexData out;
+		for (const uint32_t index : data.mIndices) {
+			out.mIndices.push_back(static_cast<uint32_t>(out.mPositions.size()));
+			out.mPositions.push_back(data.mPositions[index]);
+			out.mNormals.push_back(data.mNormals[index]);
+			out.mUVs.push_back(data.mUVs[index]);
+		}
+		return out;
+	}
+
+	// Fixed seed so the starting ACMR is the same every run
+	void _shuffleTriangles(std::vector<uint32_t>& indices) {
+		std::vector<uint32_t> order(indices.size() / 3);
+		for (uint32_t t = 0; t < order.size(); t++) {
+			order[t] = t;
+		}
+		std::mt19937 rng(1234);
+		std::shuffle(order.begin(), order.end(), rng);
+		std::vector<uint32_t> shuffled;
+		shuffled.reserve(indices.size());
+		for (const uint32_t t : order) {
+			shuffled.insert(shuffled.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+		}
+		indices = std::move(shuffled);
+	}
+
+	bool _indicesValid(const MeshPacker::MeshVertexData& data) {
+		return std::all_of(data.mIndices.begin(), data.mIndices.end(), [&data](uint32_t index) {
+			return index < data.mPositions.size();
+		});
+	}
+
+	// Triangles by position, rotated so the smallest corner comes first. Winding is kept, so a flipped triangle won't match
+	std::vector<Triangle> _triangleSet(const MeshPacker::MeshVertexData& data) {
+		std::vector<Triangle> triangles;
+		for (size_t t = 0; t + 2 < data.mIndices.size(); t += 3) {
+			std::array<glm::vec3, 3> corners = {
+				data.mPositions[data.mIndices[t + 0]],
+				data.mPositions[data.mIndices[t + 1]],
+				data.mPositions[data.mIndices[t + 2]],
+			};
+			auto less = [](const glm::vec3& a, const glm::vec3& b) {
+				return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+			};
+			std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end(), less), corners.end());
+			Triangle triangle;
+			for (int i = 0; i < 3; i++) {
+				triangle[i * 3 + 0] = corners[i].x;
+				triangle[i * 3 + 1] = corners[i].y;
+				triangle[i * 3 + 2] = corners[i].z;
+			}
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	float _acmr(const MeshPacker::MeshVertexData& data) {
+		return MeshOptimizer::analyzeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size())).mACMR;
+	}
+
+	void _testWeld() {
+		const MeshPacker::MeshVertexData grid = _makeGrid();
+		MeshPacker::MeshVertexData data = _unweld(grid);
+		CHECK(data.mPositions.size() == sGridIndexCount, "%zu", data.mPositions.size());
+
+		MeshOptimizer::weldVertices(data);
+		CHECK(data.mPositions.size() == sGridVertexCount, "welded to %zu verts", data.mPositions.size());
+		CHECK(data.mNormals.size() == data.mPositions.size() && data.mUVs.size() == data.mPositions.size(), "attribute counts diverged");
+		CHECK(data.mIndices.size() == sGridIndexCount, "%zu indices", data.mIndices.size());
+		CHECK(_indicesValid(data), "index out of range");
+		CHECK(_triangleSet(data) == _triangleSet(grid), "triangles changed");
+
+		// Differing uvs make a seam -- those corners have to stay split
+		MeshPacker::MeshVertexData seam = _unweld(grid);
+		seam.mUVs[2] = glm::vec2(-1.f);
+		MeshOptimizer::weldVertices(seam);
+		CHECK(seam.mPositions.size() == sGridVertexCount + 1, "seam welded to %zu verts", seam.mPositions.size());
+	}
+
+	void _testVertexCache() {
+		MeshPacker::MeshVertexData data = _makeGrid();
+		const std::vector<Triangle> triangles = _triangleSet(data);
+		_shuffleTriangles(data.mIndices);
+		const float before = _acmr(data);
+
+		MeshOptimizer::optimizeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size()));
+		const float after = _acmr(data);
+		CHECK(data.mIndices.size() == sGridIndexCount, "%zu indices", data.mIndices.size());
+		CHECK(_indicesValid(data), "index out of range");
+		CHECK(_triangleSet(data) == triangles, "triangles changed");
+		CHECK(after < before, "ACMR %0.3f -> %0.3f", before, after);
+		// A regular grid bottoms out at 0.5, a shuffled one starts well above 1
+		CHECK(after < 0.8f, "ACMR %0.3f", after);
+	}
+
+	void _testOverdraw() {
+		MeshPacker::MeshVertexData data = _makeGrid();
+		const std::vector<Triangle> triangles = _triangleSet(data);
+		_shuffleTriangles(data.mIndices);
+		MeshOptimizer::optimizeVertexCache(data.mIndices, static_cast<uint32_t>(data.mPositions.size()));
+		const float before = _acmr(data);
+
+		MeshOptimizer::optimizeOverdraw(data.mIndices, data.mPositions);
+		const float after = _acmr(data);
+		CHECK(data.mIndices.size() == sGridIndexCount, "%zu indices", data.mIndices.size());
+		CHECK(_indicesValid(data), "index out of range");
+		CHECK(_triangleSet(data) == triangles, "triangles changed");
+		// Clusters move as a whole, so the cache order within them survives
+		CHECK(after <= before * 1.05f, "ACMR %0.3f -> %0.3f", before, after);
+	}
+
+	void _testVertexFetch() {
+		MeshPacker::MeshVertexData data = _makeGrid();
+		_shuffleTriangles(data.mIndices);
+		// Never referenced -- should get dropped
+		data.mPositions.push_back(glm::vec3(100.f));
+		data.mNormals.push_back(glm::vec3(0.f, 1.f, 0.f));
+		data.mUVs.push_back(glm::vec2(0.f));
+		const std::vector<Triangle> triangles = _triangleSet(data);
+
+		MeshOptimizer::optimizeVertexFetch(data);
+		CHECK(data.mPositions.size() == sGridVertexCount, "%zu verts", data.mPositions.size());
+		CHECK(data.mNormals.size() == data.mPositions.size() && data.mUVs.size() == data.mPositions.size(), "attribute counts diverged");
+		CHECK(data.mIndices.size() == sGridIndexCount, "%zu indices", data.mIndices.size());
+		CHECK(_indicesValid(data), "index out of range");
+		CHECK(_triangleSet(data) == triangles, "triangles changed");
+
+		// Vertices come in first-use order, so every index is either seen already or the next one up
+		uint32_t next = 0;
+		bool ordered = true;
+		for (const uint32_t index : data.mIndices) {
+			ordered &= index <= next;
+			if (index == next) {
+				next++;
+			}
+		}
+		CHECK(ordered, "vertices aren't in first-use order");
+	}
+
+	void _testOptimize() {
+		const MeshPacker::MeshVertexData grid = _makeGrid();
+		MeshPacker::MeshVertexData data = _unweld(grid);
+		_shuffleTriangles(data.mIndices);
+		const float before = _acmr(data);
+
+		MeshOptimizer::optimize(data, "grid");
+		const float after = _acmr(data);
+		CHECK(data.mPositions.size() == sGridVertexCount, "%zu verts", data.mPositions.size());
+		CHECK(data.mIndices.size() == sGridIndexCount, "%zu indices", data.mIndices.size());
+		CHECK(_indicesValid(data), "index out of range");
+		CHECK(_triangleSet(data) == _triangleSet(grid), "triangles changed");
+		CHECK(after < before, "ACMR %0.3f -> %0.3f", before, after);
+		CHECK(after < 0.8f, "ACMR %0.3f", after);
+	}
+
+	bool _references(const std::vector<uint32_t>& indices, uint32_t vertex) {
+		return std::find(indices.begin(), indices.end(), vertex) != indices.end();
+	}
+
+	void _testSimplify() {
+		constexpr uint32_t size = 32;
+		const MeshPacker::MeshVertexData data = _makeGrid(size, 2.f);
+		const uint32_t indexCount = static_cast<uint32_t>(data.mIndices.size());
+
+		// Each collapse takes out two triangles, so it lands at or just under the target
+		float previousError = 0.f;
+		for (const uint32_t percent : { 75u, 50u, 25u }) {
+			const uint32_t target = indexCount * percent / 100;
+			float error = 0.f;
+			const std::vector<uint32_t> indices = MeshOptimizer::simplify(data, target, error);
+			CHECK(indices.size() <= target && indices.size() + 12 > target, "%zu indices for a target of %u", indices.size(), target);
+			CHECK(indices.size() % 3 == 0, "%zu indices", indices.size());
+			CHECK(std::all_of(indices.begin(), indices.end(), [&data](uint32_t index) { return index < data.mPositions.size(); }), "index out of range");
+			// Fewer triangles can only cost more
+			CHECK(error >= previousError, "error %0.5f at %u%% after %0.5f", error, percent, previousError);
+			previousError = error;
+
+			// Nothing on the border moves, so the outline stays put
+			bool bordersKept = true;
+			for (uint32_t i = 0; i <= size; i++) {
+				for (const uint32_t vertex : { i, size * (size + 1) + i, i * (size + 1), i * (size + 1) + size }) {
+					bordersKept &= _references(indices, vertex);
+				}
+			}
+			CHECK(bordersKept, "border vertex collapsed at %u%%", percent);
+		}
+		CHECK(previousError > 0.f, "a curved surface can't simplify for free");
+
+		// Flat is free no matter how far it goes
+		{
+			float error = 1.f;
+			MeshOptimizer::simplify(_makeGrid(size), indexCount / 4, error);
+			CHECK(error == 0.f, "error %0.5f on a flat grid", error);
+		}
+
+		// Split the middle column along a uv seam -- the right half gets its own copies of those vertices
+		MeshPacker::MeshVertexData seam = _makeGrid(size, 2.f);
+		constexpr uint32_t seamColumn = size / 2;
+		const uint32_t firstCopy = static_cast<uint32_t>(seam.mPositions.size());
+		std::vector<uint32_t> seamVertices;
+		for (uint32_t z = 0; z <= size; z++) {
+			const uint32_t vertex = z * (size + 1) + seamColumn;
+			seamVertices.push_back(vertex);
+			seamVertices.push_back(static_cast<uint32_t>(seam.mPositions.size()));
+			seam.mPositions.push_back(seam.mPositions[vertex]);
+			seam.mNormals.push_back(seam.mNormals[vertex]);
+			seam.mUVs.push_back(glm::vec2(seam.mUVs[vertex].x + 1.f, seam.mUVs[vertex].y));
+		}
+		for (uint32_t t = 0; t < seam.mIndices.size() / 3; t++) {
+			bool rightHalf = true;
+			for (int i = 0; i < 3; i++) {
+				rightHalf &= seam.mIndices[t * 3 + i] % (size + 1) >= seamColumn;
+			}
+			for (int i = 0; rightHalf && i < 3; i++) {
+				uint32_t& index = seam.mIndices[t * 3 + i];
+				if (index % (size + 1) == seamColumn) {
+					index = firstCopy + index / (size + 1);
+				}
+			}
+		}
+		float seamError = 0.f;
+		const std::vector<uint32_t> seamIndices = MeshOptimizer::simplify(seam, indexCount / 2, seamError);
+		CHECK(seamIndices.size() <= indexCount / 2, "%zu indices", seamIndices.size());
+		CHECK(std::all_of(seamVertices.begin(), seamVertices.end(), [&seamIndices](uint32_t vertex) { return _references(seamIndices, vertex); }), "seam vertex collapsed");
+	}
+}
+
+int main() {
+	_testWeld();
+	_testVertexCache();
+	_testOverdraw();
+	_testVertexFetch();
+	_testOptimize();
+	_testSimplify();
+
+	if (sFailures) {
+		printf("%d checks failed\n", sFailures);
+		return 1;
+	}
+	printf("All MeshOptimizer checks passed\n");
+	return 0;
+}
@@ -0,0 +1,131 @@
+#include "Util/pch.hpp"
+#include "AsyncJobs.hpp"
+
+#include "Util/Profiler.hpp"
+#include "Util/Log/Log.hpp"
+#include "Util/MemoryTracker.hpp"
+
+#include <ext/imgui_incl.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace neo {
+
+	std::mutex AsyncJobs::sMutex;
+	std::unordered_map<AsyncJobID, std::shared_ptr<AsyncJob>> AsyncJobs::sJobs;
+	std::vector<AsyncJobID> AsyncJobs::sCompleted;
+	std::atomic<AsyncJobID> AsyncJobs::sNextID{ 1 };
+
+	float AsyncJob::getProgress() const {
+		const uint32_t total = mTotal.load(std::memory_order_relaxed);
+		if (!total) {
+			return 0.f;
+		}
+		return std::min(1.f, static_cast<float>(mCompleted.load(std::memory_order_relaxed)) / static_cast<float>(total));
+	}
+
+	AsyncJobID AsyncJobs::launch(std::string name, std::function<void(AsyncJob&)> job) {
+		TRACY_ZONE();
+		const AsyncJobID id = sNextID.fetch_add(1, std::memory_order_relaxed);
+		auto asyncJob = std::make_shared<AsyncJob>(id, std::move(name));
+
+		// Held across the spawn so the job can't complete before it's registered
+		std::lock_guard<std::mutex> lock(sMutex);
+		asyncJob->mThread = std::thread([asyncJob, job = std::move(job)]() {
+			tracy::SetThreadName(asyncJob->mName.c_str());
+			NEO_MEMORY_TAG(AsyncJobs);
+			{
+				TRACY_ZONEN("AsyncJob");
+				ZoneText(asyncJob->mName.c_str(), asyncJob->mName.size());
+				job(*asyncJob);
+			}
+			if (asyncJob->isCancelled()) {
+				NEO_LOG_I("Cancelled %s", asyncJob->mName.c_str());
+			}
+			std::lock_guard<std::mutex> lock(sMutex);
+			sCompleted.push_back(asyncJob->mID);
+		});
+		sJobs.emplace(id, std::move(asyncJob));
+		return id;
+	}
+
+	void AsyncJobs::cancel(AsyncJobID id) {
+		std::lock_guard<std::mutex> lock(sMutex);
+		auto it = sJobs.find(id);
+		if (it != sJobs.end()) {
+			it->second->mCancelled.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	void AsyncJobs::cancelAll() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		for (auto&& [id, job] : sJobs) {
+			job->mCancelled.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	bool AsyncJobs::isRunning(AsyncJobID id) {
+		std::lock_guard<std::mutex> lock(sMutex);
+		return sJobs.find(id) != sJobs.end();
+	}
+
+	bool AsyncJobs::empty() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		return sJobs.empty();
+	}
+
+	uint32_t AsyncJobs::getCount() {
+		std::lock_guard<std::mutex> lock(sMutex);
+		return static_cast<uint32_t>(sJobs.size());
+	}
+
+	void AsyncJobs::tick() {
+		TRACY_ZONE();
+		std::vector<std::shared_ptr<AsyncJob>> retired;
+		{
+			std::lock_guard<std::mutex> lock(sMutex);
+			retired.reserve(sCompleted.size());
+			for (AsyncJobID id : sCompleted) {
+				auto it = sJobs.find(id);
+				NEO_ASSERT(it != sJobs.end(), "Async job %d completed twice?", id);
+				retired.push_back(std::move(it->second));
+				sJobs.erase(it);
+			}
+			sCompleted.clear();
+			TracyPlot("Async jobs", static_cast<int64_t>(sJobs.size()));
+		}
+
+		// The job has already signaled completion, so this only waits out the thread's exit
+		for (auto& job : retired) {
+			job->mThread.join();
+		}
+	}
+
+	void AsyncJobs::waitAll() {
+		TRACY_ZONE();
+		while (!empty()) {
+			tick();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	void AsyncJobs::imGuiEditor() {
+		glm::vec3 warningColor = util::sLogSeverityData.at(util::LogSeverity::Warning).second;
+		ImVec4 imguiColor(warningColor.x, warningColor.y, warningColor.z, 1.f);
+		std::lock_guard<std::mutex> lock(sMutex);
+		for (auto&& [id, job] : sJobs) {
+			ImGui::PushID(static_cast<int>(id));
+			ImGui::TextColored(imguiColor, "%s", job->mName.c_str());
+			ImGui::ProgressBar(job->getProgress(), ImVec2(-64.f, 0.f));
+			ImGui::SameLine();
+			if (job->isCancelled()) {
+				ImGui::TextDisabled("Cancelling");
+			}
+			else if (ImGui::Button("Cancel")) {
+				job->mCancelled.store(true, std::memory_order_relaxed);
+			}
+			ImGui::PopID();
+		}
+	}
+}
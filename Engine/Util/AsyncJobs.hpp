@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace neo {
+
+	using AsyncJobID = uint32_t;
+
+	// Handed to the job's body so it can report progress and bail out early
+	class AsyncJob {
+		friend class AsyncJobs;
+	public:
+		AsyncJob(AsyncJobID id, std::string name) :
+			mID(id),
+			mName(std::move(name))
+		{}
+		AsyncJob(const AsyncJob&) = delete;
+		AsyncJob& operator=(const AsyncJob&) = delete;
+
+		AsyncJobID getID() const { return mID; }
+		const std::string& getName() const { return mName; }
+
+		void setTotal(uint32_t total) { mTotal.store(total, std::memory_order_relaxed); }
+		void advance(uint32_t steps = 1) { mCompleted.fetch_add(steps, std::memory_order_relaxed); }
+		float getProgress() const;
+
+		// Jobs should check this between steps and return if it's set
+		bool isCancelled() const { return mCancelled.load(std::memory_order_relaxed); }
+
+	private:
+		const AsyncJobID mID;
+		const std::string mName;
+		std::atomic<uint32_t> mCompleted{ 0 };
+		std::atomic<uint32_t> mTotal{ 0 };
+		std::atomic<bool> mCancelled{ false };
+		std::thread mThread;
+	};
+
+	// Every job runs on its own thread. Finished jobs push themselves onto a completion queue that
+	// the main thread drains once a frame, so retiring a job never scans the running ones
+	class AsyncJobs {
+	public:
+		static AsyncJobID launch(std::string name, std::function<void(AsyncJob&)> job);
+		static void cancel(AsyncJobID id);
+		static void cancelAll();
+
+		static bool isRunning(AsyncJobID id);
+		static bool empty();
+		static uint32_t getCount();
+
+		// Main thread only
+		static void tick();
+		static void waitAll();
+		static void imGuiEditor();
+
+	private:
+		static std::mutex sMutex;
+		static std::unordered_map<AsyncJobID, std::shared_ptr<AsyncJob>> sJobs;
+		static std::vector<AsyncJobID> sCompleted;
+		static std::atomic<AsyncJobID> sNextID;
+	};
+}
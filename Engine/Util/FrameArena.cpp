@@ -0,0 +1,129 @@
+#include "Util/pch.hpp"
+#include "FrameArena.hpp"
+
+#include "Util/Profiler.hpp"
+
+#include <ext/imgui_incl.hpp>
+
+#include <algorithm>
+
+namespace neo {
+	namespace util {
+
+		std::atomic<uint64_t> FrameArena::sFrame{ 0 };
+		std::mutex FrameArena::sArenasMutex;
+		std::vector<FrameArena*> FrameArena::sArenas;
+
+		FrameArena& FrameArena::get() {
+			thread_local FrameArena arena;
+			return arena;
+		}
+
+		FrameArena::FrameArena() :
+			mFrame(sFrame.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(sArenasMutex);
+			sArenas.push_back(this);
+		}
+
+		FrameArena::~FrameArena() {
+			std::lock_guard<std::mutex> lock(sArenasMutex);
+			sArenas.erase(std::remove(sArenas.begin(), sArenas.end(), this), sArenas.end());
+		}
+
+		void* FrameArena::allocate(size_t size, size_t alignment) {
+			const uint64_t frame = sFrame.load(std::memory_order_relaxed);
+			if (mFrame != frame) {
+				mFrame = frame;
+				_rewind();
+			}
+
+			while (true) {
+				if (mBlock < mBlocks.size()) {
+					Block& block = mBlocks[mBlock];
+					const uintptr_t base = reinterpret_cast<uintptr_t>(block.mData.get());
+					const uintptr_t aligned = (base + mOffset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+					if (aligned + size <= base + block.mSize) {
+						mOffset = aligned + size - base;
+						mUsed.store(mUsed.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+						mAllocations.store(mAllocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+						mLast = reinterpret_cast<uint8_t*>(aligned);
+						return mLast;
+					}
+					if (mBlock + 1 < mBlocks.size()) {
+						mBlock++;
+						mOffset = 0;
+						continue;
+					}
+				}
+
+				// Out of room -- overflow into a new block. It gets folded into the first one on the next rewind
+				Block block;
+				block.mSize = std::max(sBlockSize, size + alignment);
+				block.mData = std::make_unique<uint8_t[]>(block.mSize);
+				mCapacity.store(mCapacity.load(std::memory_order_relaxed) + block.mSize, std::memory_order_relaxed);
+				mBlocks.push_back(std::move(block));
+				mBlock = mBlocks.size() - 1;
+				mOffset = 0;
+			}
+		}
+
+		void FrameArena::deallocate(void* ptr, size_t size) {
+			if (ptr && ptr == mLast && mBlock < mBlocks.size() && static_cast<uint8_t*>(ptr) + size == mBlocks[mBlock].mData.get() + mOffset) {
+				mOffset -= size;
+				mUsed.store(mUsed.load(std::memory_order_relaxed) - size, std::memory_order_relaxed);
+				mLast = nullptr;
+			}
+		}
+
+		void FrameArena::_rewind() {
+			const size_t used = mUsed.load(std::memory_order_relaxed);
+			mHighWater.store(std::max(mHighWater.load(std::memory_order_relaxed), used), std::memory_order_relaxed);
+			mLastAllocations.store(mAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			// Spilled over last frame -- replace everything with one block big enough for all of it
+			if (mBlocks.size() > 1) {
+				const size_t capacity = mCapacity.load(std::memory_order_relaxed);
+				mBlocks.clear();
+				Block block;
+				block.mSize = capacity;
+				block.mData = std::make_unique<uint8_t[]>(block.mSize);
+				mBlocks.push_back(std::move(block));
+			}
+
+			mBlock = 0;
+			mOffset = 0;
+			mLast = nullptr;
+			mUsed.store(0, std::memory_order_relaxed);
+			mAllocations.store(0, std::memory_order_relaxed);
+		}
+
+		void FrameArena::endFrame() {
+			TRACY_ZONE();
+			TracyPlot("Frame arena KB", static_cast<float>(get().mUsed.load(std::memory_order_relaxed)) / 1024.f);
+			sFrame.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void FrameArena::imGuiEditor() {
+			const FrameArena* mainArena = &get();
+			std::lock_guard<std::mutex> lock(sArenasMutex);
+			for (size_t i = 0; i < sArenas.size(); i++) {
+				const FrameArena* arena = sArenas[i];
+				char name[32];
+				if (arena == mainArena) {
+					sprintf(name, "Main");
+				}
+				else {
+					sprintf(name, "Thread %d", static_cast<int>(i));
+				}
+				ImGui::Text("%s: %d allocs, %0.1f / %0.1f KB (peak %0.1f KB)",
+					name,
+					static_cast<int>(arena->mLastAllocations.load(std::memory_order_relaxed)),
+					static_cast<float>(arena->mUsed.load(std::memory_order_relaxed)) / 1024.f,
+					static_cast<float>(arena->mCapacity.load(std::memory_order_relaxed)) / 1024.f,
+					static_cast<float>(arena->mHighWater.load(std::memory_order_relaxed)) / 1024.f
+				);
+			}
+		}
+	}
+}
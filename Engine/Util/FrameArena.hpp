@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace neo {
+	namespace util {
+
+		// Linear allocator for data that dies with the frame. Every thread gets its own, so allocating is a pointer bump
+		// Everything allocated out of it is invalidated at the end of the frame -- never store it in components or hand it to async jobs
+		class FrameArena {
+		public:
+			static constexpr size_t sBlockSize = 256 * 1024;
+
+			// The calling thread's arena
+			static FrameArena& get();
+			// Main thread only. Every arena is rewound the next time its thread allocates
+			static void endFrame();
+			static void imGuiEditor();
+
+			~FrameArena();
+			FrameArena(const FrameArena&) = delete;
+			FrameArena& operator=(const FrameArena&) = delete;
+
+			void* allocate(size_t size, size_t alignment);
+			// Only gives space back if ptr is still the most recent allocation, i.e. a temporary freed before anything else was allocated
+			// A growing vector allocates its new buffer before freeing the old one, so the old buffers stay used until the frame ends -- reserve() up front
+			void deallocate(void* ptr, size_t size);
+
+		private:
+			FrameArena();
+			void _rewind();
+
+			struct Block {
+				std::unique_ptr<uint8_t[]> mData;
+				size_t mSize = 0;
+			};
+			std::vector<Block> mBlocks;
+			size_t mBlock = 0;
+			size_t mOffset = 0;
+			uint8_t* mLast = nullptr;
+			uint64_t mFrame = 0;
+
+			// Written by the owning thread, read by the editor
+			std::atomic<size_t> mUsed{ 0 };
+			std::atomic<size_t> mHighWater{ 0 };
+			std::atomic<size_t> mCapacity{ 0 };
+			std::atomic<uint32_t> mAllocations{ 0 };
+			std::atomic<uint32_t> mLastAllocations{ 0 };
+
+			static std::atomic<uint64_t> sFrame;
+			static std::mutex sArenasMutex;
+			static std::vector<FrameArena*> sArenas;
+		};
+
+		// Opt-in STL allocator for frame-lifetime containers
+		template<typename T>
+		class FrameAllocator {
+		public:
+			using value_type = T;
+
+			FrameAllocator() = default;
+			template<typename U>
+			FrameAllocator(const FrameAllocator<U>&) {}
+
+			T* allocate(size_t count) {
+				return static_cast<T*>(FrameArena::get().allocate(count * sizeof(T), alignof(T)));
+			}
+			void deallocate(T* ptr, size_t count) {
+				FrameArena::get().deallocate(ptr, count * sizeof(T));
+			}
+
+			template<typename U>
+			bool operator==(const FrameAllocator<U>&) const { return true; }
+			template<typename U>
+			bool operator!=(const FrameAllocator<U>&) const { return false; }
+		};
+
+		template<typename T>
+		using FrameVector = std::vector<T, FrameAllocator<T>>;
+	}
+}
@@ -0,0 +1,99 @@
+#include "Util/pch.hpp"
+#include "GPUTimers.hpp"
+
+#include <GL/glew.h>
+
+namespace neo {
+	namespace util {
+
+		std::array<GPUTimers::Frame, GPUTimers::sLatency> GPUTimers::sFrames;
+		int GPUTimers::sCurrent = 0;
+		bool GPUTimers::sRecording = false;
+		bool GPUTimers::sEnabled = true;
+		int GPUTimers::sDepth = 0;
+		std::vector<GPUTimers::Result> GPUTimers::sResults;
+
+		GPUTimers::Scope::Scope(const char* name, int tag) :
+			mIndex(_begin(name, tag))
+		{}
+
+		GPUTimers::Scope::~Scope() {
+			_end(mIndex);
+		}
+
+		void GPUTimers::beginFrame() {
+			sCurrent = (sCurrent + 1) % sLatency;
+			Frame& frame = sFrames[sCurrent];
+
+			// Oldest frame in the ring -- harvest it before its queries get reissued
+			if (frame.mCount && frame.mLastQuery) {
+				int32_t available = 0;
+				glGetQueryObjectiv(frame.mLastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+				if (available) {
+					sResults.resize(frame.mCount);
+					for (size_t i = 0; i < frame.mCount; i++) {
+						const PendingScope& scope = frame.mScopes[i];
+						uint64_t begin = 0;
+						uint64_t end = 0;
+						glGetQueryObjectui64v(scope.mQueries[0], GL_QUERY_RESULT, &begin);
+						glGetQueryObjectui64v(scope.mQueries[1], GL_QUERY_RESULT, &end);
+						Result& result = sResults[i];
+						result.mName = scope.mName;
+						result.mDepth = scope.mDepth;
+						result.mTag = scope.mTag;
+						result.mGPUTime = static_cast<float>(end - begin) / 1000000.f;
+					}
+				}
+			}
+
+			frame.mCount = 0;
+			frame.mLastQuery = 0;
+			sDepth = 0;
+			sRecording = sEnabled;
+		}
+
+		void GPUTimers::endFrame() {
+			sRecording = false;
+		}
+
+		void GPUTimers::destroy() {
+			for (Frame& frame : sFrames) {
+				for (PendingScope& scope : frame.mScopes) {
+					glDeleteQueries(2, scope.mQueries);
+				}
+				frame.mScopes.clear();
+				frame.mCount = 0;
+				frame.mLastQuery = 0;
+			}
+			sResults.clear();
+			sRecording = false;
+		}
+
+		int GPUTimers::_begin(const char* name, int tag) {
+			if (!sRecording) {
+				return -1;
+			}
+			Frame& frame = sFrames[sCurrent];
+			if (frame.mCount == frame.mScopes.size()) {
+				PendingScope& scope = frame.mScopes.emplace_back();
+				glGenQueries(2, scope.mQueries);
+			}
+			PendingScope& scope = frame.mScopes[frame.mCount];
+			scope.mName = name;
+			scope.mDepth = sDepth++;
+			scope.mTag = tag;
+			glQueryCounter(scope.mQueries[0], GL_TIMESTAMP);
+			return static_cast<int>(frame.mCount++);
+		}
+
+		void GPUTimers::_end(int index) {
+			if (index < 0) {
+				return;
+			}
+			sDepth--;
+			Frame& frame = sFrames[sCurrent];
+			frame.mLastQuery = frame.mScopes[index].mQueries[1];
+			glQueryCounter(frame.mLastQuery, GL_TIMESTAMP);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace neo {
+	namespace util {
+
+		// Hierarchical GL_TIMESTAMP queries. Scopes only record between beginFrame and endFrame, and results
+		// are read sLatency frames late out of a pooled ring so reading them never stalls the pipeline
+		// GL thread only
+		class GPUTimers {
+		public:
+			static constexpr int sLatency = 4;
+
+			struct Result {
+				std::string mName;
+				int mDepth = 0;
+				int mTag = -1; // Caller defined, lets results be matched back up with whatever issued them
+				float mGPUTime = 0.f; // ms
+			};
+
+			struct Scope {
+				Scope(const char* name, int tag = -1);
+				~Scope();
+				Scope(const Scope&) = delete;
+				Scope& operator=(const Scope&) = delete;
+
+			private:
+				int mIndex;
+			};
+
+			static void beginFrame();
+			static void endFrame();
+			static void destroy();
+
+			// The newest frame that's finished on the GPU
+			static const std::vector<Result>& getResults() { return sResults; }
+
+			static bool sEnabled;
+
+		private:
+			static int _begin(const char* name, int tag);
+			static void _end(int index);
+
+			struct PendingScope {
+				std::string mName;
+				int mDepth = 0;
+				int mTag = -1;
+				uint32_t mQueries[2] = { 0, 0 };
+			};
+			struct Frame {
+				std::vector<PendingScope> mScopes; // Never shrinks -- the queries are reused
+				size_t mCount = 0;
+				uint32_t mLastQuery = 0; // Queries finish in order, so once this one lands they all have
+			};
+			static std::array<Frame, sLatency> sFrames;
+			static int sCurrent;
+			static bool sRecording;
+			static int sDepth;
+			static std::vector<Result> sResults;
+		};
+	}
+}
@@ -1,50 +1,449 @@
 #include "Util/pch.hpp"
 
 #include "Log.hpp"
+#include "ImGuiConsole.hpp"
 
-#include "Engine/ImGuiManager.hpp"
-
-#include "Util/ServiceLocator.hpp"
 #include "Util/Util.hpp"
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
 #define ARRAYSIZE(_ARR)	((int)(sizeof(_ARR) / sizeof(*(_ARR))))	 // Size of a static C-style array. Don't use on pointers!
 
 namespace neo {
 	namespace util {
 
-		void _log(LogSeverity severity, const char* sig, const char* format, ...) {
-			static_assert(std::is_same<neo::util::LogSeverity, decltype(severity)>::value, "Invalid log severity");
+		namespace {
+			// Repeats of the same format per call site, per second. Anything past this is counted and reported with the next message that gets through
+			constexpr uint32_t sLogRateLimit = 8;
+			constexpr int64_t sLogRateWindow = 1000;
+
+			struct LogRecord {
+				double mTime = 0.0;
+				LogSeverity mSeverity = LogSeverity::Info;
+				uint32_t mSuppressed = 0;
+				uint32_t mArgCount = 0;
+				char mSig[64];
+				LogArg mArgs[sLogMaxArgs];
+				uint16_t mStringOffsets[sLogMaxArgs]; // Into mData. String args keep their original pointer for %p
+				char mData[2048]; // The format, then every string argument
+			};
+
+			// printf, one conversion at a time, out of the captured arguments. Length modifiers are swapped for whatever
+			// the argument was captured as, so a %d fed a uint64_t still comes out right
+			int _formatRecord(const LogRecord& record, char* out, int size) {
+				int length = 0;
+				uint32_t argIndex = 0;
+				auto append = [&](int written) {
+					length = std::min(length + std::max(written, 0), size - 1);
+				};
+				auto nextArg = [&](uint32_t& index) -> const LogArg* {
+					index = argIndex;
+					return argIndex < record.mArgCount ? &record.mArgs[argIndex++] : nullptr;
+				};
+
+				const char* format = record.mData;
+				while (*format && length < size - 1) {
+					if (*format != '%') {
+						out[length++] = *format++;
+						continue;
+					}
+					const char* specStart = format++;
+					if (*format == '%') {
+						out[length++] = '%';
+						format++;
+						continue;
+					}
+
+					// Flags, width, and precision carry over. * gets replaced with its argument
+					char spec[48];
+					int specLength = 0;
+					spec[specLength++] = '%';
+					while (*format && strchr("-+ #0123456789.*", *format)) {
+						if (*format == '*') {
+							uint32_t index = 0;
+							const LogArg* arg = nextArg(index);
+							const long long value = arg ? (arg->mType == LogArg::Type::Unsigned ? static_cast<long long>(arg->mUnsigned) : arg->mSigned) : 0;
+							specLength += std::max(snprintf(spec + specLength, sizeof(spec) - specLength, "%lld", value), 0);
+						}
+						else {
+							spec[specLength++] = *format;
+						}
+						specLength = std::min(specLength, ARRAYSIZE(spec) - 4);
+						format++;
+					}
+					while (*format && strchr("hljztLqI", *format)) {
+						const bool msvcWidth = *format == 'I' && ((format[1] == '6' && format[2] == '4') || (format[1] == '3' && format[2] == '2'));
+						format += msvcWidth ? 3 : 1;
+					}
+					const char conversion = *format;
+					if (!conversion) {
+						break;
+					}
+					format++;
+
+					uint32_t index = 0;
+					const LogArg* arg = nextArg(index);
+					if (!arg || !strchr("diuoxXcfFeEgGaAsp", conversion)) {
+						// Not something we can fill in -- leave it as written
+						append(snprintf(out + length, size - length, "%.*s", static_cast<int>(format - specStart), specStart));
+						continue;
+					}
+
+					const bool isInt = strchr("diuoxXc", conversion) != nullptr;
+					const bool isFloat = strchr("fFeEgGaA", conversion) != nullptr;
+					if (isInt && conversion != 'c') {
+						spec[specLength++] = 'l';
+						spec[specLength++] = 'l';
+					}
+					spec[specLength++] = conversion;
+					spec[specLength] = 0;
+
+					if (isInt) {
+						long long value = arg->mSigned;
+						if (arg->mType == LogArg::Type::Double) {
+							value = static_cast<long long>(arg->mDouble);
+						}
+						if (conversion == 'c') {
+							append(snprintf(out + length, size - length, spec, static_cast<int>(value)));
+						}
+						else if (strchr("di", conversion)) {
+							append(snprintf(out + length, size - length, spec, value));
+						}
+						else {
+							append(snprintf(out + length, size - length, spec, static_cast<unsigned long long>(value)));
+						}
+					}
+					else if (isFloat) {
+						double value = arg->mDouble;
+						if (arg->mType == LogArg::Type::Signed) {
+							value = static_cast<double>(arg->mSigned);
+						}
+						else if (arg->mType == LogArg::Type::Unsigned) {
+							value = static_cast<double>(arg->mUnsigned);
+						}
+						append(snprintf(out + length, size - length, spec, value));
+					}
+					else if (conversion == 's') {
+						const char* string = arg->mType == LogArg::Type::String ? record.mData + record.mStringOffsets[index] : "(not a string)";
+						append(snprintf(out + length, size - length, spec, string));
+					}
+					else {
+						append(snprintf(out + length, size - length, spec, arg->mPointer));
+					}
+				}
+				out[length] = 0;
+				return length;
+			}
+
+			// Bounded MPSC ring. Producers claim a cell with a CAS on the enqueue position and publish it through the
+			// cell's sequence number, so nobody ever waits on a lock. A full ring hands back nothing and it's up to the caller
+			// to drop the message or try again
+			class LogQueue {
+			public:
+				static constexpr size_t sCapacity = 256; // Power of two
+
+				struct Cell {
+					std::atomic<size_t> mSequence;
+					LogRecord mRecord;
+				};
+
+				LogQueue() {
+					for (size_t i = 0; i < sCapacity; i++) {
+						mCells[i].mSequence.store(i, std::memory_order_relaxed);
+					}
+				}
+
+				// Any thread. The claimed cell is the caller's until it's handed back through endPush
+				// Null if the ring is full. Only counted as dropped if the caller isn't going to retry
+				Cell* beginPush(bool countDropped = true) {
+					size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+					while (true) {
+						Cell& cell = mCells[position & (sCapacity - 1)];
+						const size_t sequence = cell.mSequence.load(std::memory_order_acquire);
+						const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+						if (difference == 0) {
+							if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+								return &cell;
+							}
+						}
+						else if (difference < 0) {
+							if (countDropped) {
+								mDropped.fetch_add(1, std::memory_order_relaxed);
+							}
+							return nullptr;
+						}
+						else {
+							position = mEnqueuePosition.load(std::memory_order_relaxed);
+						}
+					}
+				}
+
+				void endPush(Cell* cell) {
+					// Claimed at sequence == position, ready for the consumer at position + 1
+					cell->mSequence.store(cell->mSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+					mPushed.fetch_add(1, std::memory_order_release);
+				}
+
+				// Consumer only
+				const LogRecord* peek() {
+					Cell& cell = mCells[mDequeuePosition & (sCapacity - 1)];
+					if (cell.mSequence.load(std::memory_order_acquire) != mDequeuePosition + 1) {
+						return nullptr;
+					}
+					return &cell.mRecord;
+				}
+				void pop() {
+					Cell& cell = mCells[mDequeuePosition & (sCapacity - 1)];
+					cell.mSequence.store(mDequeuePosition + sCapacity, std::memory_order_release);
+					mDequeuePosition++;
+					mPopped.fetch_add(1, std::memory_order_release);
+				}
+
+				uint64_t getPushed() const { return mPushed.load(std::memory_order_acquire); }
+				uint64_t getPopped() const { return mPopped.load(std::memory_order_acquire); }
+				uint32_t takeDropped() { return mDropped.exchange(0, std::memory_order_relaxed); }
+
+			private:
+				std::array<Cell, sCapacity> mCells;
+				alignas(64) std::atomic<size_t> mEnqueuePosition{ 0 };
+				alignas(64) size_t mDequeuePosition = 0;
+				std::atomic<uint64_t> mPushed{ 0 };
+				std::atomic<uint64_t> mPopped{ 0 };
+				std::atomic<uint32_t> mDropped{ 0 };
+			};
+
+			// Drains the queue into the terminal, the log file, and the ImGui console
+			class LogThread {
+			public:
+				LogThread() :
+					mThread(&LogThread::_run, this)
+				{}
+
+				~LogThread() {
+					{
+						std::lock_guard<std::mutex> lock(mWakeMutex);
+						mRunning = false;
+					}
+					mWake.notify_one();
+					mThread.join();
+					setFile(nullptr);
+				}
+
+				LogQueue& getQueue() { return mQueue; }
+
+				void wake() {
+					mWake.notify_one();
+				}
+
+				bool isLogThread() const {
+					return mThread.get_id() == std::this_thread::get_id();
+				}
+
+				void flush() {
+					const uint64_t target = mQueue.getPushed();
+					wake();
+					while (mQueue.getPopped() < target && !isLogThread()) {
+						std::this_thread::yield();
+					}
+				}
+
+				void setFile(const char* path) {
+					std::lock_guard<std::mutex> lock(mSinkMutex);
+					if (mFile) {
+						fclose(mFile);
+						mFile = nullptr;
+					}
+					if (path) {
+						mFile = fopen(path, "w");
+					}
+				}
+
+				void setConsole(ImGuiConsole* console) {
+					std::lock_guard<std::mutex> lock(mSinkMutex);
+					mConsole = console;
+				}
+
+			private:
+				void _run() {
+					while (true) {
+						{
+							std::unique_lock<std::mutex> lock(mWakeMutex);
+							mWake.wait_for(lock, std::chrono::milliseconds(10));
+							if (!mRunning && !mQueue.peek()) {
+								return;
+							}
+						}
+
+						std::lock_guard<std::mutex> lock(mSinkMutex);
+						if (uint32_t dropped = mQueue.takeDropped()) {
+							char buf[96];
+							snprintf(buf, sizeof(buf), "%0.4f [W]: Log queue overflowed, dropped %u messages\n", glfwGetTime(), dropped);
+							_write(buf, LogSeverity::Warning);
+						}
+						while (const LogRecord* record = mQueue.peek()) {
+							char message[sizeof(LogRecord::mData)];
+							_formatRecord(*record, message, ARRAYSIZE(message));
+							char buf[2048 + 160];
+							const char severity = sLogSeverityData.at(record->mSeverity).first;
+							int length = record->mSeverity != LogSeverity::Error
+								? snprintf(buf, sizeof(buf), "%0.4f [%c] (%s): %s", record->mTime, severity, record->mSig, message)
+								: snprintf(buf, sizeof(buf), "%0.4f [%c]: %s", record->mTime, severity, message);
+							// Leave room for the newline
+							length = std::min(std::max(length, 0), ARRAYSIZE(buf) - 2);
+							if (record->mSuppressed) {
+								length += std::max(snprintf(buf + length, sizeof(buf) - length, " (%u more suppressed)", record->mSuppressed), 0);
+								length = std::min(length, ARRAYSIZE(buf) - 2);
+							}
+							buf[length] = '\n';
+							buf[length + 1] = 0;
+							_write(buf, record->mSeverity);
+							mQueue.pop();
+						}
+						if (mFile) {
+							fflush(mFile);
+						}
+					}
+				}
+
+				void _write(const char* buf, LogSeverity severity) {
+#ifdef DEBUG_MODE
+					fputs(buf, stderr);
+#endif
+					if (mFile) {
+						fputs(buf, mFile);
+					}
+					if (mConsole) {
+						mConsole->addLog(buf, severity);
+					}
+				}
+
+				LogQueue mQueue;
+
+				std::mutex mWakeMutex;
+				std::condition_variable mWake;
+				bool mRunning = true;
+
+				std::mutex mSinkMutex;
+				FILE* mFile = nullptr;
+				ImGuiConsole* mConsole = nullptr;
+
+				std::thread mThread;
+			};
+
+			// Started on first use so logging during static init still works
+			LogThread& _getLogThread() {
+				static LogThread logThread;
+				return logThread;
+			}
+
+			// True if this message should go out
+			bool _rateLimit(LogSite& site, uint64_t formatHash, uint32_t& suppressed) {
+				const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				// A different format from the same site (a driver message passed straight through) starts a fresh window
+				if (site.mLastFormat.exchange(formatHash, std::memory_order_relaxed) != formatHash) {
+					site.mWindowStart.store(now, std::memory_order_relaxed);
+					site.mCount.store(1, std::memory_order_relaxed);
+					suppressed = site.mSuppressed.exchange(0, std::memory_order_relaxed);
+					return true;
+				}
+				int64_t windowStart = site.mWindowStart.load(std::memory_order_relaxed);
+				if (now - windowStart >= sLogRateWindow && site.mWindowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+					site.mCount.store(0, std::memory_order_relaxed);
+				}
+				if (site.mCount.fetch_add(1, std::memory_order_relaxed) >= sLogRateLimit) {
+					site.mSuppressed.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				suppressed = site.mSuppressed.exchange(0, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		bool _logBegin(LogSite& site, LogSeverity severity, const char* format, uint32_t& suppressed) {
 			bool doTheLog = false;
 			doTheLog |= severity == neo::util::LogSeverity::Verbose && neo::util::sLogVerbose;
 			doTheLog |= severity == neo::util::LogSeverity::Info && neo::util::sLogInfo;
 			doTheLog |= severity == neo::util::LogSeverity::Warning && neo::util::sLogWarning;
 			doTheLog |= severity == neo::util::LogSeverity::Error && neo::util::sLogError;
-			if (doTheLog) {
+			if (!doTheLog) {
+				return false;
+			}
 
-				char inbuf[2048];
-				va_list args;
-				va_start(args, format);
-				vsnprintf(inbuf, ARRAYSIZE(inbuf), format, args);
-				inbuf[ARRAYSIZE(inbuf) - 1] = 0;
-				va_end(args);
-				char buf[2048];
+			// Errors always make it through -- they're usually an assert about to fire
+			// Keyed on the format's text rather than its pointer so formats built at runtime still get told apart
+			return severity == LogSeverity::Error || _rateLimit(site, hashBytes(format, strlen(format)), suppressed);
+		}
 
-				if (severity != neo::util::LogSeverity::Error) {
-					sprintf(buf, "%0.4f [%c] (%s): %s\n", glfwGetTime(), sLogSeverityData.at(severity).first, sig, inbuf);
-				}
-				else {
-					sprintf(buf, "%0.4f [%c]: %s\n", glfwGetTime(), sLogSeverityData.at(severity).first, inbuf);
+		void _logPush(LogSeverity severity, const char* sig, const char* format, uint32_t suppressed, const LogArg* args, size_t argCount) {
+			LogThread& logThread = _getLogThread();
+			LogQueue::Cell* cell = nullptr;
+			if (severity == LogSeverity::Error && !logThread.isLogThread()) {
+				// Errors don't get dropped -- keep nudging the consumer until a cell frees up
+				while (!(cell = logThread.getQueue().beginPush(false))) {
+					logThread.wake();
+					std::this_thread::yield();
 				}
+			}
+			else {
+				cell = logThread.getQueue().beginPush();
+			}
+			if (!cell) {
+				return;
+			}
+			LogRecord* record = &cell->mRecord;
+			record->mTime = glfwGetTime();
+			record->mSeverity = severity;
+			record->mSuppressed = suppressed;
+			snprintf(record->mSig, sizeof(record->mSig), "%s", sig);
 
-#ifdef DEBUG_MODE
-				fprintf(stderr, buf);
-#endif
-				if (!ServiceLocator<ImGuiManager>::empty()) {
-					ServiceLocator<ImGuiManager>::ref().log(buf, severity);
+			// Copies only -- whatever the pointers point at is gone by the time the log thread gets here. Long strings get cut off
+			size_t used = 0;
+			auto copyString = [&](const char* string) {
+				const size_t offset = std::min(used, sizeof(record->mData) - 1);
+				const size_t length = std::min(strlen(string), sizeof(record->mData) - 1 - offset);
+				memcpy(record->mData + offset, string, length);
+				record->mData[offset + length] = 0;
+				used = offset + length + 1;
+				return static_cast<uint16_t>(offset);
+			};
+			copyString(format);
+			record->mArgCount = static_cast<uint32_t>(argCount);
+			for (size_t i = 0; i < argCount; i++) {
+				record->mArgs[i] = args[i];
+				if (args[i].mType == LogArg::Type::String) {
+					record->mStringOffsets[i] = copyString(args[i].mString ? args[i].mString : "(null)");
 				}
 			}
+			logThread.getQueue().endPush(cell);
+
+			// Asserts break right after -- make sure the message made it out first
+			if (severity == LogSeverity::Error) {
+				logThread.flush();
+			}
+			else {
+				logThread.wake();
+			}
+		}
+
+		void flushLog() {
+			_getLogThread().flush();
+		}
+
+		void setLogFile(const char* path) {
+			_getLogThread().setFile(path);
+		}
+
+		void setLogConsole(ImGuiConsole* console) {
+			_getLogThread().setConsole(console);
 		}
 	}
 }
@@ -1,12 +1,21 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <type_traits>
 
 #ifndef NEO_LOG_S
-	#define NEO_LOG_S(severity, fmt, ...) neo::util::_log(severity, __FUNCTION__, fmt, __VA_ARGS__)
+	// Every call site gets its own rate limit. Only repeats of the same format count against it
+	#define NEO_LOG_S(severity, fmt, ...) do { static neo::util::LogSite ___neoLogSite; neo::util::_log(___neoLogSite, severity, __FUNCTION__, fmt, __VA_ARGS__); } while (0)
 	#define NEO_LOG(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Info, fmt, __VA_ARGS__)
-	#define NEO_LOG_V(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Verbose, fmt, __VA_ARGS__)
+	#ifdef DEBUG_MODE
+		#define NEO_LOG_V(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Verbose, fmt, __VA_ARGS__)
+	#else
+		// Still compiled so the arguments stay checked, but never evaluated
+		#define NEO_LOG_V(fmt, ...) do { if constexpr (false) { NEO_LOG_S(neo::util::LogSeverity::Verbose, fmt, __VA_ARGS__); } } while (0)
+	#endif
 	#define NEO_LOG_I(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Info, fmt, __VA_ARGS__)
 	#define NEO_LOG_W(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Warning, fmt, __VA_ARGS__)
 	#define NEO_LOG_E(fmt, ...) NEO_LOG_S(neo::util::LogSeverity::Error, fmt, __VA_ARGS__)
@@ -15,6 +24,8 @@
 
 // TODO - should these be under some private namespace?
 namespace neo {
+	class ImGuiConsole;
+
 	namespace util {
 
 #ifdef DEBUG_MODE
@@ -40,6 +51,92 @@ namespace neo {
 			{ LogSeverity::Error,   {'E', glm::vec3(1.0f, 0.2f, 0.2f)}},
 		};
 
-		void _log(LogSeverity severity, const char* sig, const char* format, ...);
+		struct LogSite {
+			std::atomic<int64_t> mWindowStart{ 0 }; // ms
+			std::atomic<uint32_t> mCount{ 0 };
+			std::atomic<uint32_t> mSuppressed{ 0 };
+			std::atomic<uint64_t> mLastFormat{ 0 }; // Hash of the last format string
+		};
+
+		// A printf argument captured by value. Strings get copied along with the format, everything else is formatted on the log thread
+		struct LogArg {
+			enum class Type : uint8_t {
+				Signed,
+				Unsigned,
+				Double,
+				Pointer,
+				String
+			};
+			Type mType = Type::Signed;
+			union {
+				int64_t mSigned = 0;
+				uint64_t mUnsigned;
+				double mDouble;
+				const void* mPointer;
+				const char* mString;
+			};
+		};
+		static constexpr size_t sLogMaxArgs = 16;
+
+		template<typename T>
+		inline LogArg _logArg(T value) {
+			if constexpr (std::is_enum_v<T>) {
+				return _logArg(static_cast<std::underlying_type_t<T>>(value));
+			}
+			else {
+				LogArg arg;
+				if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*> || std::is_same_v<T, const unsigned char*> || std::is_same_v<T, unsigned char*>) {
+					arg.mType = LogArg::Type::String;
+					arg.mString = reinterpret_cast<const char*>(value);
+				}
+				else if constexpr (std::is_null_pointer_v<T>) {
+					arg.mType = LogArg::Type::Pointer;
+					arg.mPointer = nullptr;
+				}
+				else if constexpr (std::is_pointer_v<T>) {
+					arg.mType = LogArg::Type::Pointer;
+					arg.mPointer = static_cast<const void*>(value);
+				}
+				else if constexpr (std::is_floating_point_v<T>) {
+					arg.mType = LogArg::Type::Double;
+					arg.mDouble = static_cast<double>(value);
+				}
+				else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+					arg.mType = LogArg::Type::Signed;
+					arg.mSigned = static_cast<int64_t>(value);
+				}
+				else {
+					static_assert(std::is_integral_v<T>, "Log arguments have to be something printf can take");
+					arg.mType = LogArg::Type::Unsigned;
+					arg.mUnsigned = static_cast<uint64_t>(value);
+				}
+				return arg;
+			}
+		}
+
+		// Severity filter and rate limit. Cheap enough to run on every call -- nothing's been formatted yet
+		bool _logBegin(LogSite& site, LogSeverity severity, const char* format, uint32_t& suppressed);
+		void _logPush(LogSeverity severity, const char* sig, const char* format, uint32_t suppressed, const LogArg* args, size_t argCount);
+
+		// Copies the format and arguments into the queue and leaves the formatting to the log thread.
+		// Safe to call from any thread. Errors block until they've been written
+		template<typename... Args>
+		void _log(LogSite& site, LogSeverity severity, const char* sig, const char* format, Args... args) {
+			static_assert(sizeof...(Args) <= sLogMaxArgs, "Too many log arguments");
+			uint32_t suppressed = 0;
+			if (!_logBegin(site, severity, format, suppressed)) {
+				return;
+			}
+			const LogArg packed[sizeof...(Args) + 1] = { _logArg(args)..., LogArg{} };
+			_logPush(severity, sig, format, suppressed, packed, sizeof...(Args));
+		}
+
+		// Blocks until everything logged so far has been written
+		void flushLog();
+		// Mirrors the log into a file. nullptr closes it
+		void setLogFile(const char* path);
+
+		// Mirrors the log into the ImGui console. nullptr detaches it
+		void setLogConsole(ImGuiConsole* console);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "Util/pch.hpp"
+#include "MemoryTracker.hpp"
+
+#include "Util/Profiler.hpp"
+#include "Util/Log/Log.hpp"
+
+#include <ext/imgui_incl.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+namespace {
+	thread_local neo::util::MemoryTag tCurrentTag = neo::util::MemoryTag::Untagged;
+
+	// Stashed in front of every allocation so frees know who to charge. Keeps malloc's alignment
+	struct alignas(alignof(std::max_align_t)) AllocationHeader {
+		size_t mSize;
+		neo::util::MemoryTag mTag;
+	};
+
+	const char* sTagNames[] = {
+		"Untagged",
+		"ECS",
+		"Demo",
+		"Renderer",
+		"ResourceManagers",
+		"Loader",
+		"ImGui",
+		"AsyncJobs",
+	};
+	static_assert(sizeof(sTagNames) / sizeof(sTagNames[0]) == static_cast<size_t>(neo::util::MemoryTag::COUNT), "Name every memory tag");
+}
+
+void* operator new(std::size_t count) {
+	auto header = static_cast<AllocationHeader*>(malloc(sizeof(AllocationHeader) + count));
+	if (!header) {
+		throw std::bad_alloc();
+	}
+	header->mSize = count;
+	header->mTag = tCurrentTag;
+	neo::util::MemoryTracker::_onAlloc(header->mTag, count);
+
+	void* ptr = header + 1;
+	TracyAllocN(ptr, count, sTagNames[static_cast<size_t>(header->mTag)]);
+	return ptr;
+}
+void operator delete(void* ptr) noexcept {
+	if (!ptr) {
+		return;
+	}
+	auto header = static_cast<AllocationHeader*>(ptr) - 1;
+	TracyFreeN(ptr, sTagNames[static_cast<size_t>(header->mTag)]);
+	neo::util::MemoryTracker::_onFree(header->mTag, header->mSize);
+	free(header);
+}
+
+namespace neo {
+	namespace util {
+
+		MemoryTracker::AtomicTagStats MemoryTracker::sStats[static_cast<size_t>(MemoryTag::COUNT)];
+
+		MemoryTagScope::MemoryTagScope(MemoryTag tag) :
+			mPrevious(tCurrentTag)
+		{
+			tCurrentTag = tag;
+		}
+
+		MemoryTagScope::~MemoryTagScope() {
+			tCurrentTag = mPrevious;
+		}
+
+		MemoryTag MemoryTracker::getCurrentTag() {
+			return tCurrentTag;
+		}
+
+		const char* MemoryTracker::getTagName(MemoryTag tag) {
+			return sTagNames[static_cast<size_t>(tag)];
+		}
+
+		MemoryTracker::TagStats MemoryTracker::getStats(MemoryTag tag) {
+			const AtomicTagStats& stats = sStats[static_cast<size_t>(tag)];
+			TagStats ret;
+			ret.mLiveBytes = stats.mLiveBytes.load(std::memory_order_relaxed);
+			ret.mLiveAllocations = stats.mLiveAllocations.load(std::memory_order_relaxed);
+			ret.mPeakBytes = stats.mPeakBytes.load(std::memory_order_relaxed);
+			ret.mTotalAllocations = stats.mTotalAllocations.load(std::memory_order_relaxed);
+			return ret;
+		}
+
+		void MemoryTracker::_onAlloc(MemoryTag tag, size_t size) {
+			AtomicTagStats& stats = sStats[static_cast<size_t>(tag)];
+			const int64_t live = stats.mLiveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+			stats.mLiveAllocations.fetch_add(1, std::memory_order_relaxed);
+			stats.mTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+			int64_t peak = stats.mPeakBytes.load(std::memory_order_relaxed);
+			while (live > peak && !stats.mPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+		}
+
+		void MemoryTracker::_onFree(MemoryTag tag, size_t size) {
+			AtomicTagStats& stats = sStats[static_cast<size_t>(tag)];
+			stats.mLiveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+			stats.mLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void MemoryTracker::imGuiEditor() {
+			if (ImGui::BeginTable("Memory", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+				ImGui::TableSetupColumn("Tag");
+				ImGui::TableSetupColumn("Live MB");
+				ImGui::TableSetupColumn("Live allocs");
+				ImGui::TableSetupColumn("Peak MB");
+				ImGui::TableSetupColumn("Total allocs");
+				ImGui::TableHeadersRow();
+				for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); i++) {
+					const TagStats stats = getStats(static_cast<MemoryTag>(i));
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", sTagNames[i]);
+					ImGui::TableNextColumn();
+					ImGui::Text("%0.2f", stats.mLiveBytes / 1048576.f);
+					ImGui::TableNextColumn();
+					ImGui::Text("%lld", static_cast<long long>(stats.mLiveAllocations));
+					ImGui::TableNextColumn();
+					ImGui::Text("%0.2f", stats.mPeakBytes / 1048576.f);
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", static_cast<unsigned long long>(stats.mTotalAllocations));
+				}
+				ImGui::EndTable();
+			}
+			if (ImGui::Button("Export")) {
+				exportStats("memory.csv");
+			}
+		}
+
+		bool MemoryTracker::exportStats(const std::string& path) {
+			std::ofstream out(path, std::ios::trunc);
+			if (!out) {
+				NEO_LOG_E("Unable to export memory stats to %s", path.c_str());
+				return false;
+			}
+			out << "tag,live_bytes,live_allocations,peak_bytes,total_allocations\n";
+			for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); i++) {
+				const TagStats stats = getStats(static_cast<MemoryTag>(i));
+				out << sTagNames[i] << "," << stats.mLiveBytes << "," << stats.mLiveAllocations << "," << stats.mPeakBytes << "," << stats.mTotalAllocations << "\n";
+			}
+			NEO_LOG_I("Exported memory stats to %s", path.c_str());
+			return static_cast<bool>(out);
+		}
+	}
+}
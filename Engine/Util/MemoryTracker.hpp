@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Attributes every allocation made in this scope on this thread to a subsystem
+#define NEO_MEMORY_TAG(tag) neo::util::MemoryTagScope ___NEO_MEMORY_TAG##__LINE__(neo::util::MemoryTag::tag)
+
+namespace neo {
+	namespace util {
+
+		enum class MemoryTag : uint8_t {
+			Untagged,
+			ECS,
+			Demo,
+			Renderer,
+			ResourceManagers,
+			Loader,
+			ImGui,
+			AsyncJobs,
+			COUNT
+		};
+
+		// Tags nest -- the innermost one wins until it goes out of scope
+		struct MemoryTagScope {
+			MemoryTagScope(MemoryTag tag);
+			~MemoryTagScope();
+			MemoryTagScope(const MemoryTagScope&) = delete;
+			MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+		private:
+			MemoryTag mPrevious;
+		};
+
+		// Fed by the global operator new/delete. Frees are counted against the tag that made the allocation,
+		// regardless of which thread or scope releases it
+		class MemoryTracker {
+		public:
+			struct TagStats {
+				int64_t mLiveBytes = 0;
+				int64_t mLiveAllocations = 0;
+				int64_t mPeakBytes = 0;
+				uint64_t mTotalAllocations = 0;
+			};
+
+			static MemoryTag getCurrentTag();
+			static const char* getTagName(MemoryTag tag);
+			static TagStats getStats(MemoryTag tag);
+
+			static void imGuiEditor();
+			// CSV, one row per tag
+			static bool exportStats(const std::string& path);
+
+			static void _onAlloc(MemoryTag tag, size_t size);
+			static void _onFree(MemoryTag tag, size_t size);
+
+		private:
+			struct AtomicTagStats {
+				std::atomic<int64_t> mLiveBytes;
+				std::atomic<int64_t> mLiveAllocations;
+				std::atomic<int64_t> mPeakBytes;
+				std::atomic<uint64_t> mTotalAllocations;
+			};
+			static AtomicTagStats sStats[static_cast<size_t>(MemoryTag::COUNT)];
+		};
+	}
+}
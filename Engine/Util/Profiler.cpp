@@ -3,19 +3,12 @@
 #include "Util/Util.hpp"
 
 #include "Profiler.hpp"
+#include "MemoryTracker.hpp"
 
 #include <ext/imgui_incl.hpp>
 #include <implot.h>
 
-void* operator new(std::size_t count) {
-	auto ptr = malloc(count);
-	TracyAlloc(ptr, count);
-	return ptr;
-}
-void operator delete(void* ptr) noexcept {
-	TracyFree(ptr);
-	free(ptr);
-}
+#include <algorithm>
 
 #define MAX_SAMPLES 400
 
@@ -42,7 +35,7 @@ namespace neo {
 
 		void Profiler::GPUQuery::init() {
 			if (!_handlesValid()) {
-				glGenQueries(2, mHandles.data());
+				glGenQueries(sLatency, mHandles.data());
 			}
 		}
 
@@ -51,8 +44,8 @@ namespace neo {
 				return 0.f;
 			}
 
-			// Retrieve the inactive handle
-			uint32_t handle = mUseHandle0 ? mHandles[1] : mHandles[0];
+			// Retrieve the oldest handle -- it's the next one to be reused
+			uint32_t handle = mHandles[(mCurrent + 1) % sLatency];
 
 			int32_t done;
 			glGetQueryObjectiv(handle, GL_QUERY_RESULT_AVAILABLE, &done);
@@ -67,17 +60,17 @@ namespace neo {
 		}
 
 		uint32_t Profiler::GPUQuery::tickHandle() {
-			mUseHandle0 = !mUseHandle0;
-			return mUseHandle0 ? mHandles[0] : mHandles[1];
+			mCurrent = (mCurrent + 1) % sLatency;
+			return mHandles[mCurrent];
 		}
 
 		void Profiler::GPUQuery::destroy() {
-			glDeleteQueries(2, mHandles.data());
-			mHandles = { 0,0 };
+			glDeleteQueries(sLatency, mHandles.data());
+			mHandles = {};
 		}
 
 		bool Profiler::GPUQuery::_handlesValid() const {
-			return mHandles[0] && mHandles[1];
+			return std::all_of(mHandles.begin(), mHandles.end(), [](uint32_t handle) { return handle != 0; });
 		}
 
 		Profiler::Profiler(int refreshRate) 
@@ -133,6 +126,9 @@ namespace neo {
 
 				ImPlot::EndPlot();
 			}
+			if (ImGui::CollapsingHeader("Memory")) {
+				MemoryTracker::imGuiEditor();
+			}
 			ImGui::End();
 		}
 	}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Util/Util.hpp"
+#include "Util/GPUTimers.hpp"
 
 #define _CAT(X,Y) _CAT2(X,Y)
 #define _CAT2(X,Y) X##Y
@@ -14,11 +15,11 @@
 
 
 struct _NEO_GPU_SCOPE {
-	_NEO_GPU_SCOPE(const char* name) {
+	_NEO_GPU_SCOPE(const char* name) :
+		mTimer(name)
+	{
 #ifdef DEBUG_MODE
 		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, static_cast<GLsizei>(-1), name);
-#else
-		NEO_UNUSED(name);
 #endif
 	}
 	~_NEO_GPU_SCOPE() {
@@ -26,6 +27,7 @@ struct _NEO_GPU_SCOPE {
 		glPopDebugGroup();
 #endif
 	}
+	neo::util::GPUTimers::Scope mTimer;
 };
 #define TRACY_GPUN(x) TRACY_ZONEN(x); TracyGpuZoneC(x, (neo::HashedString(x) & 0xfefefe) >> 1 ); _NEO_GPU_SCOPE ___NEO_GPU_SCOPE##__LINE__(x)
 #define TRACY_GPU() TRACY_GPUN(TracyFunction)
@@ -41,6 +43,8 @@ namespace neo {
 		class Profiler {
 		public:
 			struct GPUQuery {
+				// Results are read this many frames late so the read never stalls on a frame still in flight
+				static constexpr int sLatency = 4;
 
 				void init();
 				float getGPUTime() const;
@@ -56,8 +60,8 @@ namespace neo {
 			private:
 				bool _handlesValid() const;
 
-				std::array<uint32_t, 2> mHandles = { 0,0 };
-				bool mUseHandle0 = true; // Double buffer
+				std::array<uint32_t, sLatency> mHandles = {};
+				int mCurrent = 0;
 			};
 
 			Profiler(int refreshRate);
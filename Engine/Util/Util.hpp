@@ -6,7 +6,10 @@
 
 #include <entt/core/hashed_string.hpp>
 
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <memory>
 
 namespace neo {
 
@@ -105,6 +108,43 @@ namespace neo {
 			return sphericalToCartesian(v.x, v.y, v.z);
 		}
 
+		// Fast non-cryptographic hash of raw bytes (MurmurHash64A). Good for spotting duplicate resource contents
+		static inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0) {
+			constexpr uint64_t m = 0xc6a4a7935bd1e995ull;
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			uint64_t h = seed ^ (size * m);
+			size_t i = 0;
+			for (; i + 8 <= size; i += 8) {
+				uint64_t k;
+				memcpy(&k, bytes + i, 8);
+				k *= m;
+				k ^= k >> 47;
+				k *= m;
+				h ^= k;
+				h *= m;
+			}
+			if (i < size) {
+				uint64_t tail = 0;
+				memcpy(&tail, bytes + i, size - i);
+				h ^= tail;
+				h *= m;
+			}
+			h ^= h >> 47;
+			h *= m;
+			h ^= h >> 47;
+			return h;
+		}
+
+		template<typename T>
+		static inline uint64_t hashCombine(uint64_t seed, const T& value) {
+			return seed ^ (static_cast<uint64_t>(std::hash<T>{}(value)) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+		}
+
+		// Hands a new[] allocation over to shared ownership, ie so the resource managers can hold on to it instead of copying
+		static inline std::shared_ptr<const void> adoptBytes(const uint8_t* data) {
+			return std::shared_ptr<const void>(data, std::default_delete<const uint8_t[]>());
+		}
+
 		static inline bool fileExists(const char* path) {
 			std::ifstream f(path);
 			return f.good();
@@ -41,7 +41,8 @@ layout(binding = 4) uniform sampler2D emissiveMap;
 #ifdef ENABLE_SHADOWS
 uniform vec2 shadowMapResolution;
 #	ifdef DIRECTIONAL_LIGHT
-	in vec4 shadowCoord[3];
+	in vec4 shadowCoord[CSM_MAX_CASCADES];
+	uniform int csmCascadeCount;
 	layout(binding = 5) uniform sampler2D shadowMap;
 #	elif defined(POINT_LIGHT)
 	layout(binding = 5) uniform samplerCube shadowMap;
@@ -155,7 +156,7 @@ void main() {
 
 #ifdef ENABLE_SHADOWS
 #	ifdef DIRECTIONAL_LIGHT
-	float visibility = getCSMShadowVisibility(1, shadowCoord, shadowMap, shadowMapResolution.x, 0.0001);
+	float visibility = getCSMShadowVisibility(1, shadowCoord, csmCascadeCount, shadowMap, shadowMapResolution.x, 0.0001);
 #	elif defined(POINT_LIGHT)
 	float visibility = getShadowVisibility(1, shadowMap, fragPos.xyz - lightPos, shadowMapResolution.x, shadowRange, 0.001);
 #	endif
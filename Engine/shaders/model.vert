@@ -1,3 +1,5 @@
+#include "quantization.glsl"
+
 layout(location = 0) in vec3 vertPos;
 layout(location = 1) in vec3 vertNor;
 layout(location = 2) in vec2 vertTex;
@@ -21,13 +23,14 @@ out vec4 fragTan;
 uniform mat4 L0;
 uniform mat4 L1;
 uniform mat4 L2;
+uniform mat4 L3;
 
 // csm frustum transforms
-out vec4 shadowCoord[3];
+out vec4 shadowCoord[CSM_MAX_CASCADES];
 #endif
 
 void main() {
-	fragPos = M * vec4(vertPos, 1.0);
+	fragPos = M * vec4(dequantizePosition(vertPos), 1.0);
 	fragNor = N * vertNor;
 	fragTex = vertTex;
 #ifdef TANGENTS
@@ -39,5 +42,6 @@ void main() {
 	shadowCoord[0] = L0 * fragPos;
 	shadowCoord[1] = L1 * fragPos;
 	shadowCoord[2] = L2 * fragPos;
+	shadowCoord[3] = L3 * fragPos;
 #endif
 }
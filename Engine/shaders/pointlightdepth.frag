@@ -1,6 +1,13 @@
 
+#ifdef LAYERED
+in vec4 layerFragPos;
+in vec2 layerFragTex;
+#define fragPos layerFragPos
+#define fragTex layerFragTex
+#else
 in vec4 fragPos;
 in vec2 fragTex;
+#endif
 
 #include "alphaDiscard.glsl"
 
@@ -0,0 +1,8 @@
+// Quantized positions are unpacked with these -- set per draw by the mesh, identity for float positions
+// Anything that draws meshes should go through dequantizePosition instead of reading vertPos raw
+layout(location = 4) in vec3 vertPosScale;
+layout(location = 5) in vec3 vertPosBias;
+
+vec3 dequantizePosition(vec3 pos) {
+	return pos * vertPosScale + vertPosBias;
+}
@@ -26,18 +26,18 @@ float getSingleShadow(float _pcfSize, vec4 _shadowCoord, sampler2D _shadowMap, f
 	}
 }
 
-float getCSMShadowVisibility(int _pcfSize, vec4 _shadowCoord[3], sampler2D _shadowMap, float _shadowMapResolution, float _bias) {
-	int lod = 0;
-	if (validCascade(_shadowCoord[0])) {
-		lod = 0;
-	}
-	else if (validCascade(_shadowCoord[1])) {
-		lod = 1;
-	}
-	else if (validCascade(_shadowCoord[2])) {
-		lod = 2;
+int getCSMCascade(vec4 _shadowCoord[CSM_MAX_CASCADES], int _cascadeCount) {
+	for (int i = 0; i < _cascadeCount; i++) {
+		if (validCascade(_shadowCoord[i])) {
+			return i;
+		}
 	}
-	else {
+	return -1;
+}
+
+float getCSMShadowVisibility(int _pcfSize, vec4 _shadowCoord[CSM_MAX_CASCADES], int _cascadeCount, sampler2D _shadowMap, float _shadowMapResolution, float _bias) {
+	int lod = getCSMCascade(_shadowCoord, _cascadeCount);
+	if (lod < 0) {
 		return 1.0;
 	}
 
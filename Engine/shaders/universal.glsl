@@ -2,6 +2,7 @@
 #define PI 3.141592653589
 #define EP 1e-5
 #define FP16_MAX 65504.0
+#define CSM_MAX_CASCADES 4 // Matches CSM_MAX_CAMERA_COUNT
 
 
 #define saturate(_x) clamp(_x, 0.0, 1.0)